@@ -0,0 +1,843 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines the benchmark driver, built as
+   the shortestpath_bench executable. For every requested
+   graph family and size, it generates a seeded synthetic
+   graph (class GraphGenerator), draws one seeded set of
+   random (start, end) queries, and runs that same set on
+   every requested engine:
+       graph    Graph::shortestPath(), mutable adjacency maps
+       frozen   FrozenGraph::shortestPath(), CSR arrays
+       frozen32 same, on BasicFrozenGraph<unsigned int>, whose
+                weights take 4 bytes instead of 8
+       compressed
+                CompressedGraph::shortestPath(), varint
+                adjacency decoded inside the search
+       ch       ContractionHierarchy::shortestPath()
+       hl       HubLabels::distance(), labels from the ch
+                hierarchy, distance only
+       alt      Landmarks::shortestPath(), A* with landmarks
+       batch    FrozenGraph::shortestPathBatch() on a pool
+       delta    DeltaStepping::run(), one full tree per query
+   graph, frozen, frozen32 and compressed run once per
+   queue (heap, radix, buckets) and search mode (uni, bi).
+   frozen, frozen32 and compressed also report the bytes
+   their adjacency takes per directed edge. --kernel picks
+   the RelaxKernel variant used by frozen, frozen32 and
+   batch, so that scalar and vector relaxation can be
+   compared run against run.
+
+   The graph, ch and hl engines are skipped above a size
+   limit (--graph-limit, --ch-limit). Contraction is
+   close to quadratic on powerlaw graphs, whose hubs form
+   a dense core, so ch and hl stop at --powerlaw-limit
+   there.
+
+   Every engine can also be run once per vertex order
+   (--orders): the generated IDs, a random shuffle of them
+   (the scattered IDs of insertion order), BFS, Reverse
+   Cuthill-McKee, or Hilbert order (FrozenGraph::reorder()).
+   Where the kernel allows perf_event_open(), each timed
+   run also counts the L1 data cache and last-level cache
+   read misses of its queries, which shows what the order
+   did to locality. L2 has no portable perf event, so it is
+   not counted separately.
+
+   Each run reports its preprocessing time, query latency
+   percentiles, throughput, and the peak resident set size
+   of the process so far. Every distance is checked against
+   the first run of the same graph, and disagreements are
+   counted as mismatches. The report is one JSON document,
+   written to stdout or to --output, so that runs can be
+   stored and compared over time. Run with --help for the
+   list of options.
+
+   In a build with SHORTESTPATH_STATS, --stats and --trace
+   also collect the SearchStats of every query: histograms
+   per engine (class HistogramSink) and a Chrome trace
+   (class TraceSink), each written to its own file.          */
+
+#include "Graph.hpp"
+#include "FrozenGraph.hpp"
+#include "CompressedGraph.hpp"
+#include "ContractionHierarchy.hpp"
+#include "HubLabels.hpp"
+#include "Landmarks.hpp"
+#include "DeltaStepping.hpp"
+#include "GraphGenerator.hpp"
+#include "ThreadPool.hpp"
+#include "RelaxKernel.hpp"
+#include "SearchStats.hpp"
+#include "HistogramSink.hpp"
+#include "TraceSink.hpp"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <sys/resource.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <unistd.h>
+
+namespace{
+    using Clock = std::chrono::steady_clock;
+
+    struct Options{
+        std::vector<GraphFamily> families{GraphFamily::Grid, GraphFamily::Geometric, GraphFamily::PowerLaw, GraphFamily::RoadLike};
+        std::vector<unsigned int> sizes{1000, 100000};
+        std::vector<std::string> engines{"graph", "frozen", "frozen32", "compressed", "ch", "hl", "alt", "batch"};
+        unsigned int queries = 1000;
+        unsigned long seed = 1;
+        unsigned int threads = 0;           // 0 means one per hardware thread
+        unsigned int graphLimit = 200000;   // Larger graphs skip the graph engine, whose maps would dominate the run
+        unsigned int chLimit = 2000000;     // Larger graphs skip the ch and hl engines, whose preprocessing would dominate the run
+        unsigned int powerLawLimit = 2000;  // Same as chLimit for powerlaw, whose dense core makes contraction close to quadratic
+        unsigned int landmarks = 16;
+        unsigned int deltaQueries = 20;     // Full trees grown by the delta engine
+        std::string output;                 // Empty means stdout
+        std::string statsFile;              // Empty means no histograms
+        std::string traceFile;              // Empty means no trace
+        RelaxKernel::Isa kernel = RelaxKernel::Isa::Automatic;
+        std::vector<std::string> orders{"original"};    // Vertex orders each engine runs on
+    };
+
+    class CacheCounters{    // Cache read misses of the calling thread, counted in user space by perf_event_open()
+    public:
+        static constexpr int COUNT = 2;     // [0] L1 data cache, [1] last-level cache
+
+        CacheCounters(){
+            const std::uint64_t caches[COUNT] = {PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_LL};
+            for(int c = 0; c < COUNT; ++c){
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = caches[c] | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+                attr.disabled = 1;
+                attr.exclude_kernel = 1;    // Allowed at the default perf_event_paranoid level
+                attr.exclude_hv = 1;
+                fds[c] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+            }
+        }
+
+        CacheCounters(const CacheCounters&) = delete;
+        CacheCounters& operator=(const CacheCounters&) = delete;
+
+        ~CacheCounters(){
+            for(int c = 0; c < COUNT; ++c){
+                if(fds[c] >= 0){
+                    close(fds[c]);
+                }
+            }
+        }
+
+        void start(){
+            for(int c = 0; c < COUNT; ++c){
+                if(fds[c] >= 0){
+                    ioctl(fds[c], PERF_EVENT_IOC_RESET, 0);
+                    ioctl(fds[c], PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+            return;
+        }
+
+        void stop(long long misses[COUNT]){ // -1 for counters the kernel refused
+            for(int c = 0; c < COUNT; ++c){
+                std::uint64_t value = 0;
+                misses[c] = -1;
+                if(fds[c] >= 0){
+                    ioctl(fds[c], PERF_EVENT_IOC_DISABLE, 0);
+                    if(read(fds[c], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))){
+                        misses[c] = value;
+                    }
+                }
+            }
+            return;
+        }
+
+    private:
+        int fds[COUNT];
+    };
+
+    class ForwardingSink : public StatsSink{    // Hands every record to each of a list of sinks
+    public:
+        void add(StatsSink& sink){
+            sinks.push_back(&sink);
+            return;
+        }
+
+        void record(const SearchStats& stats) override{
+            for(StatsSink* sink : sinks){
+                sink->record(stats);
+            }
+            return;
+        }
+
+    private:
+        std::vector<StatsSink*> sinks;
+    };
+
+    struct RunResult{
+        RunResult(const std::string& engine, const std::string& queue = "", const std::string& mode = "", double buildMs = 0)
+            : engine(engine), queue(queue), mode(mode), buildMs(buildMs){}
+
+        std::string engine;
+        std::string queue;      // Empty if the engine has no queue choice
+        std::string mode;       // Empty if the engine has no search mode choice
+        double buildMs;         // Preprocessing before the first query
+        unsigned long failed = 0;       // Queries without a path
+        unsigned long mismatches = 0;   // Distances which disagree with the first run
+        std::vector<double> latencies;  // Microseconds per query, empty if only the total is known
+        double totalMs = 0;
+        unsigned int queries = 0;
+        long peakRssKb = 0;
+        std::string order = "original"; // Vertex order of the graph the run used
+        double reorderMs = 0;           // Time taken by FrozenGraph::reorder(), not part of buildMs
+        long long l1dMisses = -1;       // L1 data cache read misses of the queries, -1 if not counted
+        long long llcMisses = -1;       // Last-level cache read misses of the queries, -1 if not counted
+        double bytesPerEdge = 0;        // Adjacency size per directed edge, 0 if not reported
+    };
+
+    const char* const USAGE =
+        "usage: shortestpath_bench [options]\n"
+        "  --families LIST     grid,geometric,powerlaw,road (default: all)\n"
+        "  --sizes LIST        vertex counts, K and M suffixes allowed (default: 1K,100K)\n"
+        "  --engines LIST      graph,frozen,frozen32,compressed,ch,hl,alt,batch,delta (default: all but delta)\n"
+        "  --queries N         random queries per graph (default: 1000)\n"
+        "  --seed N            seed of the graphs and queries (default: 1)\n"
+        "  --threads N         pool size of batch, delta and the builds, 0 for all cores (default: 0)\n"
+        "  --graph-limit N     largest graph run on the graph engine (default: 200K)\n"
+        "  --ch-limit N        largest graph run on the ch and hl engines (default: 2M)\n"
+        "  --powerlaw-limit N  largest powerlaw graph run on the ch and hl engines (default: 2K)\n"
+        "  --landmarks N       landmarks of the alt engine (default: 16)\n"
+        "  --delta-queries N   trees grown by the delta engine (default: 20)\n"
+        "  --kernel NAME       auto,scalar,sse42,avx2 edge relaxation kernel (default: auto, avx2 where supported)\n"
+        "  --orders LIST       original,random,bfs,rcm,hilbert vertex orders to run every engine on (default: original)\n"
+        "  --output FILE       write the JSON report to FILE instead of stdout\n"
+        "  --stats FILE        write per-engine search statistics histograms to FILE (SHORTESTPATH_STATS builds)\n"
+        "  --trace FILE        write a Chrome trace of every query to FILE (SHORTESTPATH_STATS builds)\n";
+
+    /* Splits "a,b,c" into its fields. */
+    std::vector<std::string> splitList(const std::string& list){
+        std::vector<std::string> fields;
+        std::stringstream stream(list);
+        std::string field;
+        while(std::getline(stream, field, ',')){
+            if(!field.empty()){
+                fields.push_back(field);
+            }
+        }
+
+        return fields;
+    }
+
+    /* Reads a count such as "5000", "10K" or "10M". */
+    unsigned long parseCount(const std::string& text){
+        std::size_t used = 0;
+        unsigned long value = 0;
+        try{
+            value = std::stoul(text, &used);
+        }
+        catch(const std::exception&){
+            throw std::invalid_argument("[ERROR] \"" + text + "\" is not a count. Unable to complete request.");
+        }
+        const std::string suffix = text.substr(used);
+        if(suffix == "K" || suffix == "k"){
+            value *= 1000;
+        }
+        else if(suffix == "M" || suffix == "m"){
+            value *= 1000000;
+        }
+        else if(!suffix.empty()){
+            throw std::invalid_argument("[ERROR] \"" + text + "\" is not a count. Unable to complete request.");
+        }
+
+        return value;
+    }
+
+    /* Fills options from argv. Returns false if only the usage was requested. */
+    bool parseOptions(int argc, char** argv, Options& options){
+        for(int i = 1; i < argc; ++i){
+            const std::string flag = argv[i];
+            if(flag == "--help" || flag == "-h"){
+                return false;
+            }
+            if(i + 1 >= argc){
+                throw std::invalid_argument("[ERROR] Option " + flag + " needs a value. Unable to complete request.");
+            }
+            const std::string value = argv[++i];
+            if(flag == "--families"){
+                options.families.clear();
+                for(const std::string& name : splitList(value)){
+                    options.families.push_back(GraphGenerator::parseFamily(name));
+                }
+            }
+            else if(flag == "--sizes"){
+                options.sizes.clear();
+                for(const std::string& size : splitList(value)){
+                    options.sizes.push_back(parseCount(size));
+                }
+            }
+            else if(flag == "--engines"){
+                options.engines = splitList(value);
+                for(const std::string& engine : options.engines){
+                    if(engine != "graph" && engine != "frozen" && engine != "frozen32" && engine != "compressed" && engine != "ch" && engine != "hl" && engine != "alt" && engine != "batch" && engine != "delta"){
+                        throw std::invalid_argument("[ERROR] Unknown engine \"" + engine + "\". Unable to complete request.");
+                    }
+                }
+            }
+            else if(flag == "--queries"){
+                options.queries = parseCount(value);
+            }
+            else if(flag == "--seed"){
+                options.seed = parseCount(value);
+            }
+            else if(flag == "--threads"){
+                options.threads = parseCount(value);
+            }
+            else if(flag == "--graph-limit"){
+                options.graphLimit = parseCount(value);
+            }
+            else if(flag == "--ch-limit"){
+                options.chLimit = parseCount(value);
+            }
+            else if(flag == "--powerlaw-limit"){
+                options.powerLawLimit = parseCount(value);
+            }
+            else if(flag == "--landmarks"){
+                options.landmarks = parseCount(value);
+            }
+            else if(flag == "--delta-queries"){
+                options.deltaQueries = parseCount(value);
+            }
+            else if(flag == "--kernel"){
+                const RelaxKernel::Isa kernels[] = {RelaxKernel::Isa::Automatic, RelaxKernel::Isa::Scalar, RelaxKernel::Isa::Sse42, RelaxKernel::Isa::Avx2};
+                const auto found = std::find_if(std::begin(kernels), std::end(kernels), [&](RelaxKernel::Isa isa){
+                    return value == RelaxKernel::name(isa);
+                });
+                if(found == std::end(kernels)){
+                    throw std::invalid_argument("[ERROR] Unknown kernel \"" + value + "\". Unable to complete request.");
+                }
+                options.kernel = *found;
+            }
+            else if(flag == "--output"){
+                options.output = value;
+            }
+            else if(flag == "--orders"){
+                options.orders = splitList(value);
+                for(const std::string& order : options.orders){
+                    if(order != "original" && order != "random" && order != "bfs" && order != "rcm" && order != "hilbert"){
+                        throw std::invalid_argument("[ERROR] Unknown vertex order \"" + order + "\". Unable to complete request.");
+                    }
+                }
+            }
+            else if(flag == "--stats"){
+                options.statsFile = value;
+            }
+            else if(flag == "--trace"){
+                options.traceFile = value;
+            }
+            else{
+                throw std::invalid_argument("[ERROR] Unknown option " + flag + ". Unable to complete request.");
+            }
+        }
+
+        return true;
+    }
+
+    /* ru_maxrss is reported in kilobytes on Linux. */
+    long peakRssKb(){
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+    }
+
+    /* Milliseconds between two time points. */
+    double elapsedMs(Clock::time_point from, Clock::time_point to){
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    }
+
+    /* Nearest-rank percentile of sorted values. */
+    double percentile(const std::vector<double>& sorted, double fraction){
+        if(sorted.empty()){
+            return 0;
+        }
+        const std::size_t rank = static_cast<std::size_t>(fraction * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(rank, sorted.size() - 1)];
+    }
+
+    /* Times every query on one engine. query(start, end, path) must return the distance, and throw std::logic_error
+       (the contract of every shortestPath()) if there is no path. The first run of a graph fills reference, later
+       runs are compared with it. Cache misses are counted over the whole loop, bookkeeping included.              */
+    template<typename Query>
+    void timeQueries(RunResult& result, const std::vector<std::pair<std::string, std::string>>& queries, std::vector<unsigned long>& reference, Query query){
+        result.latencies.reserve(queries.size());
+        const bool first = reference.empty();
+        std::vector<std::string> path;
+        CacheCounters counters;
+        counters.start();
+        const Clock::time_point begin = Clock::now();
+        for(std::size_t i = 0; i < queries.size(); ++i){
+            path.clear();
+            unsigned long distance = ULONG_MAX;
+            const Clock::time_point start = Clock::now();
+            try{
+                distance = query(queries[i].first, queries[i].second, path);
+            }
+            catch(const std::logic_error&){
+                ++result.failed;
+            }
+            result.latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+            if(first){
+                reference.push_back(distance);
+            }
+            else if(reference[i] != distance){
+                ++result.mismatches;
+            }
+        }
+        result.totalMs = elapsedMs(begin, Clock::now());
+        long long misses[CacheCounters::COUNT];
+        counters.stop(misses);
+        result.l1dMisses = misses[0];
+        result.llcMisses = misses[1];
+        result.queries = queries.size();
+        result.peakRssKb = peakRssKb();
+
+        return;
+    }
+
+    /* Renumbers graph by the named order. "random" shuffles the IDs with seed, like vertices added in no particular
+       order; "hilbert" needs coordinates and moves them along. Returns false if the order cannot apply to graph.  */
+    bool applyOrder(const std::string& order, FrozenGraph& graph, std::vector<Coordinate>& coordinates, unsigned long seed){
+        std::vector<unsigned int> newId;
+        if(order == "random"){
+            std::vector<unsigned int> sequence(graph.vertexCount());
+            for(unsigned int v = 0; v < sequence.size(); ++v){
+                sequence[v] = v;
+            }
+            std::mt19937_64 random(seed);
+            std::shuffle(sequence.begin(), sequence.end(), random);
+            newId = graph.reorder(sequence);
+        }
+        else if(order == "bfs"){
+            newId = graph.reorder(VertexOrder::Bfs);
+        }
+        else if(order == "rcm"){
+            newId = graph.reorder(VertexOrder::ReverseCuthillMcKee);
+        }
+        else if(order == "hilbert"){
+            if(coordinates.size() != graph.vertexCount()){
+                return false;
+            }
+            newId = graph.reorder(VertexOrder::Hilbert, coordinates);
+        }
+        if(coordinates.size() == newId.size()){
+            std::vector<Coordinate> moved(coordinates.size());
+            for(std::size_t v = 0; v < newId.size(); ++v){
+                moved[newId[v]] = coordinates[v];
+            }
+            coordinates.swap(moved);
+        }
+
+        return true;
+    }
+
+    /* A mutable copy of a snapshot, built through the public API like any user would. */
+    void thaw(const FrozenGraph& frozen, Graph& graph){
+        for(unsigned int v = 0; v < frozen.vertexCount(); ++v){
+            graph.addVertex(frozen.vertexLabel(v));
+        }
+        for(unsigned int v = 0; v < frozen.vertexCount(); ++v){
+            frozen.forEachNeighbor(v, [&](unsigned int next, unsigned long weight){
+                if(v < next){   // Each undirected edge is stored twice
+                    graph.addEdge(frozen.vertexLabel(v), frozen.vertexLabel(next), weight);
+                }
+            });
+        }
+
+        return;
+    }
+
+    std::string queueName(QueueKind kind){
+        return kind == QueueKind::Heap ? "heap" : kind == QueueKind::Radix ? "radix" : kind == QueueKind::Buckets ? "buckets" : "auto";
+    }
+
+    std::string modeName(SearchMode mode){
+        return mode == SearchMode::Bidirectional ? "bi" : "uni";
+    }
+
+    /* Escapes the characters JSON does not allow inside a string. */
+    std::string quote(const std::string& text){
+        std::string quoted = "\"";
+        for(char c : text){
+            if(c == '"' || c == '\\'){
+                quoted += '\\';
+            }
+            quoted += c;
+        }
+
+        return quoted + "\"";
+    }
+
+    /* One element of the "runs" array of a graph. */
+    void writeRun(std::ostream& out, const RunResult& result){
+        std::vector<double> sorted = result.latencies;
+        std::sort(sorted.begin(), sorted.end());
+        out << "        {\"engine\": " << quote(result.engine) << ", \"order\": " << quote(result.order);
+        if(!result.queue.empty()){
+            out << ", \"queue\": " << quote(result.queue);
+        }
+        if(!result.mode.empty()){
+            out << ", \"mode\": " << quote(result.mode);
+        }
+        out << ", \"buildMs\": " << result.buildMs
+            << ", \"queries\": " << result.queries
+            << ", \"failed\": " << result.failed
+            << ", \"mismatches\": " << result.mismatches
+            << ", \"totalMs\": " << result.totalMs
+            << ", \"throughputQps\": " << (result.totalMs > 0 ? result.queries * 1000.0 / result.totalMs : 0.0);
+        if(!sorted.empty()){
+            double sum = 0;
+            for(double latency : sorted){
+                sum += latency;
+            }
+            out << ", \"latencyUs\": {\"mean\": " << sum / sorted.size()
+                << ", \"p50\": " << percentile(sorted, 0.50)
+                << ", \"p90\": " << percentile(sorted, 0.90)
+                << ", \"p99\": " << percentile(sorted, 0.99)
+                << ", \"max\": " << sorted.back() << "}";
+        }
+        if(result.bytesPerEdge > 0){
+            out << ", \"bytesPerEdge\": " << result.bytesPerEdge;
+        }
+        if(result.order != "original"){
+            out << ", \"reorderMs\": " << result.reorderMs;
+        }
+        if(result.l1dMisses >= 0 || result.llcMisses >= 0){
+            out << ", \"cacheMisses\": {\"l1d\": ";
+            if(result.l1dMisses >= 0){
+                out << result.l1dMisses;
+            }
+            else{
+                out << "null";
+            }
+            out << ", \"llc\": ";
+            if(result.llcMisses >= 0){
+                out << result.llcMisses;
+            }
+            else{
+                out << "null";
+            }
+            out << "}";
+        }
+        out << ", \"peakRssKb\": " << result.peakRssKb << "}";
+
+        return;
+    }
+
+    /* Runs every selected engine on one graph, in a fixed order so that the first run is the same for every graph.
+       reference is shared by every vertex order of the graph, since distances never depend on the order.          */
+    std::vector<RunResult> runEngines(const Options& options, const FrozenGraph& frozen, unsigned int chLimit, const std::vector<std::pair<std::string, std::string>>& queries, ThreadPool& pool, std::vector<unsigned long>& reference){
+        auto selected = [&](const std::string& engine){
+            return std::find(options.engines.begin(), options.engines.end(), engine) != options.engines.end();
+        };
+        const QueueKind queueKinds[] = {QueueKind::Heap, QueueKind::Radix, QueueKind::Buckets};
+        const SearchMode searchModes[] = {SearchMode::Unidirectional, SearchMode::Bidirectional};
+        std::vector<RunResult> results;
+
+        if(selected("frozen")){
+            const double frozenBytes = (frozen.vertexCount() + 1.0) * sizeof(std::size_t) + frozen.edgeCount() * (sizeof(unsigned int) + sizeof(unsigned long));
+            FrozenGraph variant = frozen;
+            for(QueueKind kind : queueKinds){
+                for(SearchMode mode : searchModes){
+                    if(kind == QueueKind::Buckets && resolveQueueKind(kind, frozen.getMaxWeight()) != QueueKind::Buckets){
+                        continue;   // Weights too large for buckets. The run would silently repeat radix
+                    }
+                    RunResult result("frozen", queueName(kind), modeName(mode));
+                    result.bytesPerEdge = frozen.edgeCount() == 0 ? 0 : frozenBytes / frozen.edgeCount();
+                    variant.setQueueKind(kind);
+                    variant.setSearchMode(mode);
+                    timeQueries(result, queries, reference, [&](const std::string& a, const std::string& b, std::vector<std::string>& path){
+                        return variant.shortestPath(a, b, path);
+                    });
+                    results.push_back(result);
+                }
+            }
+        }
+        if(selected("frozen32")){
+            try{
+                const Clock::time_point begin = Clock::now();
+                BasicFrozenGraph<unsigned int> narrow(frozen);  // Throws if a weight needs more than 32 bits
+                const double buildMs = elapsedMs(begin, Clock::now());
+                const double narrowBytes = (frozen.vertexCount() + 1.0) * sizeof(std::size_t) + frozen.edgeCount() * (sizeof(unsigned int) + sizeof(unsigned int));
+                for(QueueKind kind : queueKinds){
+                    for(SearchMode mode : searchModes){
+                        if(kind == QueueKind::Buckets && resolveQueueKind(kind, frozen.getMaxWeight()) != QueueKind::Buckets){
+                            continue;
+                        }
+                        RunResult result("frozen32", queueName(kind), modeName(mode), buildMs);
+                        result.bytesPerEdge = frozen.edgeCount() == 0 ? 0 : narrowBytes / frozen.edgeCount();
+                        narrow.setQueueKind(kind);
+                        narrow.setSearchMode(mode);
+                        timeQueries(result, queries, reference, [&](const std::string& a, const std::string& b, std::vector<std::string>& path){
+                            return narrow.shortestPath(a, b, path);
+                        });
+                        results.push_back(result);
+                    }
+                }
+            }
+            catch(const std::out_of_range& e){
+                std::cerr << "[bench] skipping frozen32: " << e.what() << std::endl;
+            }
+        }
+        if(selected("compressed")){
+            const Clock::time_point begin = Clock::now();
+            CompressedGraph compressed(frozen);
+            const double buildMs = elapsedMs(begin, Clock::now());
+            for(QueueKind kind : queueKinds){
+                for(SearchMode mode : searchModes){
+                    if(kind == QueueKind::Buckets && resolveQueueKind(kind, frozen.getMaxWeight()) != QueueKind::Buckets){
+                        continue;
+                    }
+                    RunResult result("compressed", queueName(kind), modeName(mode), buildMs);
+                    result.bytesPerEdge = compressed.bytesPerEdge();
+                    compressed.setQueueKind(kind);
+                    compressed.setSearchMode(mode);
+                    timeQueries(result, queries, reference, [&](const std::string& a, const std::string& b, std::vector<std::string>& path){
+                        return compressed.shortestPath(a, b, path);
+                    });
+                    results.push_back(result);
+                }
+            }
+        }
+        if(selected("graph") && frozen.vertexCount() <= options.graphLimit){
+            Graph graph;
+            const Clock::time_point begin = Clock::now();
+            thaw(frozen, graph);
+            const double buildMs = elapsedMs(begin, Clock::now());
+            for(QueueKind kind : queueKinds){
+                for(SearchMode mode : searchModes){
+                    if(kind == QueueKind::Buckets && resolveQueueKind(kind, frozen.getMaxWeight()) != QueueKind::Buckets){
+                        continue;
+                    }
+                    RunResult result("graph", queueName(kind), modeName(mode), buildMs);
+                    graph.setQueueKind(kind);
+                    graph.setSearchMode(mode);
+                    timeQueries(result, queries, reference, [&](const std::string& a, const std::string& b, std::vector<std::string>& path){
+                        return graph.shortestPath(a, b, path);
+                    });
+                    results.push_back(result);
+                }
+            }
+        }
+        if((selected("ch") || selected("hl")) && frozen.vertexCount() <= chLimit){
+            ContractionHierarchy hierarchy;     // Built once for both engines
+            const Clock::time_point begin = Clock::now();
+            hierarchy.build(frozen);
+            const double hierarchyMs = elapsedMs(begin, Clock::now());
+            if(selected("ch")){
+                RunResult result("ch", "", "", hierarchyMs);
+                timeQueries(result, queries, reference, [&](const std::string& a, const std::string& b, std::vector<std::string>& path){
+                    return hierarchy.shortestPath(frozen, a, b, path);
+                });
+                results.push_back(result);
+            }
+            if(selected("hl")){
+                HubLabels hubs;
+                const Clock::time_point labelBegin = Clock::now();
+                hubs.build(frozen, hierarchy, pool, false);     // Distance only, so no parents
+                RunResult result("hl", "", "", hierarchyMs + elapsedMs(labelBegin, Clock::now()));
+                timeQueries(result, queries, reference, [&](const std::string& a, const std::string& b, std::vector<std::string>&){
+                    return hubs.distance(frozen, a, b);
+                });
+                results.push_back(result);
+            }
+        }
+        if(selected("alt") && frozen.vertexCount() > 0){
+            Landmarks landmarks;
+            const Clock::time_point begin = Clock::now();
+            landmarks.build(frozen, std::min(options.landmarks, frozen.vertexCount()));
+            RunResult result("alt", "", "", elapsedMs(begin, Clock::now()));
+            timeQueries(result, queries, reference, [&](const std::string& a, const std::string& b, std::vector<std::string>& path){
+                return landmarks.shortestPath(frozen, a, b, path);
+            });
+            results.push_back(result);
+        }
+        if(selected("batch")){
+            RunResult result("batch", queueName(frozen.getQueueKind()), modeName(frozen.getSearchMode()));
+            const Clock::time_point begin = Clock::now();
+            const std::vector<QueryResult> answers = frozen.shortestPathBatch(queries, pool);
+            result.totalMs = elapsedMs(begin, Clock::now());
+            result.queries = queries.size();
+            for(std::size_t i = 0; i < answers.size(); ++i){
+                result.failed += answers[i].distance == ULONG_MAX;
+                if(reference.size() == answers.size() && reference[i] != answers[i].distance){
+                    ++result.mismatches;
+                }
+            }
+            if(reference.empty()){
+                for(const QueryResult& answer : answers){
+                    reference.push_back(answer.distance);
+                }
+            }
+            result.peakRssKb = peakRssKb();
+            results.push_back(result);
+        }
+        if(selected("delta")){
+            DeltaStepping stepping(pool.size());
+            const std::vector<std::pair<std::string, std::string>> trees(queries.begin(), queries.begin() + std::min<std::size_t>(queries.size(), options.deltaQueries));
+            RunResult result("delta");
+            const Clock::time_point begin = Clock::now();
+            for(std::size_t i = 0; i < trees.size(); ++i){
+                const Clock::time_point start = Clock::now();
+                stepping.run(frozen, trees[i].first);
+                const unsigned long distance = stepping.distance(frozen.vertexId(trees[i].second));
+                result.latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+                result.failed += distance == ULONG_MAX;
+                if(i < reference.size() && reference[i] != distance){
+                    ++result.mismatches;
+                }
+            }
+            result.totalMs = elapsedMs(begin, Clock::now());
+            result.queries = trees.size();
+            result.peakRssKb = peakRssKb();
+            results.push_back(result);
+        }
+
+        return results;
+    }
+}
+
+/* Generates each graph in turn and writes its results as soon as they are known, so a long run that is cut short
+   still leaves the finished graphs on disk. Graphs are released before the next one is generated, but peak RSS is a
+   high-water mark of the whole process, so the larger sizes should come last.                                      */
+int main(int argc, char** argv){
+    try{
+        Options options;
+        if(!parseOptions(argc, argv, options)){
+            std::cout << USAGE;
+            return 0;
+        }
+        std::ofstream file;
+        if(!options.output.empty()){
+            file.open(options.output);
+            if(!file){
+                throw std::runtime_error("[ERROR] Unable to open " + options.output + ". Unable to complete request.");
+            }
+        }
+        std::ostream& out = options.output.empty() ? std::cout : file;
+        out << std::fixed << std::setprecision(3);
+
+        HistogramSink histograms;
+        TraceSink trace;
+        ForwardingSink sinks;
+        if(!options.statsFile.empty()){
+            sinks.add(histograms);
+        }
+        if(!options.traceFile.empty()){
+            sinks.add(trace);
+        }
+#ifndef SHORTESTPATH_STATS
+        if(!options.statsFile.empty() || !options.traceFile.empty()){
+            std::cerr << "[bench] built without SHORTESTPATH_STATS, so --stats and --trace files will be empty" << std::endl;
+        }
+#endif
+        StatsSink::install(&sinks);
+
+        RelaxKernel::select(options.kernel);    // Throws if the CPU lacks it
+        ThreadPool pool(options.threads);
+        GraphGenerator generator(options.seed, options.threads);
+        out << "{\n  \"seed\": " << options.seed << ", \"threads\": " << pool.size() << ", \"queries\": " << options.queries
+            << ", \"kernel\": " << quote(RelaxKernel::name(RelaxKernel::selected())) << ",\n  \"graphs\": [";
+        bool firstGraph = true;
+        for(unsigned int size : options.sizes){
+            for(GraphFamily family : options.families){
+                const Clock::time_point begin = Clock::now();
+                const FrozenGraph frozen = generator.generate(family, size);
+                const double generateMs = elapsedMs(begin, Clock::now());
+                const std::vector<Coordinate> coordinates = generator.coordinates();    // Empty for powerlaw
+
+                std::mt19937_64 random(options.seed ^ size);
+                std::uniform_int_distribution<unsigned int> vertex(0, std::max(1u, frozen.vertexCount()) - 1);
+                std::vector<std::pair<std::string, std::string>> queries;
+                for(unsigned int q = 0; q < options.queries && frozen.vertexCount() > 0; ++q){
+                    const unsigned int start = vertex(random);
+                    queries.emplace_back(frozen.vertexLabel(start), frozen.vertexLabel(vertex(random)));
+                }
+                std::cerr << "[bench] " << GraphGenerator::familyName(family) << " " << frozen.vertexCount() << " vertices, "
+                          << frozen.edgeCount() / 2 << " edges, generated in " << generateMs << " ms" << std::endl;
+
+                unsigned int chLimit = options.chLimit;
+                if(family == GraphFamily::PowerLaw && options.powerLawLimit < chLimit){
+                    chLimit = options.powerLawLimit;
+                    const bool contracted = std::find(options.engines.begin(), options.engines.end(), "ch") != options.engines.end()
+                                         || std::find(options.engines.begin(), options.engines.end(), "hl") != options.engines.end();
+                    if(contracted && frozen.vertexCount() > chLimit){
+                        std::cerr << "[bench] powerlaw contracts in close to quadratic time, skipping ch and hl above " << chLimit << " vertices (--powerlaw-limit)" << std::endl;
+                    }
+                }
+
+                std::vector<RunResult> results;
+                std::vector<unsigned long> reference;
+                for(const std::string& order : options.orders){
+                    FrozenGraph ordered = frozen;
+                    std::vector<Coordinate> orderedCoordinates = coordinates;
+                    const Clock::time_point reorderBegin = Clock::now();
+                    if(!applyOrder(order, ordered, orderedCoordinates, options.seed)){
+                        std::cerr << "[bench] " << GraphGenerator::familyName(family) << " has no coordinates, skipping " << order << " order" << std::endl;
+                        continue;
+                    }
+                    const double reorderMs = elapsedMs(reorderBegin, Clock::now());
+                    std::vector<RunResult> orderResults = runEngines(options, ordered, chLimit, queries, pool, reference);
+                    for(RunResult& result : orderResults){
+                        result.order = order;
+                        result.reorderMs = reorderMs;
+                        results.push_back(result);
+                    }
+                }
+                out << (firstGraph ? "\n" : ",\n") << "    {\"family\": " << quote(GraphGenerator::familyName(family))
+                    << ", \"vertices\": " << frozen.vertexCount() << ", \"edges\": " << frozen.edgeCount() / 2
+                    << ", \"generateMs\": " << generateMs << ",\n      \"runs\": [";
+                for(std::size_t r = 0; r < results.size(); ++r){
+                    out << (r == 0 ? "\n" : ",\n");
+                    writeRun(out, results[r]);
+                }
+                out << "\n      ]}" << std::flush;
+                firstGraph = false;
+            }
+        }
+        out << "\n  ],\n  \"peakRssKb\": " << peakRssKb() << "\n}\n";
+        StatsSink::install(nullptr);
+
+        if(!options.statsFile.empty()){
+            std::ofstream statsOut(options.statsFile);
+            if(!statsOut){
+                throw std::runtime_error("[ERROR] Unable to open " + options.statsFile + ". Unable to complete request.");
+            }
+            histograms.write(statsOut);
+        }
+        if(!options.traceFile.empty()){
+            trace.write(options.traceFile);
+        }
+    }
+    catch(const std::exception& error){
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a monotone min-priority queue
+   for small integer edge weights, known as Dial's buckets.
+   It offers the same push()/pop()/top() interface as class
+   PQueue. While Dijkstra's algorithm settles a vertex at
+   distance d, every queued key lies in [d, d + C], where C
+   is the largest edge weight. A circular array of C + 1
+   buckets therefore holds each key in bucket (key mod
+   (C + 1)) without two different keys ever sharing a
+   bucket. Pushing and popping are constant time, and the
+   cursor only moves forward, one empty bucket at a time.
+
+   There is no decrease-key. Improved distances are pushed
+   again, and the caller discards the stale entries.         */
+
+#include "BucketQueue.hpp"
+
+#include <vector>
+#include <stdexcept>
+
+/* The bucket array is sized once, from the largest edge weight. */
+BucketQueue::BucketQueue(unsigned long maxWeight){
+    if(maxWeight > MAX_WEIGHT){ // Data security check, the bucket array would not fit in memory
+        throw std::length_error("[ERROR]: Maximum edge weight is too large for a bucket queue. Unable to complete request.");
+    }
+    buckets.resize(maxWeight + 1);
+}
+
+/* Redundant, but satisfies course requirement. */
+BucketQueue::~BucketQueue(){
+    clear();
+}
+
+/* The key must fall inside the window of buckets ahead of the cursor. An
+   empty queue accepts any key and moves the cursor to it, which lets a
+   drained queue be reused for a new search without calling clear().    */
+void BucketQueue::push(const Vertex& newNode){
+    const unsigned long key = newNode.get_distance();
+    if(key < cursor || key - cursor >= buckets.size()){
+        if(size > 0){   // Data security check, keys must stay inside the window
+            throw std::invalid_argument("[ERROR]: Key is outside of the bucket window. Unable to complete request.");
+        }
+        cursor = key;
+    }
+    find_bucket(key).push_back(newNode);
+    ++size;
+
+    return;
+}
+
+/* Every element of the cursor's bucket has the minimum key,
+   so the last one is removed.                               */
+void BucketQueue::pop(){
+    top();  // Data security check, and moves the cursor onto the minimum
+    find_bucket(cursor).pop_back();
+    --size;
+
+    return;
+}
+
+/* Not constant: the cursor is first moved forward to the
+   minimum. Keys pushed after the last pop() may be smaller
+   than any key queued before, so this cannot be done ahead
+   of time.                                                 */
+const Vertex& BucketQueue::top(){
+    if(empty()){    // Data security check
+        throw std::runtime_error("[ERROR]: Queue is empty. Unable to complete request.");
+    }
+    advance();
+
+    return find_bucket(cursor).back();
+}
+
+/* Read-only, so constant. */
+int BucketQueue::get_size() const{
+    return size;
+}
+
+/* Read-only, so constant. */
+bool BucketQueue::empty() const{
+    return size == 0;
+}
+
+/* Calls STL vector function clear() on every bucket. An empty queue has
+   nothing to clear, which keeps reuse between searches from costing O(C). */
+void BucketQueue::clear(){
+    if(size > 0){
+        for(auto it = buckets.begin(); it != buckets.end(); ++it){
+            it->clear();
+        }
+    }
+    cursor = 0;
+    size = 0;
+
+    return;
+}
+
+/* Keys inside one window never collide modulo the bucket count. */
+std::vector<Vertex>& BucketQueue::find_bucket(unsigned long key){
+    return buckets[key % buckets.size()];
+}
+
+/* At most maxWeight buckets are skipped, since a queued key
+   always lies within maxWeight of the previous cursor. Only
+   called while the queue is not empty.                      */
+void BucketQueue::advance(){
+    while(find_bucket(cursor).empty()){
+        ++cursor;
+    }
+
+    return;
+}
@@ -0,0 +1,49 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a monotone min-priority queue
+   for small integer edge weights, known as Dial's buckets.
+   It offers the same push()/pop()/top() interface as class
+   PQueue. While Dijkstra's algorithm settles a vertex at
+   distance d, every queued key lies in [d, d + C], where C
+   is the largest edge weight. A circular array of C + 1
+   buckets therefore holds each key in bucket (key mod
+   (C + 1)) without two different keys ever sharing a
+   bucket. Pushing and popping are constant time, and the
+   cursor only moves forward, one empty bucket at a time.
+
+   There is no decrease-key. Improved distances are pushed
+   again, and the caller discards the stale entries.         */
+
+#ifndef BUCKETQUEUE_HPP
+#define BUCKETQUEUE_HPP
+
+#include "Vertex.hpp"
+
+#include <vector>
+
+class BucketQueue{
+public:
+    static constexpr unsigned long MAX_WEIGHT = 1UL << 24;  // Largest supported C, bounds the bucket array
+
+    BucketQueue(unsigned long maxWeight);   // Creates maxWeight + 1 empty buckets
+    ~BucketQueue(); // Default destructor included to fulfill course requirements. Calls clear()
+    void push(const Vertex& newNode);   // Inserts new element. Its key must lie in [last popped key, last popped key + maxWeight]
+    void pop();     // Removes first element. Calls advance()
+    const Vertex& top();        // Returns first element in queue. Calls advance()
+    int get_size() const;   // Number of queued elements, including stale ones
+    bool empty() const;     // Helper function, used in multiple member functions
+    void clear();   // Empties all buckets
+
+protected:
+    std::vector<Vertex>& find_bucket(unsigned long key);    // Helper function, circular bucket of key
+    void advance(); // Helper function, moves the cursor forward until it reaches a non-empty bucket
+
+private:
+    std::vector<std::vector<Vertex>> buckets;   // maxWeight + 1 circular buckets
+    unsigned long cursor = 0;   // Lower bound on every queued key. Moved forward by advance()
+    int size = 0;               // Total elements across buckets
+};
+
+#endif
@@ -0,0 +1,254 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a read-only graph whose
+   adjacency is compressed to a few bytes per edge, for
+   graphs too large to hold as a FrozenGraph, which spends
+   12 bytes on every directed edge (a 4-byte target and an
+   8-byte weight) and Graph, which spends a map node.
+
+   The neighbors of each vertex are sorted by ID and stored
+   as one byte stream of variable-length integers (seven
+   bits per byte, lowest first, the high bit set on every
+   byte but the last). Each neighbor is a target and a
+   weight: the first target is the signed distance from the
+   vertex itself, zigzag encoded, and every later one is the
+   gap to the target before it. Neighbors are usually close
+   in ID, and always close after FrozenGraph::reorder(), so
+   most gaps, and most road weights, fit in one or two
+   bytes.
+
+   The streams of all vertices are stored back to back.
+   Vertices are grouped into blocks of VERTEX_BLOCK; each
+   block keeps a 64-bit byte offset, and each vertex a
+   32-bit offset from the start of its block, so the index
+   costs 4 bytes per vertex rather than 8.
+
+   forEachNeighbor() decodes a vertex's stream as it goes,
+   with a one-byte fast path, so the templates of
+   Dijkstra.hpp relax edges straight from the compressed
+   bytes and nothing is ever unpacked. shortestPath()
+   follows the same contract as FrozenGraph::shortestPath().  */
+
+#include "CompressedGraph.hpp"
+#include "SearchStats.hpp"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <climits>
+#include <cstdint>
+
+namespace{
+    /* Seven bits per byte, lowest first. The high bit of a byte says that another byte follows. */
+    void putVarint(std::vector<std::uint8_t>& stream, std::uint64_t value){
+        while(value >= 0x80){
+            stream.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        stream.push_back(static_cast<std::uint8_t>(value));
+
+        return;
+    }
+}
+
+/* Builds an empty graph. build() fills it. */
+CompressedGraph::CompressedGraph(){
+    blockOffsets.assign(1, 0);  // stream(0) is valid even when empty
+    vertexOffsets.assign(1, 0);
+}
+
+/* Compresses graph right away. */
+CompressedGraph::CompressedGraph(const FrozenGraph& graph){
+    build(graph);
+}
+
+/* Redundant, but satisfies course requirement. */
+CompressedGraph::~CompressedGraph(){
+    clear();
+}
+
+/* Encodes one vertex at a time, in ID order, so the streams come out back to back. The slice of each vertex is sorted
+   by target first, which makes every gap after the first one non-negative. A block starts every VERTEX_BLOCK
+   vertices; a block whose streams outgrow 32-bit offsets cannot be indexed and is rejected.                         */
+void CompressedGraph::build(const FrozenGraph& graph){
+    clear();
+    const unsigned int n = graph.vertexCount();
+    labels = graph.labels;
+    edges = graph.edgeCount();
+    queueKind = graph.getQueueKind();
+    searchMode = graph.getSearchMode();
+    maxWeight = graph.getMaxWeight();
+    blockOffsets.clear();
+    vertexOffsets.clear();
+    blockOffsets.reserve(n / VERTEX_BLOCK + 1);
+    vertexOffsets.reserve(static_cast<std::size_t>(n) + 1);
+    bytes.reserve(edges * 3);   // About right for road graphs. Trimmed below
+
+    std::vector<std::pair<unsigned int, unsigned long>> slice;
+    for(unsigned int v = 0; v <= n; ++v){
+        if(v % VERTEX_BLOCK == 0){
+            blockOffsets.push_back(bytes.size());
+        }
+        const std::uint64_t within = bytes.size() - blockOffsets.back();
+        if(within > UINT32_MAX){
+            throw std::length_error("[ERROR] Adjacency of one vertex block exceeds 4 GiB. Unable to complete request.");
+        }
+        vertexOffsets.push_back(static_cast<std::uint32_t>(within));
+        if(v == n){
+            break;
+        }
+
+        slice.clear();
+        graph.forEachNeighbor(v, [&](unsigned int next, unsigned long weight){
+            slice.push_back({next, weight});
+        });
+        std::sort(slice.begin(), slice.end());
+        std::uint64_t previous = v;
+        for(auto it = slice.begin(); it != slice.end(); ++it){
+            if(it == slice.begin()){
+                const std::int64_t delta = static_cast<std::int64_t>(it->first) - static_cast<std::int64_t>(v);
+                putVarint(bytes, (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63));
+            }
+            else{
+                putVarint(bytes, it->first - previous);
+            }
+            putVarint(bytes, it->second);
+            previous = it->first;
+        }
+    }
+    bytes.shrink_to_fit();
+
+    return;
+}
+
+/* Same steps as FrozenGraph::shortestPath(). Only the neighbor loop differs, see forEachNeighbor(). */
+unsigned long CompressedGraph::shortestPath(const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path) const{
+    SEARCH_STATS(SearchStats::QueryScope statsQuery("compressed"));
+    // Ensure that the graph contains the correct vertices to process
+    const unsigned int start = labels.find(startLabel);
+    const unsigned int end = labels.find(endLabel);
+    if(start == LabelTable::NO_ID || end == LabelTable::NO_ID){
+        throw std::invalid_argument("[ERROR] One or more specified vertex does not exist. Unable to complete request.");
+    }
+
+    SearchWorkspace& workspace = SearchWorkspace::local();
+    unsigned int meet = end;
+    unsigned long distance;
+    if(searchMode == SearchMode::Bidirectional){
+        distance = bidirectionalDijkstra(*this, vertexCount(), queueKind, maxWeight, start, end, workspace, meet);
+    }
+    else{
+        distance = dijkstra(*this, vertexCount(), queueKind, maxWeight, start, end, workspace);
+    }
+    if(distance == ULONG_MAX){
+        throw std::logic_error("[ERROR] No path exists between the start and end vertices");  // Throw if no path is found
+    }
+    SEARCH_STATS(SearchStats::PhaseTimer reconstructTimer(SearchStats::Reconstruct));
+    reconstruct(path, workspace.forward(), start, meet);
+    if(meet != end){    // The backward half is emitted from end to meet, so it is appended in reverse
+        std::vector<std::string> backwardPath;
+        reconstruct(backwardPath, workspace.backward(), end, meet);
+        path.insert(path.end(), backwardPath.rbegin() + 1, backwardPath.rend());
+    }
+
+    return distance;
+}
+
+/* Read-only, so constant. */
+unsigned int CompressedGraph::vertexCount() const{
+    return labels.size();
+}
+
+/* Read-only, so constant. */
+std::size_t CompressedGraph::edgeCount() const{
+    return edges;
+}
+
+/* Counts what a search reads, not what the vectors have reserved. */
+std::size_t CompressedGraph::byteCount() const{
+    return bytes.size() + blockOffsets.size() * sizeof(std::uint64_t) + vertexOffsets.size() * sizeof(std::uint32_t);
+}
+
+/* Read-only, so constant. */
+double CompressedGraph::bytesPerEdge() const{
+    return edges == 0 ? 0 : static_cast<double>(byteCount()) / edges;
+}
+
+/* Label-to-ID lookup for callers that want to work on dense IDs. */
+unsigned int CompressedGraph::vertexId(const std::string& label) const{
+    const unsigned int id = labels.find(label);
+    if(id == LabelTable::NO_ID){
+        throw std::invalid_argument("[ERROR] Specified vertex does not exist. Unable to complete request.");
+    }
+
+    return id;
+}
+
+/* ID-to-label lookup, the inverse of vertexId(). */
+const std::string& CompressedGraph::vertexLabel(unsigned int id) const{
+    return labels.label(id);    // Throws if id is out of range
+}
+
+/* Releases all arrays, leaving an empty graph whose only stream is the empty one. */
+void CompressedGraph::clear(){
+    labels.clear();
+    edges = 0;
+    std::vector<std::uint64_t>(1, 0).swap(blockOffsets);
+    std::vector<std::uint32_t>(1, 0).swap(vertexOffsets);
+    std::vector<std::uint8_t>().swap(bytes);
+    maxWeight = 0;
+
+    return;
+}
+
+/* Takes effect on the next shortestPath() call. */
+void CompressedGraph::setQueueKind(QueueKind kind){
+    queueKind = kind;
+
+    return;
+}
+
+/* Read-only, so constant. */
+QueueKind CompressedGraph::getQueueKind() const{
+    return queueKind;
+}
+
+/* Takes effect on the next shortestPath() call. */
+void CompressedGraph::setSearchMode(SearchMode mode){
+    searchMode = mode;
+
+    return;
+}
+
+/* Read-only, so constant. */
+SearchMode CompressedGraph::getSearchMode() const{
+    return searchMode;
+}
+
+/* Read-only, so constant. */
+unsigned long CompressedGraph::getMaxWeight() const{
+    return maxWeight;
+}
+
+/* Same logic as FrozenGraph::reconstruct(). */
+void CompressedGraph::reconstruct(std::vector<std::string> &fnlPath, const SearchLabels& fnlEdges, unsigned int start, unsigned int end) const{
+    if(start == end){   // For one-vertex circular path
+        fnlPath.push_back(labels.label(start));
+        return;
+    }
+
+    const std::size_t first = fnlPath.size();   // Only reverse what this call appends
+    unsigned int curr = end;
+    while(curr != start){
+        fnlPath.push_back(labels.label(curr));
+        curr = fnlEdges.parent(curr);
+    }
+    fnlPath.push_back(labels.label(start));
+    std::reverse(fnlPath.begin() + first, fnlPath.end());
+
+    return;
+}
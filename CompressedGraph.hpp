@@ -0,0 +1,117 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a read-only graph whose
+   adjacency is compressed to a few bytes per edge, for
+   graphs too large to hold as a FrozenGraph, which spends
+   12 bytes on every directed edge (a 4-byte target and an
+   8-byte weight) and Graph, which spends a map node.
+
+   The neighbors of each vertex are sorted by ID and stored
+   as one byte stream of variable-length integers (seven
+   bits per byte, lowest first, the high bit set on every
+   byte but the last). Each neighbor is a target and a
+   weight: the first target is the signed distance from the
+   vertex itself, zigzag encoded, and every later one is the
+   gap to the target before it. Neighbors are usually close
+   in ID, and always close after FrozenGraph::reorder(), so
+   most gaps, and most road weights, fit in one or two
+   bytes.
+
+   The streams of all vertices are stored back to back.
+   Vertices are grouped into blocks of VERTEX_BLOCK; each
+   block keeps a 64-bit byte offset, and each vertex a
+   32-bit offset from the start of its block, so the index
+   costs 4 bytes per vertex rather than 8.
+
+   forEachNeighbor() decodes a vertex's stream as it goes,
+   with a one-byte fast path, so the templates of
+   Dijkstra.hpp relax edges straight from the compressed
+   bytes and nothing is ever unpacked. shortestPath()
+   follows the same contract as FrozenGraph::shortestPath().  */
+
+#ifndef COMPRESSEDGRAPH_HPP
+#define COMPRESSEDGRAPH_HPP
+
+#include "FrozenGraph.hpp"
+#include "LabelTable.hpp"
+#include "Dijkstra.hpp"
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class CompressedGraph{
+public:
+    static constexpr unsigned int VERTEX_BLOCK = 64;    // Vertices sharing one 64-bit block offset
+
+    CompressedGraph();  // Empty graph. Populated by build()
+    explicit CompressedGraph(const FrozenGraph& graph);  // Calls build()
+    ~CompressedGraph(); // Default destructor included to fulfill course requirements. Calls clear()
+    void build(const FrozenGraph& graph);   // Compresses the adjacency of graph and copies its labels and settings
+    unsigned long shortestPath(const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path) const; // Same contract as FrozenGraph::shortestPath()
+    unsigned int vertexCount() const;   // Number of vertices (dense IDs are 0 to vertexCount() - 1)
+    std::size_t edgeCount() const;      // Number of directed edges (each undirected edge is stored twice)
+    std::size_t byteCount() const;      // Size of the adjacency: streams plus both offset arrays. Labels are not included
+    double bytesPerEdge() const;        // byteCount() per directed edge, 0 if there are no edges
+    unsigned int vertexId(const std::string& label) const;  // Translates a label to its dense ID. Throws if not found
+    const std::string& vertexLabel(unsigned int id) const;  // Translates a dense ID back to its label
+    void clear();   // Releases all arrays
+    void setQueueKind(QueueKind kind);  // Selects the priority queue used by shortestPath(). Copied from the FrozenGraph by build()
+    QueueKind getQueueKind() const;
+    void setSearchMode(SearchMode mode);    // Selects one- or two-sided search in shortestPath(). Copied from the FrozenGraph by build()
+    SearchMode getSearchMode() const;
+    unsigned long getMaxWeight() const; // Largest edge weight, drives QueueKind::Automatic
+
+    template<typename Visit>
+    void forEachNeighbor(unsigned int id, Visit visit) const{   // Calls visit(neighbor ID, weight) for each neighbor of id. Used by dijkstra()
+        const std::uint8_t* next = stream(id);
+        const std::uint8_t* const end = stream(id + 1);
+        if(next == end){
+            return;
+        }
+        const std::uint64_t first = readVarint(next);   // Zigzag encoded distance from id
+        std::uint64_t target = id + ((first >> 1) ^ (0 - (first & 1)));
+        visit(static_cast<unsigned int>(target), static_cast<unsigned long>(readVarint(next)));
+        while(next != end){
+            target += readVarint(next);
+            visit(static_cast<unsigned int>(target), static_cast<unsigned long>(readVarint(next)));
+        }
+    }
+
+protected:
+    const std::uint8_t* stream(unsigned int id) const{  // First byte of the stream of id, or the end of the streams for id == vertexCount()
+        return bytes.data() + blockOffsets[id / VERTEX_BLOCK] + vertexOffsets[id];
+    }
+
+    static std::uint64_t readVarint(const std::uint8_t*& next){ // Decodes one integer and advances next past it
+        std::uint64_t value = *next++;
+        if(value < 0x80){   // Most gaps and weights are one byte
+            return value;
+        }
+        value &= 0x7F;
+        for(unsigned int shift = 7; ; shift += 7){
+            const std::uint64_t byte = *next++;
+            value |= (byte & 0x7F) << shift;
+            if(byte < 0x80){
+                return value;
+            }
+        }
+    }
+
+    void reconstruct(std::vector<std::string> &fnlPath, const SearchLabels& fnlEdges, unsigned int start, unsigned int end) const; // Same as FrozenGraph::reconstruct()
+
+private:
+    LabelTable labels;                          // Copied from the FrozenGraph
+    std::size_t edges = 0;                      // Directed edges
+    std::vector<std::uint64_t> blockOffsets;    // vertexCount() / VERTEX_BLOCK + 1 entries. Byte offset of each block
+    std::vector<std::uint32_t> vertexOffsets;   // vertexCount() + 1 entries. Byte offset of each stream within its block
+    std::vector<std::uint8_t> bytes;            // Every stream, back to back
+    QueueKind queueKind = QueueKind::Automatic;
+    SearchMode searchMode = SearchMode::Unidirectional;
+    unsigned long maxWeight = 0;
+};
+
+#endif
@@ -0,0 +1,551 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a contraction hierarchy (CH)
+   built on top of a FrozenGraph. Preprocessing removes
+   ("contracts") the vertices one at a time, in order of
+   importance. Whenever a contracted vertex v lies on the
+   only shortest path between two of its neighbors u and w,
+   a shortcut edge u-w of weight w(u,v) + w(v,w) is added,
+   so that distances between the remaining vertices never
+   change. The order of contraction is the vertex's rank.
+
+   Vertices are ordered by edge difference: the number of
+   shortcuts contracting a vertex would add, minus the edges
+   it would remove, plus the number of neighbors contracted
+   before it (which spreads contraction evenly over the
+   graph). A shortcut is skipped if a local witness search
+   finds a path at least as short which avoids v.
+
+   Every original edge and shortcut is stored once, in the
+   upward graph of its lower ranked endpoint. A query runs
+   Dijkstra's algorithm from both ends, but only along
+   upward edges, so each side explores a tiny search space.
+   Because edges are undirected, the downward graph used by
+   the backward search is the reverse of the upward graph
+   and has the very same adjacency, so one CSR serves both
+   directions. Each shortcut remembers the vertex it
+   bypasses, which lets shortestPath() unpack the result
+   into the same vertex-by-vertex path as
+   FrozenGraph::shortestPath().
+
+   distanceMatrix() is the bucket-based many-to-many query.
+   An upward search from every target leaves (target,
+   distance) entries in a bucket at each vertex it settles.
+   An upward search from every origin then scans the bucket
+   of each vertex it settles, and the smallest sum found for
+   a target is the exact distance, because every shortest
+   path climbs to its highest vertex and descends from it.   */
+
+#include "ContractionHierarchy.hpp"
+#include "SearchStats.hpp"
+#include "LabelTable.hpp"
+#include "WeightTraits.hpp"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <climits>
+#include <memory_resource>
+
+namespace{
+    const long PRIORITY_OFFSET = 1L << 40;  // Edge differences may be negative, PQueue keys may not
+}
+
+/* Defined solely for course requirement. */
+ContractionHierarchy::ContractionHierarchy(){
+    // No logical implementation required
+}
+
+/* Redundant, but satisfies course requirement. */
+ContractionHierarchy::~ContractionHierarchy(){
+    clear();
+}
+
+/* Contracts every vertex of graph. The overlay starts as a copy of the CSR adjacency, and each contraction
+   [a] adds the shortcuts which keep distances between the remaining vertices intact,
+   [b] freezes the vertex's remaining edges as its upward edges (all of its neighbors are contracted later), and
+   [c] removes the vertex from its neighbors' lists, so that the overlay only ever holds uncontracted vertices.
+   Every overlay edge knows the index of its twin in the other endpoint's list, so [c] removes it in O(1).
+   The next vertex is the one with the smallest edge difference. A priority goes stale when a neighbor of its
+   vertex is contracted, so it is refreshed lazily: a stale vertex is recomputed once when popped, and queued
+   again if its fresh priority is worse than the next one. A vertex that is not stale is contracted at once.     */
+void ContractionHierarchy::build(const FrozenGraph& graph){
+    clear();
+    vertices = graph.vertexCount();
+    edges = graph.edgeCount();
+
+    std::vector<std::vector<OverlayEdge>> overlay(vertices);
+    for(unsigned int v = 0; v < vertices; ++v){
+        graph.forEachNeighbor(v, [&](unsigned int next, unsigned long weight){
+            if(next > v){   // Each undirected edge is met from both ends, and added to both lists at the first
+                overlay[v].push_back({next, weight, LabelTable::NO_ID, static_cast<unsigned int>(overlay[next].size())});
+                overlay[next].push_back({v, weight, LabelTable::NO_ID, static_cast<unsigned int>(overlay[v].size() - 1)});
+            }
+        });
+    }
+    witnessDistance.assign(vertices, ULONG_MAX);
+    witnessHops.assign(vertices, 0);
+    witnessTarget.assign(vertices, false);
+    overlaySlot.assign(vertices, LabelTable::NO_ID);
+    witnessQueue.reserve(vertices);
+    std::vector<unsigned int> deletedNeighbors(vertices, 0);
+    std::vector<bool> stale(vertices, false);
+    auto priority = [&](unsigned int v){
+        return static_cast<long>(contract(overlay, v, true)) - static_cast<long>(overlay[v].size()) + static_cast<long>(deletedNeighbors[v]);
+    };
+
+    PQueue order;
+    order.reserve(vertices);
+    for(unsigned int v = 0; v < vertices; ++v){
+        order.push(Vertex(priority(v) + PRIORITY_OFFSET, v));
+    }
+
+    std::vector<std::vector<OverlayEdge>> upward(vertices);
+    ranks.assign(vertices, 0);
+    unsigned int nextRank = 0;
+    while(!order.empty()){
+        const unsigned int v = order.top().get_id();
+        order.pop();
+        if(stale[v]){
+            stale[v] = false;
+            const unsigned long fresh = priority(v) + PRIORITY_OFFSET;
+            if(!order.empty() && fresh > order.top().get_distance()){   // Lazy update: no longer the best candidate
+                order.push(Vertex(fresh, v));
+                continue;
+            }
+        }
+
+        contract(overlay, v, false);    // [a]
+        ranks[v] = nextRank++;
+        upward[v].swap(overlay[v]);     // [b]
+        for(auto it = upward[v].begin(); it != upward[v].end(); ++it){  // [c]
+            std::vector<OverlayEdge>& list = overlay[it->target];
+            if(it->twin + 1 != list.size()){    // Move the last edge into the hole, and tell its twin where it went
+                list[it->twin] = list.back();
+                overlay[list[it->twin].target][list[it->twin].twin].twin = it->twin;
+            }
+            list.pop_back();
+            ++deletedNeighbors[it->target];
+            stale[it->target] = true;
+        }
+    }
+
+    upOffsets.assign(1, 0);
+    for(unsigned int v = 0; v < vertices; ++v){
+        for(auto it = upward[v].begin(); it != upward[v].end(); ++it){
+            upTargets.push_back(it->target);
+            upWeights.push_back(it->weight);
+            upMiddles.push_back(it->middle);
+            shortcuts += it->middle != LabelTable::NO_ID;
+        }
+        upOffsets.push_back(upTargets.size());
+        std::vector<OverlayEdge>().swap(upward[v]); // Release each list as soon as it is copied
+    }
+    witnessDistance.clear();    // Scratch space is only needed during build()
+    witnessTouched.clear();
+    witnessHops.clear();
+    witnessTarget.clear();
+    overlaySlot.clear();
+    witnessQueue.clear();
+
+    return;
+}
+
+/* Same contract as FrozenGraph::shortestPath(). The upward search returns the vertex where both sides met. Each half
+   of the path is first collected as a list of upward edges, then every edge is unpacked into original vertices.     */
+unsigned long ContractionHierarchy::shortestPath(const FrozenGraph& graph, const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path) const{
+    SEARCH_STATS(SearchStats::QueryScope statsQuery("ch"));
+    if(graph.vertexCount() != vertices || graph.edgeCount() != edges){
+        throw std::invalid_argument("[ERROR] Hierarchy was built for a different graph. Unable to complete request.");
+    }
+    const unsigned int start = graph.vertexId(startLabel);  // Throws if either vertex does not exist
+    const unsigned int end = graph.vertexId(endLabel);
+
+    SearchWorkspace& workspace = SearchWorkspace::local();
+    unsigned int meet = start;
+    const unsigned long distance = upwardSearch(start, end, workspace, meet);
+    if(distance == ULONG_MAX){
+        throw std::logic_error("[ERROR] No path exists between the start and end vertices");  // Throw if no path is found
+    }
+
+    SEARCH_STATS(SearchStats::PhaseTimer reconstructTimer(SearchStats::Reconstruct));
+    std::pmr::memory_resource& scratch = workspace.scratch();  // Both lists below die with this call
+    std::pmr::vector<std::pair<unsigned int, std::size_t>> hops(&scratch);    // (lower endpoint, upward edge) from meet down to start
+    for(unsigned int curr = meet; curr != start; ){
+        const unsigned int lower = workspace.forward().parent(curr);
+        hops.push_back({lower, findUpward(lower, curr)});
+        curr = lower;
+    }
+    std::pmr::vector<unsigned int> vertexPath(1, start, &scratch);
+    for(auto it = hops.rbegin(); it != hops.rend(); ++it){  // Upward half, start to meet
+        unpack(it->first, it->second, vertexPath);
+    }
+    for(unsigned int curr = meet; curr != end; ){           // Downward half, meet to end
+        const unsigned int lower = workspace.backward().parent(curr);
+        unpack(curr, findUpward(lower, curr), vertexPath);
+        curr = lower;
+    }
+    for(auto it = vertexPath.begin(); it != vertexPath.end(); ++it){
+        path.push_back(graph.vertexLabel(*it));
+    }
+
+    return distance;
+}
+
+/* Distance-only query. Skips unpacking, so only the two upward searches are paid for. */
+unsigned long ContractionHierarchy::distance(unsigned int start, unsigned int end) const{
+    if(start >= vertices || end >= vertices){
+        throw std::out_of_range("[ERROR] Specified vertex ID is out of range. Unable to complete request.");
+    }
+    unsigned int meet = start;
+
+    return upwardSearch(start, end, SearchWorkspace::local(), meet);
+}
+
+/* Both phases run one upward search per origin or target on pool. The backward phase collects each target's entries
+   separately, then all entries are sorted by vertex so that a bucket is one contiguous range found by binary search.
+   The forward phase writes each origin's row on one worker only, so neither phase needs locking.                    */
+std::vector<unsigned long> ContractionHierarchy::distanceMatrix(const FrozenGraph& graph, const std::vector<std::string>& originLabels, const std::vector<std::string>& targetLabels, ThreadPool& pool) const{
+    if(graph.vertexCount() != vertices || graph.edgeCount() != edges){
+        throw std::invalid_argument("[ERROR] Hierarchy was built for a different graph. Unable to complete request.");
+    }
+    std::vector<unsigned int> origins, targets;
+    for(auto it = originLabels.begin(); it != originLabels.end(); ++it){
+        origins.push_back(graph.vertexId(*it)); // Throws if any vertex does not exist
+    }
+    for(auto it = targetLabels.begin(); it != targetLabels.end(); ++it){
+        targets.push_back(graph.vertexId(*it));
+    }
+
+    std::vector<std::vector<BucketEntry>> targetEntries(targets.size());
+    pool.parallelFor(targets.size(), [&](std::size_t j, unsigned int){
+        std::vector<std::pair<unsigned int, unsigned long>> space;
+        upwardSpace(targets[j], SearchWorkspace::local(), space);
+        for(auto it = space.begin(); it != space.end(); ++it){
+            targetEntries[j].push_back({it->first, static_cast<unsigned int>(j), it->second});
+        }
+    });
+    std::vector<BucketEntry> buckets;
+    for(auto it = targetEntries.begin(); it != targetEntries.end(); ++it){
+        buckets.insert(buckets.end(), it->begin(), it->end());
+        std::vector<BucketEntry>().swap(*it);   // Release each list as soon as it is copied
+    }
+    const auto byVertex = [](const BucketEntry& a, const BucketEntry& b){
+        return a.vertex < b.vertex;
+    };
+    std::sort(buckets.begin(), buckets.end(), byVertex);
+
+    std::vector<unsigned long> matrix(origins.size() * targets.size(), ULONG_MAX);
+    pool.parallelFor(origins.size(), [&](std::size_t i, unsigned int){
+        std::vector<std::pair<unsigned int, unsigned long>> space;
+        upwardSpace(origins[i], SearchWorkspace::local(), space);
+        unsigned long* row = matrix.data() + i * targets.size();
+        for(auto it = space.begin(); it != space.end(); ++it){
+            const BucketEntry key = {it->first, 0, 0};
+            const auto range = std::equal_range(buckets.begin(), buckets.end(), key, byVertex);
+            for(auto bt = range.first; bt != range.second; ++bt){
+                const unsigned long via = saturatingAdd(it->second, bt->distance); // ULONG_MAX never beats an unreached entry
+                if(via < row[bt->target]){
+                    row[bt->target] = via;
+                }
+            }
+        }
+    });
+
+    return matrix;
+}
+
+/* Read-only, so constant. */
+unsigned int ContractionHierarchy::rank(unsigned int vertex) const{
+    if(vertex >= ranks.size()){
+        throw std::out_of_range("[ERROR] Specified vertex ID is out of range. Unable to complete request.");
+    }
+
+    return ranks[vertex];
+}
+
+/* Read-only, so constant. */
+std::size_t ContractionHierarchy::shortcutCount() const{
+    return shortcuts;
+}
+
+/* Read-only, so constant. */
+unsigned int ContractionHierarchy::vertexCount() const{
+    return vertices;
+}
+
+/* Abstracts the STL vector clear() functions. */
+void ContractionHierarchy::clear(){
+    ranks.clear();
+    upOffsets.clear();
+    upTargets.clear();
+    upWeights.clear();
+    upMiddles.clear();
+    witnessDistance.clear();
+    witnessTouched.clear();
+    witnessHops.clear();
+    witnessTarget.clear();
+    overlaySlot.clear();
+    witnessQueue.clear();
+    vertices = 0;
+    edges = 0;
+    shortcuts = 0;
+
+    return;
+}
+
+/* Dijkstra's algorithm from both ends over upward edges only. The two sides alternate by smallest key, and a side
+   stops once its smallest key reaches the best distance found, since every later vertex on that side is farther.
+   Every vertex reached by both sides is a candidate meeting point. A popped vertex is "stalled" (not relaxed) if a
+   higher neighbor already proves that its label is too large; its label can then never lead to the best path. The
+   parent of each reached vertex is the lower endpoint of the upward edge it was reached by, so the labels left in
+   workspace lead from meet back down to start and to end.                                                          */
+unsigned long ContractionHierarchy::upwardSearch(unsigned int start, unsigned int end, SearchWorkspace& workspace, unsigned int& meet) const{
+    SearchLabels& forwardLabels = workspace.forward();
+    SearchLabels& backwardLabels = workspace.backward();
+    SEARCH_STATS(SearchStats::PhaseTimer initTimer(SearchStats::Init));
+    forwardLabels.reset(vertices);
+    backwardLabels.reset(vertices);
+    SEARCH_STATS(initTimer.stop());
+    SEARCH_STATS(SearchStats::PhaseTimer searchTimer(SearchStats::Search));
+    forwardLabels.set(start, 0, LabelTable::NO_ID);
+    backwardLabels.set(end, 0, LabelTable::NO_ID);
+    meet = start;
+    unsigned long best = start == end ? 0 : ULONG_MAX;
+
+    PQueue& forwardQueue = workspace.heap(false);
+    PQueue& backwardQueue = workspace.heap(true);
+    forwardQueue.reserve(vertices);
+    backwardQueue.reserve(vertices);
+    forwardQueue.push(Vertex(0, start));
+    backwardQueue.push(Vertex(0, end));
+    while(!forwardQueue.empty() || !backwardQueue.empty()){
+        const bool forward = !forwardQueue.empty() && (backwardQueue.empty() || forwardQueue.top().get_distance() <= backwardQueue.top().get_distance());
+        PQueue& pQueue = forward ? forwardQueue : backwardQueue;
+        SearchLabels& thisSide = forward ? forwardLabels : backwardLabels;
+        const SearchLabels& otherSide = forward ? backwardLabels : forwardLabels;
+
+        const unsigned long currDistance = pQueue.top().get_distance();
+        const unsigned int curr = pQueue.top().get_id();
+        if(currDistance >= best){   // Nothing left on this side can improve best
+            pQueue.clear();
+            continue;
+        }
+        pQueue.pop();
+        SEARCH_STATS(++SearchStats::local().pops);
+        SEARCH_STATS(++SearchStats::local().settled);
+        const unsigned long otherDistance = otherSide.distance(curr);
+        if(saturatingAdd(currDistance, otherDistance) < best){
+            best = saturatingAdd(currDistance, otherDistance);
+            meet = curr;
+        }
+
+        bool stalled = false;
+        forEachUpward(curr, [&](unsigned int next, unsigned long weight, std::size_t){
+            const unsigned long nextDistance = thisSide.distance(next);
+            stalled = stalled || saturatingAdd(nextDistance, weight) < currDistance;
+        });
+        if(stalled){
+            continue;
+        }
+        forEachUpward(curr, [&](unsigned int next, unsigned long weight, std::size_t){
+            SEARCH_STATS(++SearchStats::local().relaxations);
+            const unsigned long testD = saturatingAdd(currDistance, weight);
+            if(testD < thisSide.distance(next)){
+                thisSide.set(next, testD, curr);
+                pQueue.push(Vertex(testD, next));
+                SEARCH_STATS(SearchStats::local().notePush(pQueue));
+            }
+        });
+    }
+
+    return best;
+}
+
+/* Plain upward Dijkstra with no end-vertex, using the same stall-on-demand rule as upwardSearch(). Stalled vertices
+   are left out of space: their labels are too large, and the highest vertex of a shortest path is never stalled.   */
+void ContractionHierarchy::upwardSpace(unsigned int source, SearchWorkspace& workspace, std::vector<std::pair<unsigned int, unsigned long>>& space) const{
+    SearchLabels& labels = workspace.forward();
+    labels.reset(vertices);
+    labels.set(source, 0, LabelTable::NO_ID);
+    PQueue& pQueue = workspace.heap();
+    pQueue.reserve(vertices);
+    pQueue.push(Vertex(0, source));
+    while(!pQueue.empty()){
+        const unsigned long currDistance = pQueue.top().get_distance();
+        const unsigned int curr = pQueue.top().get_id();
+        pQueue.pop();
+
+        bool stalled = false;
+        forEachUpward(curr, [&](unsigned int next, unsigned long weight, std::size_t){
+            const unsigned long nextDistance = labels.distance(next);
+            stalled = stalled || saturatingAdd(nextDistance, weight) < currDistance;
+        });
+        if(stalled){
+            continue;
+        }
+        space.push_back({curr, currDistance});
+        forEachUpward(curr, [&](unsigned int next, unsigned long weight, std::size_t){
+            const unsigned long testD = saturatingAdd(currDistance, weight);
+            if(testD < labels.distance(next)){
+                labels.set(next, testD, curr);
+                pQueue.push(Vertex(testD, next));
+            }
+        });
+    }
+
+    return;
+}
+
+/* A shortcut u-w with middle m stands for the two edges u-m and m-w, both of which are upward edges of m, since m was
+   contracted before u and w. The two halves are pushed on a stack in reverse order, so that they are expanded from
+   "from" outward, and original edges are emitted as they surface. Only the far endpoint of each edge is appended.  */
+void ContractionHierarchy::unpack(unsigned int from, std::size_t edge, std::pmr::vector<unsigned int>& path) const{
+    std::vector<std::pair<unsigned int, std::size_t>> pending(1, {from, edge});
+    while(!pending.empty()){
+        const unsigned int near = pending.back().first;
+        const std::size_t curr = pending.back().second;
+        pending.pop_back();
+        const unsigned int lower = edgeSource(curr);
+        const unsigned int far = near == lower ? upTargets[curr] : lower;
+        const unsigned int middle = upMiddles[curr];
+        if(middle == LabelTable::NO_ID){
+            path.push_back(far);
+            continue;
+        }
+        pending.push_back({middle, findUpward(middle, far)});   // Second half, expanded last
+        pending.push_back({near, findUpward(middle, near)});    // First half, expanded first
+    }
+
+    return;
+}
+
+/* The vertex whose range of upOffsets contains edge. Vertices without upward edges have empty ranges and are skipped. */
+unsigned int ContractionHierarchy::edgeSource(std::size_t edge) const{
+    return std::upper_bound(upOffsets.begin(), upOffsets.end(), edge) - upOffsets.begin() - 1;
+}
+
+/* Linear scan of one upward list. Lists are short, and this only runs while unpacking a found path. */
+std::size_t ContractionHierarchy::findUpward(unsigned int lower, unsigned int higher) const{
+    for(std::size_t i = upOffsets[lower]; i < upOffsets[lower + 1]; ++i){
+        if(upTargets[i] == higher){
+            return i;
+        }
+    }
+
+    throw std::logic_error("[ERROR] Shortcut refers to a missing edge. Hierarchy is corrupted.");
+}
+
+/* For every pair of neighbors (u, w) of v, a shortcut of weight w(u,v) + w(v,w) is needed unless the witness search
+   from u finds a path to w which avoids v and is no longer. One witness search per u covers all of its partners w.
+   When simulate is set, shortcuts are only counted with hop-limited witness searches, which is how build() computes
+   edge differences. Otherwise each shortcut is added to both endpoints, or improves an existing edge between them;
+   overlaySlot indexes the list of u, so that an existing u-w edge is found without scanning that list.             */
+int ContractionHierarchy::contract(std::vector<std::vector<OverlayEdge>>& overlay, unsigned int v, bool simulate){
+    const std::vector<OverlayEdge>& neighbors = overlay[v];
+    int needed = 0;
+    for(std::size_t i = 0; i + 1 < neighbors.size(); ++i){
+        const unsigned int u = neighbors[i].target;
+        unsigned long limit = 0;    // Longest path through v which the witness search has to beat
+        for(std::size_t j = i + 1; j < neighbors.size(); ++j){
+            limit = std::max(limit, saturatingAdd(neighbors[i].weight, neighbors[j].weight));
+            witnessTarget[neighbors[j].target] = true;
+        }
+        witnessSearch(overlay, u, v, limit, simulate ? WITNESS_HOP_LIMIT : UINT_MAX, neighbors.size() - i - 1);
+        for(std::size_t j = i + 1; j < neighbors.size(); ++j){
+            witnessTarget[neighbors[j].target] = false;
+        }
+        if(!simulate){
+            for(std::size_t k = 0; k < overlay[u].size(); ++k){
+                overlaySlot[overlay[u][k].target] = k;
+            }
+        }
+        for(std::size_t j = i + 1; j < neighbors.size(); ++j){
+            const unsigned int w = neighbors[j].target;
+            const unsigned long via = saturatingAdd(neighbors[i].weight, neighbors[j].weight);
+            if(via == ULONG_MAX || witnessDistance[w] <= via){  // A path too long to represent needs no shortcut
+                continue;
+            }
+            ++needed;
+            if(simulate){
+                continue;
+            }
+            const unsigned int slot = overlaySlot[w];
+            if(slot != LabelTable::NO_ID){  // Improve an existing u-w edge...
+                OverlayEdge& edge = overlay[u][slot];
+                if(via < edge.weight){
+                    edge.weight = via;
+                    edge.middle = v;
+                    overlay[w][edge.twin].weight = via;
+                    overlay[w][edge.twin].middle = v;
+                }
+            }
+            else{   // ...or add a new one to both endpoints
+                overlaySlot[w] = overlay[u].size();
+                overlay[u].push_back({w, via, v, static_cast<unsigned int>(overlay[w].size())});
+                overlay[w].push_back({u, via, v, static_cast<unsigned int>(overlay[u].size() - 1)});
+            }
+        }
+        if(!simulate){
+            for(auto it = overlay[u].begin(); it != overlay[u].end(); ++it){
+                overlaySlot[it->target] = LabelTable::NO_ID;
+            }
+        }
+    }
+
+    return needed;
+}
+
+/* Dijkstra's algorithm from source over the overlay, never entering avoid. The search stops once all targets (the
+   vertices marked in witnessTarget) are settled. It gives up once its smallest key exceeds limit, or after
+   WITNESS_SETTLE_LIMIT vertices, and never extends a path of hopLimit edges; a missed witness only costs an
+   unnecessary shortcut. Only the entries touched by the previous search are reset, so each search costs what it
+   explores.                                                                                                         */
+void ContractionHierarchy::witnessSearch(const std::vector<std::vector<OverlayEdge>>& overlay, unsigned int source, unsigned int avoid, unsigned long limit, unsigned int hopLimit, unsigned int targets){
+    for(auto it = witnessTouched.begin(); it != witnessTouched.end(); ++it){
+        witnessDistance[*it] = ULONG_MAX;
+    }
+    witnessTouched.clear();
+    witnessQueue.clear();
+
+    witnessDistance[source] = 0;
+    witnessHops[source] = 0;
+    witnessTouched.push_back(source);
+    witnessQueue.push(Vertex(0, source));
+    unsigned int settled = 0;
+    while(!witnessQueue.empty() && settled < WITNESS_SETTLE_LIMIT){
+        const unsigned long currDistance = witnessQueue.top().get_distance();
+        const unsigned int curr = witnessQueue.top().get_id();
+        if(currDistance > limit){
+            break;
+        }
+        witnessQueue.pop();
+        if(witnessTarget[curr] && --targets == 0){
+            break;
+        }
+        ++settled;
+        if(witnessHops[curr] >= hopLimit){
+            continue;
+        }
+        for(auto it = overlay[curr].begin(); it != overlay[curr].end(); ++it){
+            if(it->target == avoid){
+                continue;
+            }
+            const unsigned long testD = saturatingAdd(currDistance, it->weight);
+            if(testD < witnessDistance[it->target]){
+                if(witnessDistance[it->target] == ULONG_MAX){
+                    witnessTouched.push_back(it->target);
+                }
+                witnessDistance[it->target] = testD;
+                witnessHops[it->target] = witnessHops[curr] + 1;
+                witnessQueue.push(Vertex(testD, it->target));
+            }
+        }
+    }
+
+    return;
+}
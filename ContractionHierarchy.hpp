@@ -0,0 +1,123 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a contraction hierarchy (CH)
+   built on top of a FrozenGraph. Preprocessing removes
+   ("contracts") the vertices one at a time, in order of
+   importance. Whenever a contracted vertex v lies on the
+   only shortest path between two of its neighbors u and w,
+   a shortcut edge u-w of weight w(u,v) + w(v,w) is added,
+   so that distances between the remaining vertices never
+   change. The order of contraction is the vertex's rank.
+
+   Vertices are ordered by edge difference: the number of
+   shortcuts contracting a vertex would add, minus the edges
+   it would remove, plus the number of neighbors contracted
+   before it (which spreads contraction evenly over the
+   graph). A shortcut is skipped if a local witness search
+   finds a path at least as short which avoids v. Priorities
+   are only estimates, so their witness searches follow at
+   most a few edges, and a priority is only recomputed once
+   a neighbor of its vertex has been contracted.
+
+   Every original edge and shortcut is stored once, in the
+   upward graph of its lower ranked endpoint. A query runs
+   Dijkstra's algorithm from both ends, but only along
+   upward edges, so each side explores a tiny search space.
+   Because edges are undirected, the downward graph used by
+   the backward search is the reverse of the upward graph
+   and has the very same adjacency, so one CSR serves both
+   directions. Each shortcut remembers the vertex it
+   bypasses, which lets shortestPath() unpack the result
+   into the same vertex-by-vertex path as
+   FrozenGraph::shortestPath().
+
+   distanceMatrix() is the bucket-based many-to-many query.
+   An upward search from every target leaves (target,
+   distance) entries in a bucket at each vertex it settles.
+   An upward search from every origin then scans the bucket
+   of each vertex it settles, and the smallest sum found for
+   a target is the exact distance, because every shortest
+   path climbs to its highest vertex and descends from it.   */
+
+#ifndef CONTRACTIONHIERARCHY_HPP
+#define CONTRACTIONHIERARCHY_HPP
+
+#include "FrozenGraph.hpp"
+#include "PQueue.hpp"
+#include "SearchWorkspace.hpp"
+#include "ThreadPool.hpp"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <memory_resource>
+
+class ContractionHierarchy{
+public:
+    static constexpr unsigned int WITNESS_SETTLE_LIMIT = 500;  // Vertices settled per witness search before giving up and adding the shortcut
+    static constexpr unsigned int WITNESS_HOP_LIMIT = 3;       // Edges per witness path while estimating priorities. Contraction itself has no hop limit
+
+    ContractionHierarchy(); // Empty hierarchy. Populated by build()
+    ~ContractionHierarchy(); // Default destructor included to fulfill course requirements. Calls clear()
+    void build(const FrozenGraph& graph);   // Orders and contracts every vertex, then stores the upward graph
+    unsigned long shortestPath(const FrozenGraph& graph, const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path) const; // Same contract as FrozenGraph::shortestPath()
+    unsigned long distance(unsigned int start, unsigned int end) const; // Distance only, no unpacking. ULONG_MAX if end cannot be reached
+    std::vector<unsigned long> distanceMatrix(const FrozenGraph& graph, const std::vector<std::string>& originLabels, const std::vector<std::string>& targetLabels, ThreadPool& pool) const; // Same result as FrozenGraph::distanceMatrix()
+    unsigned int rank(unsigned int vertex) const;   // Position of vertex in the contraction order
+    std::size_t shortcutCount() const;  // Number of shortcuts added by build()
+    unsigned int vertexCount() const;   // Vertex count of the graph the hierarchy was built for
+    void clear();   // Releases all arrays
+
+    template<typename Visit>
+    void forEachUpward(unsigned int id, Visit visit) const{ // Calls visit(higher neighbor ID, weight, edge index) for each upward edge of id
+        for(std::size_t i = upOffsets[id]; i < upOffsets[id + 1]; ++i){
+            visit(upTargets[i], upWeights[i], i);
+        }
+    }
+
+protected:
+    struct OverlayEdge{     // Edge of the shrinking graph used during build()
+        unsigned int target;
+        unsigned long weight;
+        unsigned int middle;    // Bypassed vertex, or LabelTable::NO_ID for an original edge
+        unsigned int twin;      // Index of the same edge in the list of target
+    };
+
+    struct BucketEntry{     // Left at vertex by the upward search from one target of distanceMatrix()
+        unsigned int vertex;
+        unsigned int target;    // Column of the target in the matrix
+        unsigned long distance; // Upward distance from vertex to the target
+    };
+
+    unsigned long upwardSearch(unsigned int start, unsigned int end, SearchWorkspace& workspace, unsigned int& meet) const; // Bidirectional upward Dijkstra
+    void upwardSpace(unsigned int source, SearchWorkspace& workspace, std::vector<std::pair<unsigned int, unsigned long>>& space) const; // Every vertex settled by a full upward search from source, with its distance
+    void unpack(unsigned int from, std::size_t edge, std::pmr::vector<unsigned int>& path) const; // Appends the original vertices of one upward edge, walking away from from
+    unsigned int edgeSource(std::size_t edge) const;    // Lower ranked endpoint of an upward edge
+    std::size_t findUpward(unsigned int lower, unsigned int higher) const;  // Index of the upward edge lower-higher
+    int contract(std::vector<std::vector<OverlayEdge>>& overlay, unsigned int v, bool simulate); // Adds (or only counts) the shortcuts needed to remove v
+    void witnessSearch(const std::vector<std::vector<OverlayEdge>>& overlay, unsigned int source, unsigned int avoid, unsigned long limit, unsigned int hopLimit, unsigned int targets); // Local Dijkstra from source which avoids one vertex
+
+private:
+    friend class HubLabels; // Builds labels from upwardSpace() and unpacks their paths
+
+    unsigned int vertices = 0;  // Vertex count of the graph the hierarchy was built for
+    std::size_t edges = 0;      // Edge count of the graph the hierarchy was built for
+    std::size_t shortcuts = 0;  // Shortcuts among the upward edges
+    std::vector<unsigned int> ranks;        // (index/value) = (vertex ID/contraction order)
+    std::vector<std::size_t> upOffsets;     // vertices + 1 entries. Upward edges of v live in [upOffsets[v], upOffsets[v + 1])
+    std::vector<unsigned int> upTargets;    // Higher ranked endpoint of each upward edge
+    std::vector<unsigned long> upWeights;   // Weight of each upward edge
+    std::vector<unsigned int> upMiddles;    // Vertex bypassed by each upward edge, LabelTable::NO_ID for original edges
+
+    std::vector<unsigned long> witnessDistance; // build() only: tentative distances of the witness search
+    std::vector<unsigned int> witnessTouched;   // build() only: vertices whose witnessDistance must be reset
+    std::vector<unsigned int> witnessHops;      // build() only: edges on the tentative path to each touched vertex
+    std::vector<bool> witnessTarget;            // build() only: set for the vertices the current witness search must settle
+    std::vector<unsigned int> overlaySlot;      // build() only: index of each neighbor in the list of the vertex being joined, or NO_ID
+    PQueue witnessQueue;                        // build() only: queue of the witness search
+};
+
+#endif
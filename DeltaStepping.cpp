@@ -0,0 +1,290 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a parallel single-source
+   shortest path engine based on delta-stepping (Meyer and
+   Sanders). Instead of settling one vertex at a time, the
+   tentative distances are grouped into buckets of width
+   delta: bucket i holds the vertices whose distance lies in
+   [i * delta, (i + 1) * delta). Every vertex of the lowest
+   non-empty bucket is relaxed at once, by all workers of a
+   ThreadPool. Distances are lowered with an atomic
+   compare-and-swap (atomic min), so two workers relaxing
+   edges into the same vertex never lose an update.
+
+   Edges are split into light (weight <= delta) and heavy
+   (weight > delta). Light edges may put a vertex back into
+   the bucket being processed, so they are relaxed
+   repeatedly until that bucket stays empty. Heavy edges
+   can only reach later buckets, so they are relaxed once,
+   from every vertex the bucket settled. A small delta
+   behaves like Dijkstra's algorithm, and a large delta like
+   Bellman-Ford.
+
+   run() computes the full shortest path tree of a
+   FrozenGraph. Distances are exactly those of dijkstra().
+   Parents are derived after the search from tight edges
+   (dist(u) + w(u, v) == dist(v)), preferring the tight
+   neighbor with the smallest distance and then the
+   smallest ID, so the tree does not depend on thread
+   timing or thread count.                                   */
+
+#include "DeltaStepping.hpp"
+#include "LabelTable.hpp"
+#include "WeightTraits.hpp"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <climits>
+
+/* The pool is started once and reused by every run(). */
+DeltaStepping::DeltaStepping(unsigned int threadCount, unsigned long delta) : pool(new ThreadPool(threadCount)), delta(delta){
+    improved.resize(pool->size());
+}
+
+/* Redundant, but satisfies course requirement. */
+DeltaStepping::~DeltaStepping(){
+    clear();
+}
+
+/* The main loop keeps one list of vertex IDs per bucket. Only maxWeight / width + 2 buckets can be in use at once,
+   since every queued distance lies within one bucket plus one edge of the current bucket, so the lists are reused
+   cyclically. A vertex is queued at most once per bucket: queuedIn holds the bucket it waits in, and entries whose
+   vertex has since moved to a lower bucket are skipped when popped.
+       [a] Pop the current bucket into the frontier and relax its light edges. Repeat until nothing falls back in.
+       [b] Relax the heavy edges of every vertex the bucket settled.
+       [c] Move on to the next non-empty bucket.                                                                    */
+void DeltaStepping::run(const FrozenGraph& graph, const std::string& sourceLabel){
+    const unsigned int source = graph.vertexId(sourceLabel);    // Throws if the vertex does not exist
+    if(vertices != graph.vertexCount() || !tentative){
+        vertices = graph.vertexCount();
+        tentative.reset(new std::atomic<unsigned long>[vertices]);
+    }
+    for(unsigned int v = 0; v < vertices; ++v){
+        tentative[v].store(ULONG_MAX, std::memory_order_relaxed);
+    }
+    width = delta != 0 ? delta : chooseDelta(graph);
+
+    const unsigned long slots = graph.getMaxWeight() / width + 2;
+    std::vector<std::vector<unsigned int>> buckets(slots);
+    std::vector<unsigned long> queuedIn(vertices, ULONG_MAX);
+    std::size_t pending = 0;    // Entries in all buckets, stale ones included
+    const auto enqueue = [&](unsigned int vertex){
+        const unsigned long bucket = tentative[vertex].load(std::memory_order_relaxed) / width;
+        if(queuedIn[vertex] != bucket){
+            queuedIn[vertex] = bucket;
+            buckets[bucket % slots].push_back(vertex);
+            ++pending;
+        }
+    };
+    const auto collect = [&](){ // Queues every vertex the last relax() improved
+        for(auto it = improved.begin(); it != improved.end(); ++it){
+            for(auto vt = it->begin(); vt != it->end(); ++vt){
+                enqueue(*vt);
+            }
+            it->clear();
+        }
+    };
+
+    tentative[source].store(0, std::memory_order_relaxed);
+    enqueue(source);
+    unsigned long current = 0;
+    std::vector<unsigned int> frontier, settled;
+    while(pending > 0){
+        while(buckets[current % slots].empty()){    // [c]
+            ++current;
+        }
+        settled.clear();
+        while(!buckets[current % slots].empty()){   // [a]
+            frontier.clear();
+            frontier.swap(buckets[current % slots]);
+            pending -= frontier.size();
+            std::size_t kept = 0;
+            for(auto it = frontier.begin(); it != frontier.end(); ++it){
+                if(queuedIn[*it] == current){   // Stale entries have moved to a lower bucket
+                    queuedIn[*it] = ULONG_MAX;  // Lets a later improvement queue it here again
+                    frontier[kept++] = *it;
+                }
+            }
+            frontier.resize(kept);
+            settled.insert(settled.end(), frontier.begin(), frontier.end());
+            relax(graph, frontier, true);
+            collect();
+        }
+        std::sort(settled.begin(), settled.end());  // A vertex may have been popped more than once
+        settled.erase(std::unique(settled.begin(), settled.end()), settled.end());
+        relax(graph, settled, false);   // [b]
+        collect();
+        ++current;
+    }
+
+    distanceArray.resize(vertices);
+    for(unsigned int v = 0; v < vertices; ++v){
+        distanceArray[v] = tentative[v].load(std::memory_order_relaxed);
+    }
+    buildParents(graph, source);
+
+    return;
+}
+
+/* Read-only, so constant. */
+unsigned long DeltaStepping::distance(unsigned int vertex) const{
+    if(vertex >= distanceArray.size()){
+        throw std::out_of_range("[ERROR] Specified vertex ID is out of range. Unable to complete request.");
+    }
+
+    return distanceArray[vertex];
+}
+
+/* Read-only, so constant. */
+unsigned int DeltaStepping::parent(unsigned int vertex) const{
+    if(vertex >= parentArray.size()){
+        throw std::out_of_range("[ERROR] Specified vertex ID is out of range. Unable to complete request.");
+    }
+
+    return parentArray[vertex];
+}
+
+/* Read-only, so constant. */
+const std::vector<unsigned long>& DeltaStepping::distances() const{
+    return distanceArray;
+}
+
+/* Read-only, so constant. */
+const std::vector<unsigned int>& DeltaStepping::parents() const{
+    return parentArray;
+}
+
+/* Takes effect on the next run(). */
+void DeltaStepping::setDelta(unsigned long width){
+    delta = width;
+
+    return;
+}
+
+/* Reports the width actually used once run() has resolved an automatic delta. */
+unsigned long DeltaStepping::getDelta() const{
+    return width != 0 ? width : delta;
+}
+
+/* Read-only, so constant. */
+unsigned int DeltaStepping::threadCount() const{
+    return pool->size();
+}
+
+/* Releases every array. The pool keeps running. */
+void DeltaStepping::clear(){
+    tentative.reset();
+    for(auto it = improved.begin(); it != improved.end(); ++it){
+        it->clear();
+    }
+    distanceArray.clear();
+    parentArray.clear();
+    vertices = 0;
+    width = 0;
+
+    return;
+}
+
+/* The usual choice of Meyer and Sanders: with delta = maxWeight / degree, relaxing one bucket does about as much work
+   as settling one vertex of Dijkstra's algorithm would, while still offering a whole bucket of parallel work.      */
+unsigned long DeltaStepping::chooseDelta(const FrozenGraph& graph) const{
+    if(graph.vertexCount() == 0 || graph.edgeCount() == 0){
+        return 1;
+    }
+    const unsigned long degree = std::max<unsigned long>(1, graph.edgeCount() / graph.vertexCount());
+
+    return std::max<unsigned long>(1, graph.getMaxWeight() / degree);
+}
+
+/* Small frontiers are not worth waking the pool for, so they are relaxed on the calling thread as worker 0. */
+void DeltaStepping::relax(const FrozenGraph& graph, const std::vector<unsigned int>& frontier, bool light){
+    if(frontier.size() < PARALLEL_THRESHOLD){
+        for(auto it = frontier.begin(); it != frontier.end(); ++it){
+            relaxVertex(graph, *it, light, improved[0]);
+        }
+        return;
+    }
+    pool->parallelFor(frontier.size(), [&](std::size_t i, unsigned int worker){
+        relaxVertex(graph, frontier[i], light, improved[worker]);
+    });
+
+    return;
+}
+
+/* Atomic min: the compare-and-swap only succeeds if nobody lowered the distance since it was read, and on failure it
+   reloads the current value, so the loop ends as soon as the distance is no longer larger than the candidate.      */
+void DeltaStepping::relaxVertex(const FrozenGraph& graph, unsigned int vertex, bool light, std::vector<unsigned int>& improvedList){
+    const unsigned long vertexDistance = tentative[vertex].load(std::memory_order_relaxed);
+    graph.forEachNeighbor(vertex, [&](unsigned int next, unsigned long weight){
+        if((weight <= width) != light){
+            return;
+        }
+        const unsigned long testD = saturatingAdd(vertexDistance, weight);
+        unsigned long known = tentative[next].load(std::memory_order_relaxed);
+        while(testD < known){
+            if(tentative[next].compare_exchange_weak(known, testD, std::memory_order_relaxed)){
+                improvedList.push_back(next);
+                break;
+            }
+        }
+    });
+
+    return;
+}
+
+/* First, every vertex takes the tight neighbor with the smallest distance (then the smallest ID) whose distance is
+   strictly smaller, which can never form a cycle. Only zero-weight edges can leave a vertex without such a neighbor.
+   Those vertices are attached by a breadth-first search over zero-weight tight edges, starting from the vertices
+   which already have a parent, in ascending ID order.                                                               */
+void DeltaStepping::buildParents(const FrozenGraph& graph, unsigned int source){
+    parentArray.assign(vertices, LabelTable::NO_ID);
+    pool->parallelFor(vertices, [&](std::size_t v, unsigned int){
+        const unsigned long vertexDistance = distanceArray[v];
+        if(vertexDistance == ULONG_MAX || v == source){
+            return;
+        }
+        unsigned int best = LabelTable::NO_ID;
+        graph.forEachNeighbor(v, [&](unsigned int next, unsigned long weight){
+            const unsigned long nextDistance = distanceArray[next];
+            if(nextDistance < vertexDistance && saturatingAdd(nextDistance, weight) == vertexDistance){
+                if(best == LabelTable::NO_ID || nextDistance < distanceArray[best] || (nextDistance == distanceArray[best] && next < best)){
+                    best = next;
+                }
+            }
+        });
+        parentArray[v] = best;
+    });
+
+    const auto orphan = [&](unsigned int v){
+        return v != source && distanceArray[v] != ULONG_MAX && parentArray[v] == LabelTable::NO_ID;
+    };
+    std::deque<unsigned int> anchored;
+    for(unsigned int v = 0; v < vertices; ++v){
+        if(orphan(v)){
+            graph.forEachNeighbor(v, [&](unsigned int next, unsigned long weight){
+                if(weight == 0 && !orphan(next) && distanceArray[next] == distanceArray[v]){
+                    anchored.push_back(next);
+                }
+            });
+        }
+    }
+    while(!anchored.empty()){
+        const unsigned int curr = anchored.front();
+        anchored.pop_front();
+        graph.forEachNeighbor(curr, [&](unsigned int next, unsigned long weight){
+            if(weight == 0 && orphan(next)){
+                parentArray[next] = curr;
+                anchored.push_back(next);
+            }
+        });
+    }
+
+    return;
+}
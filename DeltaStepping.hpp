@@ -0,0 +1,78 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a parallel single-source
+   shortest path engine based on delta-stepping (Meyer and
+   Sanders). Instead of settling one vertex at a time, the
+   tentative distances are grouped into buckets of width
+   delta: bucket i holds the vertices whose distance lies in
+   [i * delta, (i + 1) * delta). Every vertex of the lowest
+   non-empty bucket is relaxed at once, by all workers of a
+   ThreadPool. Distances are lowered with an atomic
+   compare-and-swap (atomic min), so two workers relaxing
+   edges into the same vertex never lose an update.
+
+   Edges are split into light (weight <= delta) and heavy
+   (weight > delta). Light edges may put a vertex back into
+   the bucket being processed, so they are relaxed
+   repeatedly until that bucket stays empty. Heavy edges
+   can only reach later buckets, so they are relaxed once,
+   from every vertex the bucket settled. A small delta
+   behaves like Dijkstra's algorithm, and a large delta like
+   Bellman-Ford.
+
+   run() computes the full shortest path tree of a
+   FrozenGraph. Distances are exactly those of dijkstra().
+   Parents are derived after the search from tight edges
+   (dist(u) + w(u, v) == dist(v)), preferring the tight
+   neighbor with the smallest distance and then the
+   smallest ID, so the tree does not depend on thread
+   timing or thread count.                                   */
+
+#ifndef DELTASTEPPING_HPP
+#define DELTASTEPPING_HPP
+
+#include "FrozenGraph.hpp"
+#include "ThreadPool.hpp"
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+class DeltaStepping{
+public:
+    static constexpr std::size_t PARALLEL_THRESHOLD = 256;  // Smaller frontiers are relaxed on the calling thread
+
+    DeltaStepping(unsigned int threadCount = 0, unsigned long delta = 0);  // threadCount 0 means one per hardware thread, delta 0 picks one per graph
+    ~DeltaStepping(); // Default destructor included to fulfill course requirements. Calls clear()
+    void run(const FrozenGraph& graph, const std::string& sourceLabel);    // Full shortest path tree from source
+    unsigned long distance(unsigned int vertex) const;  // Distance from the source of the last run(), ULONG_MAX if unreachable
+    unsigned int parent(unsigned int vertex) const;     // Previous vertex on the path from the source, NO_ID for the source and unreachable vertices
+    const std::vector<unsigned long>& distances() const;    // (index/value) = (dense ID/distance)
+    const std::vector<unsigned int>& parents() const;       // (index/value) = (dense ID/previous vertex)
+    void setDelta(unsigned long width);     // Bucket width for the next run(). 0 picks one per graph
+    unsigned long getDelta() const;         // Bucket width used by the last run(), or as set
+    unsigned int threadCount() const;       // Number of workers
+    void clear();   // Releases all arrays
+
+protected:
+    unsigned long chooseDelta(const FrozenGraph& graph) const;  // Largest weight divided by average degree
+    void relax(const FrozenGraph& graph, const std::vector<unsigned int>& frontier, bool light);    // Relaxes the light or heavy edges of every frontier vertex
+    void relaxVertex(const FrozenGraph& graph, unsigned int vertex, bool light, std::vector<unsigned int>& improved);   // Same for one vertex
+    void buildParents(const FrozenGraph& graph, unsigned int source);   // Deterministic parents from tight edges
+
+private:
+    std::unique_ptr<ThreadPool> pool;
+    unsigned long delta = 0;        // As set by the caller, 0 for automatic
+    unsigned long width = 0;        // Bucket width of the current or last run()
+    unsigned int vertices = 0;      // Vertex count of the last run()
+    std::unique_ptr<std::atomic<unsigned long>[]> tentative;    // run() only: distances under concurrent relaxation
+    std::vector<std::vector<unsigned int>> improved;   // run() only: (index/value) = (worker/vertices it improved)
+    std::vector<unsigned long> distanceArray;   // Final distances
+    std::vector<unsigned int> parentArray;      // Final parents
+};
+
+#endif
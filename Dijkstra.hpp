@@ -0,0 +1,481 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file defines the search loop of Dijkstra's
+   algorithm once, as a template, so that every graph
+   representation (Graph, FrozenGraph) and every priority
+   queue (PQueue, RadixHeap, BucketQueue) shares it.
+
+   A graph representation only needs to provide
+   forEachNeighbor(id, visit), which calls visit(neighbor
+   ID, weight) once per neighbor. A priority queue only
+   needs push(), pop(), top() and empty(). Queues without
+   decrease-key may hold stale entries, which the loop
+   recognizes and skips.
+
+   Edge weights are integers, so a monotone integer queue
+   may replace the comparison heap. QueueKind selects the
+   queue explicitly, or automatically from the largest edge
+   weight: Dial's buckets when weights are small, a radix
+   heap otherwise.
+
+   Because every edge is undirected, the same loop can also
+   run from both ends at once. SearchMode::Bidirectional
+   alternates a forward search from the start-vertex and a
+   backward search from the end-vertex, and stops once the
+   two frontiers together cannot improve the best path
+   found where they meet.
+
+   astar() is the goal-directed variant of the same loop. A
+   potential function supplies a lower bound on the
+   remaining distance to the end-vertex, and vertices are
+   queued by (distance so far + lower bound), so that the
+   search is pulled toward the end-vertex instead of
+   growing a full ball around the start-vertex.
+
+   dijkstraToMany() is the one-to-many variant. It keeps
+   settling vertices until every one of a set of targets is
+   settled, so a single search answers a whole row of a
+   distance matrix.
+
+   dijkstraBounded() is the open-ended variant. It starts
+   from any number of sources at once and hands every
+   settled vertex to the caller, stopping at a distance cap
+   or whenever the caller has seen enough. Isochrones and
+   nearest-of-set queries are both built on it.
+
+   Every sum of a distance and a weight saturates at
+   ULONG_MAX (saturatingAdd()) rather than wrapping around.
+   Graphs whose neighbors sit in contiguous arrays provide
+   neighborSlice(id, targets, weights) as well, and
+   relaxNeighbors() then hands whole blocks of edges to the
+   vectorized RelaxKernel instead of visiting them one by
+   one.
+
+   The search state lives in a SearchLabels object, and the
+   overloads which pick a queue by QueueKind borrow both the
+   labels and the queue from a SearchWorkspace, so that a
+   caller running many queries allocates nothing per query.
+
+   Every loop reports to SearchStats::local() through
+   SEARCH_STATS(...) hooks, which vanish unless the build
+   defines SHORTESTPATH_STATS.                               */
+
+#ifndef DIJKSTRA_HPP
+#define DIJKSTRA_HPP
+
+#include "PQueue.hpp"
+#include "RadixHeap.hpp"
+#include "BucketQueue.hpp"
+#include "SearchLabels.hpp"
+#include "SearchWorkspace.hpp"
+#include "SearchStats.hpp"
+#include "RelaxKernel.hpp"
+#include "WeightTraits.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+#include <climits>
+
+enum class QueueKind{
+    Automatic,  // Buckets if the largest edge weight is at most DIAL_THRESHOLD, Radix otherwise
+    Heap,       // Indexed d-ary heap (PQueue) with decrease-key
+    Radix,      // Radix heap, amortized O(log C) per operation
+    Buckets     // Dial's buckets, O(1) per operation plus O(C) bucket scanning overall
+};
+
+enum class SearchMode{
+    Unidirectional, // Forward search from the start-vertex until the end-vertex is settled
+    Bidirectional   // Forward and backward searches which meet in the middle
+};
+
+constexpr unsigned long DIAL_THRESHOLD = 1024;  // Largest edge weight for which Automatic picks Buckets
+
+/* Turns Automatic into a concrete queue for the given largest edge weight. An explicit
+   Buckets request is downgraded to Radix if the weight is beyond what buckets support. */
+inline QueueKind resolveQueueKind(QueueKind kind, unsigned long maxWeight){
+    if(kind == QueueKind::Automatic){
+        return maxWeight <= DIAL_THRESHOLD ? QueueKind::Buckets : QueueKind::Radix;
+    }
+    if(kind == QueueKind::Buckets && maxWeight > BucketQueue::MAX_WEIGHT){
+        return QueueKind::Radix;
+    }
+
+    return kind;
+}
+
+template<typename Adjacency, typename = void>
+struct HasNeighborSlice : std::false_type{};    // True if Adjacency provides neighborSlice()
+
+template<typename Adjacency>
+struct HasNeighborSlice<Adjacency, std::void_t<decltype(&Adjacency::neighborSlice)>> : std::true_type{};
+
+/* Relaxes every edge out of curr, which was settled at currDistance, and calls improve(next, distance) for every
+   neighbor whose tentative distance in labels that edge lowers. improve() is expected to record the new distance.
+   Graphs with neighborSlice() are relaxed by RelaxKernel, CHUNK edges per call; the kernel only reads labels, so each
+   of its results is checked again in case an earlier improve() of the same chunk already did better (a neighbor
+   listed twice). Other graphs are relaxed one edge at a time through forEachNeighbor().                           */
+template<typename Adjacency, typename Improve>
+void relaxNeighbors(const Adjacency& graph, unsigned int curr, unsigned long currDistance, const SearchLabels& labels, Improve improve){
+    if constexpr(HasNeighborSlice<Adjacency>::value){
+        const unsigned int* targets;
+        const typename Adjacency::weight_type* weights;
+        const std::size_t count = graph.neighborSlice(curr, targets, weights);
+        SEARCH_STATS(SearchStats::local().relaxations += count);
+        unsigned int improvedIds[RelaxKernel::CHUNK];
+        unsigned long improvedDistances[RelaxKernel::CHUNK];
+        for(std::size_t first = 0; first < count; first += RelaxKernel::CHUNK){
+            const std::size_t improved = RelaxKernel::relax(currDistance, targets + first, weights + first, std::min(count - first, RelaxKernel::CHUNK), labels, improvedIds, improvedDistances);
+            for(std::size_t k = 0; k < improved; ++k){
+                if(improvedDistances[k] < labels.distance(improvedIds[k])){
+                    improve(improvedIds[k], improvedDistances[k]);
+                }
+            }
+        }
+    }
+    else{
+        graph.forEachNeighbor(curr, [&](unsigned int next, unsigned long weight){
+            SEARCH_STATS(++SearchStats::local().relaxations);
+            const unsigned long testD = saturatingAdd(currDistance, weight);
+            if(testD < labels.distance(next)){
+                improve(next, testD);
+            }
+        });
+    }
+
+    return;
+}
+
+/* Runs Dijkstra's algorithm from start until end is settled. labels must have been reset for every ID of graph. On
+   return, they hold the tentative distances and parents of every reached vertex, and the distance of end is returned
+   (ULONG_MAX if end cannot be reached).
+       [a] Starting from start, check which neighbor offers the shortest path back to start.
+       [b] If that path is less than the current shortest distance known, update what is known.
+       [c] Insert it in pQueue so that it can be sorted.
+       [d] Whichever path-back-to-start is shortest will then be processed next with top().
+       [e] Once we can confirm that top() == end, we can also confirm that we've found the shortest distance back to start */
+template<typename Adjacency, typename Queue>
+unsigned long dijkstra(const Adjacency& graph, Queue& pQueue, unsigned int start, unsigned int end, SearchLabels& labels){
+    SEARCH_STATS(SearchStats& stats = SearchStats::local());
+    labels.set(start, 0, LabelTable::NO_ID);
+    pQueue.push(Vertex(0, start));     // [a]/[d]
+    SEARCH_STATS(stats.notePush(pQueue));
+    while(!pQueue.empty()){     // Safe pQueue-state guard
+        const unsigned long currDistance = pQueue.top().get_distance();
+        const unsigned int curr = pQueue.top().get_id();
+        pQueue.pop();
+        SEARCH_STATS(++stats.pops);
+        if(currDistance != labels.distance(curr)){  // Stale entry left behind by a queue without decrease-key...
+            SEARCH_STATS(++stats.stale);
+            continue;                               // ...disregard, and process another node
+        }
+        SEARCH_STATS(++stats.settled);
+
+        if(curr == end){    // [e]
+            return currDistance;
+        }
+
+        relaxNeighbors(graph, curr, currDistance, labels, [&](unsigned int next, unsigned long testD){  // [b]
+            labels.set(next, testD, curr);
+            pQueue.push(Vertex(testD, next));  // [c] Decrease-key for PQueue, a new entry for the others
+            SEARCH_STATS(stats.notePush(pQueue));
+        });
+    }
+
+    return ULONG_MAX;
+}
+
+/* Same as above, but resets workspace.forward() for idCount IDs and borrows the queue selected by kind from workspace.
+   maxWeight must be at least the largest edge weight. The result is left in workspace.forward().                      */
+template<typename Adjacency>
+unsigned long dijkstra(const Adjacency& graph, unsigned int idCount, QueueKind kind, unsigned long maxWeight, unsigned int start, unsigned int end, SearchWorkspace& workspace){
+    SearchLabels& labels = workspace.forward();
+    SEARCH_STATS(SearchStats::PhaseTimer initTimer(SearchStats::Init));
+    labels.reset(idCount);
+    SEARCH_STATS(initTimer.stop());
+    SEARCH_STATS(SearchStats::PhaseTimer searchTimer(SearchStats::Search));
+    switch(resolveQueueKind(kind, maxWeight)){
+    case QueueKind::Buckets:
+        return dijkstra(graph, workspace.buckets(maxWeight), start, end, labels);
+    case QueueKind::Radix:
+        return dijkstra(graph, workspace.radix(), start, end, labels);
+    default:{
+        PQueue& pQueue = workspace.heap();
+        pQueue.reserve(idCount);    // Every ID is queued at most once
+        return dijkstra(graph, pQueue, start, end, labels);
+    }
+    }
+}
+
+/* Runs Dijkstra's algorithm from start until every vertex in targets is settled, or until the queue runs dry.
+   targets must be sorted and free of duplicates. Settled labels are final, so afterwards labels.distance(t) is the
+   exact distance of every target t, and ULONG_MAX for targets which cannot be reached. Returns the number of
+   targets which were reached.                                                                                       */
+template<typename Adjacency, typename Queue>
+std::size_t dijkstraToMany(const Adjacency& graph, Queue& pQueue, unsigned int start, const std::vector<unsigned int>& targets, SearchLabels& labels){
+    SEARCH_STATS(SearchStats& stats = SearchStats::local());
+    std::size_t reached = 0;
+    labels.set(start, 0, LabelTable::NO_ID);
+    pQueue.push(Vertex(0, start));
+    SEARCH_STATS(stats.notePush(pQueue));
+    while(!pQueue.empty() && reached < targets.size()){
+        const unsigned long currDistance = pQueue.top().get_distance();
+        const unsigned int curr = pQueue.top().get_id();
+        pQueue.pop();
+        SEARCH_STATS(++stats.pops);
+        if(currDistance != labels.distance(curr)){  // Stale entry left behind by a queue without decrease-key
+            SEARCH_STATS(++stats.stale);
+            continue;
+        }
+        SEARCH_STATS(++stats.settled);
+        if(std::binary_search(targets.begin(), targets.end(), curr)){
+            ++reached;
+        }
+
+        relaxNeighbors(graph, curr, currDistance, labels, [&](unsigned int next, unsigned long testD){
+            labels.set(next, testD, curr);
+            pQueue.push(Vertex(testD, next));
+            SEARCH_STATS(stats.notePush(pQueue));
+        });
+    }
+
+    return reached;
+}
+
+/* Same as above, but resets workspace.forward() for idCount IDs and borrows the queue selected by kind from workspace.
+   maxWeight must be at least the largest edge weight. The result is left in workspace.forward().                      */
+template<typename Adjacency>
+std::size_t dijkstraToMany(const Adjacency& graph, unsigned int idCount, QueueKind kind, unsigned long maxWeight, unsigned int start, const std::vector<unsigned int>& targets, SearchWorkspace& workspace){
+    SearchLabels& labels = workspace.forward();
+    SEARCH_STATS(SearchStats::PhaseTimer initTimer(SearchStats::Init));
+    labels.reset(idCount);
+    SEARCH_STATS(initTimer.stop());
+    SEARCH_STATS(SearchStats::PhaseTimer searchTimer(SearchStats::Search));
+    switch(resolveQueueKind(kind, maxWeight)){
+    case QueueKind::Buckets:
+        return dijkstraToMany(graph, workspace.buckets(maxWeight), start, targets, labels);
+    case QueueKind::Radix:
+        return dijkstraToMany(graph, workspace.radix(), start, targets, labels);
+    default:{
+        PQueue& pQueue = workspace.heap();
+        pQueue.reserve(idCount);
+        return dijkstraToMany(graph, pQueue, start, targets, labels);
+    }
+    }
+}
+
+/* Runs Dijkstra's algorithm from every vertex in sources at once, each starting at distance 0, so that the distance of
+   a vertex is its distance to the nearest source. Vertices are settled in order of distance, and settle(id, distance)
+   is called once for each of them. The search stops when settle() returns false, when the queue runs dry, or as soon
+   as the smallest queued distance exceeds radius; neighbors beyond radius are never queued. labels must have been
+   reset for every ID of graph. Returns the number of vertices settled.                                              */
+template<typename Adjacency, typename Queue, typename Settle>
+std::size_t dijkstraBounded(const Adjacency& graph, Queue& pQueue, const std::vector<unsigned int>& sources, unsigned long radius, SearchLabels& labels, Settle settle){
+    SEARCH_STATS(SearchStats& stats = SearchStats::local());
+    std::size_t settled = 0;
+    for(auto it = sources.begin(); it != sources.end(); ++it){
+        if(labels.distance(*it) != 0){  // A source listed twice is queued once
+            labels.set(*it, 0, LabelTable::NO_ID);
+            pQueue.push(Vertex(0, *it));
+            SEARCH_STATS(stats.notePush(pQueue));
+        }
+    }
+    while(!pQueue.empty() && pQueue.top().get_distance() <= radius){   // Stale entries never hide a smaller live key
+        const unsigned long currDistance = pQueue.top().get_distance();
+        const unsigned int curr = pQueue.top().get_id();
+        pQueue.pop();
+        SEARCH_STATS(++stats.pops);
+        if(currDistance != labels.distance(curr)){  // Stale entry left behind by a queue without decrease-key
+            SEARCH_STATS(++stats.stale);
+            continue;
+        }
+        SEARCH_STATS(++stats.settled);
+        ++settled;
+        if(!settle(curr, currDistance)){
+            break;
+        }
+
+        relaxNeighbors(graph, curr, currDistance, labels, [&](unsigned int next, unsigned long testD){
+            if(testD <= radius){
+                labels.set(next, testD, curr);
+                pQueue.push(Vertex(testD, next));
+                SEARCH_STATS(stats.notePush(pQueue));
+            }
+        });
+    }
+
+    return settled;
+}
+
+/* Same as above, but resets workspace.forward() for idCount IDs and borrows the queue selected by kind from workspace.
+   maxWeight must be at least the largest edge weight. Parents in workspace.forward() lead back to the nearest source. */
+template<typename Adjacency, typename Settle>
+std::size_t dijkstraBounded(const Adjacency& graph, unsigned int idCount, QueueKind kind, unsigned long maxWeight, const std::vector<unsigned int>& sources, unsigned long radius, SearchWorkspace& workspace, Settle settle){
+    SearchLabels& labels = workspace.forward();
+    SEARCH_STATS(SearchStats::PhaseTimer initTimer(SearchStats::Init));
+    labels.reset(idCount);
+    SEARCH_STATS(initTimer.stop());
+    SEARCH_STATS(SearchStats::PhaseTimer searchTimer(SearchStats::Search));
+    switch(resolveQueueKind(kind, maxWeight)){
+    case QueueKind::Buckets:
+        return dijkstraBounded(graph, workspace.buckets(maxWeight), sources, radius, labels, settle);
+    case QueueKind::Radix:
+        return dijkstraBounded(graph, workspace.radix(), sources, radius, labels, settle);
+    default:{
+        PQueue& pQueue = workspace.heap();
+        pQueue.reserve(idCount);
+        return dijkstraBounded(graph, pQueue, sources, radius, labels, settle);
+    }
+    }
+}
+
+/* Runs A* from start until end is settled. potential(id) must return a lower bound on the distance from id to end
+   which never drops by more than the weight of an edge between neighbors (a consistent lower bound), or ULONG_MAX if
+   id cannot reach end at all. Under that rule each vertex is settled once, just like in dijkstra(), and labels
+   follow the same rules. Vertices which cannot reach end are never queued. Because a queued key can exceed the
+   current key by up to twice the edge weight, a BucketQueue sized for maxWeight must not be used here.              */
+template<typename Adjacency, typename Queue, typename Potential>
+unsigned long astar(const Adjacency& graph, Queue& pQueue, unsigned int start, unsigned int end, SearchLabels& labels, Potential potential){
+    labels.set(start, 0, LabelTable::NO_ID);
+    const unsigned long startBound = potential(start);
+    if(startBound == ULONG_MAX){    // The lower bound already proves that end is unreachable
+        return ULONG_MAX;
+    }
+    SEARCH_STATS(SearchStats& stats = SearchStats::local());
+    pQueue.push(Vertex(startBound, start));
+    SEARCH_STATS(stats.notePush(pQueue));
+    while(!pQueue.empty()){
+        const unsigned long currKey = pQueue.top().get_distance();
+        const unsigned int curr = pQueue.top().get_id();
+        pQueue.pop();
+        SEARCH_STATS(++stats.pops);
+        const unsigned long currDistance = labels.distance(curr);
+        if(currKey != saturatingAdd(currDistance, potential(curr))){  // Stale entry left behind by a queue without decrease-key
+            SEARCH_STATS(++stats.stale);
+            continue;
+        }
+        SEARCH_STATS(++stats.settled);
+
+        if(curr == end){
+            return currDistance;
+        }
+
+        graph.forEachNeighbor(curr, [&](unsigned int next, unsigned long weight){
+            SEARCH_STATS(++stats.relaxations);
+            const unsigned long testD = saturatingAdd(currDistance, weight);
+            if(testD < labels.distance(next)){
+                const unsigned long bound = potential(next);
+                if(bound == ULONG_MAX){ // next cannot reach end, so it is not worth queueing
+                    return;
+                }
+                labels.set(next, testD, curr);
+                pQueue.push(Vertex(saturatingAdd(testD, bound), next));
+                SEARCH_STATS(stats.notePush(pQueue));
+            }
+        });
+    }
+
+    return ULONG_MAX;
+}
+
+/* Settles the next vertex of one side of a bidirectional search and relaxes its neighbors. Whenever a neighbor is
+   also reached by the other side, the path through that neighbor is a candidate for the best path.                 */
+template<typename Adjacency, typename Queue>
+void bidirectionalStep(const Adjacency& graph, Queue& pQueue, SearchLabels& thisSide, const SearchLabels& otherSide, unsigned long& best, unsigned int& meet){
+    SEARCH_STATS(SearchStats& stats = SearchStats::local());
+    const unsigned long currDistance = pQueue.top().get_distance();
+    const unsigned int curr = pQueue.top().get_id();
+    pQueue.pop();
+    SEARCH_STATS(++stats.pops);
+    if(currDistance != thisSide.distance(curr)){  // Stale entry left behind by a queue without decrease-key
+        SEARCH_STATS(++stats.stale);
+        return;
+    }
+    SEARCH_STATS(++stats.settled);
+
+    graph.forEachNeighbor(curr, [&](unsigned int next, unsigned long weight){
+        SEARCH_STATS(++stats.relaxations);
+        const unsigned long testD = saturatingAdd(currDistance, weight);
+        if(testD < thisSide.distance(next)){
+            thisSide.set(next, testD, curr);
+            pQueue.push(Vertex(testD, next));
+            SEARCH_STATS(stats.notePush(pQueue));
+        }
+        const unsigned long otherDistance = otherSide.distance(next);
+        const unsigned long through = saturatingAdd(thisSide.distance(next), otherDistance);   // ULONG_MAX unless both sides reached next
+        if(through < best){    // Frontiers touch at next
+            best = through;
+            meet = next;
+        }
+    });
+
+    return;
+}
+
+/* Runs Dijkstra's algorithm forward from start and backward from end, always advancing the side whose next key is
+   smaller. The best start-to-end distance seen so far is kept in best, along with the vertex where the two searches
+   met. Once the smallest keys of both queues add up to at least best, no unsettled vertex can lie on a shorter path,
+   so best is final. The forward path ends at meet in forwardLabels, and the backward path ends at meet in
+   backwardLabels. Both follow the same rules as in dijkstra(). Returns the distance (ULONG_MAX if end cannot be
+   reached), and sets meet to the vertex joining both halves of the path.                                            */
+template<typename Adjacency, typename Queue>
+unsigned long bidirectionalDijkstra(const Adjacency& graph, Queue& forwardQueue, Queue& backwardQueue, unsigned int start, unsigned int end, SearchLabels& forwardLabels, SearchLabels& backwardLabels, unsigned int& meet){
+    forwardLabels.set(start, 0, LabelTable::NO_ID);
+    backwardLabels.set(end, 0, LabelTable::NO_ID);
+    meet = start;
+    if(start == end){
+        return 0;
+    }
+
+    unsigned long best = ULONG_MAX;
+    forwardQueue.push(Vertex(0, start));
+    backwardQueue.push(Vertex(0, end));
+    SEARCH_STATS(SearchStats::local().notePush(forwardQueue));
+    SEARCH_STATS(SearchStats::local().notePush(backwardQueue));
+    while(!forwardQueue.empty() && !backwardQueue.empty()){    // If either side runs dry, every path through it was already seen
+        const unsigned long forwardTop = forwardQueue.top().get_distance();
+        const unsigned long backwardTop = backwardQueue.top().get_distance();
+        if(best != ULONG_MAX && saturatingAdd(forwardTop, backwardTop) >= best){  // Meet-in-the-middle stopping criterion
+            break;
+        }
+        if(forwardTop <= backwardTop){
+            bidirectionalStep(graph, forwardQueue, forwardLabels, backwardLabels, best, meet);
+        }
+        else{
+            bidirectionalStep(graph, backwardQueue, backwardLabels, forwardLabels, best, meet);
+        }
+    }
+
+    return best;
+}
+
+/* Same as above, but resets both label sets of workspace for idCount IDs and borrows the two queues selected by kind
+   from workspace. maxWeight must be at least the largest edge weight.                                               */
+template<typename Adjacency>
+unsigned long bidirectionalDijkstra(const Adjacency& graph, unsigned int idCount, QueueKind kind, unsigned long maxWeight, unsigned int start, unsigned int end, SearchWorkspace& workspace, unsigned int& meet){
+    SearchLabels& forwardLabels = workspace.forward();
+    SearchLabels& backwardLabels = workspace.backward();
+    SEARCH_STATS(SearchStats::PhaseTimer initTimer(SearchStats::Init));
+    forwardLabels.reset(idCount);
+    backwardLabels.reset(idCount);
+    SEARCH_STATS(initTimer.stop());
+    SEARCH_STATS(SearchStats::PhaseTimer searchTimer(SearchStats::Search));
+    switch(resolveQueueKind(kind, maxWeight)){
+    case QueueKind::Buckets:
+        return bidirectionalDijkstra(graph, workspace.buckets(maxWeight, false), workspace.buckets(maxWeight, true), start, end, forwardLabels, backwardLabels, meet);
+    case QueueKind::Radix:
+        return bidirectionalDijkstra(graph, workspace.radix(false), workspace.radix(true), start, end, forwardLabels, backwardLabels, meet);
+    default:{
+        PQueue& forwardQueue = workspace.heap(false);
+        PQueue& backwardQueue = workspace.heap(true);
+        forwardQueue.reserve(idCount);
+        backwardQueue.reserve(idCount);
+        return bidirectionalDijkstra(graph, forwardQueue, backwardQueue, start, end, forwardLabels, backwardLabels, meet);
+    }
+    }
+}
+
+#endif
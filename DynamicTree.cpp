@@ -0,0 +1,356 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a set of shortest path trees,
+   one per source vertex, which stay correct while the Graph
+   they were grown in keeps changing. The class subscribes
+   to the graph as a GraphObserver and repairs only the part
+   of each tree that a mutation actually affects, in the
+   style of Ramalingam and Reps.
+
+   Inserting edge u-v can only shorten distances. If
+   dist(u) + w < dist(v), v is hung below u, and a Dijkstra
+   search seeded with v alone pushes the improvement
+   outward. It stops where distances no longer drop, so its
+   work is bounded by the vertices that actually improved.
+
+   Deleting edge u-v matters only if it is a tree edge, say
+   with u the parent of v. Exactly the subtree below v lost
+   its distances. Those vertices are cut loose, each one
+   takes the best distance offered by a neighbor outside the
+   subtree, and a Dijkstra search seeded with them settles
+   the subtree again. Vertices outside it are never touched.
+
+   Each tree stores its children as intrusive linked lists
+   (first child, next and previous sibling), so a vertex is
+   moved to a new parent in O(1) and a subtree is listed in
+   time proportional to its size. settledCount() adds up the
+   vertices settled by every search so far, which is the
+   measure of how much work the repairs have cost.           */
+
+#include "DynamicTree.hpp"
+#include "WeightTraits.hpp"
+
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include <climits>
+#include <algorithm>
+
+/* The tree arrays are sized to every ID the graph has handed out so far. */
+DynamicTree::DynamicTree(Graph& graph) : graph(&graph), idCount(graph.adjacencyList.size()){
+    graph.subscribe(*this);
+}
+
+/* A destroyed graph has already detached this object, see onDetached(). */
+DynamicTree::~DynamicTree(){
+    if(graph != nullptr){
+        graph->unsubscribe(*this);
+    }
+}
+
+/* The initial tree is an ordinary full Dijkstra search seeded with the source alone. Every repair afterwards reuses
+   the very same settle() loop, only with different seeds.                                                          */
+void DynamicTree::addSource(const std::string& label){
+    if(graph == nullptr){
+        throw std::logic_error("[ERROR] Observed graph no longer exists. Unable to complete request.");
+    }
+    const unsigned int source = graph->labels.find(label);
+    if(source == LabelTable::NO_ID){
+        throw std::invalid_argument("[ERROR] Specified vertex does not exist. Unable to complete request.");
+    }
+    if(findTree(source) != nullptr){
+        throw std::logic_error("[ERROR] Specified vertex is already a maintained source. Unable to complete request.");
+    }
+
+    trees.push_back(Tree());
+    Tree& tree = trees.back();
+    tree.source = source;
+    resize(tree, idCount);
+    tree.distance[source] = 0;
+    queue.push(Vertex(0, source));
+    settle(tree);
+
+    return;
+}
+
+/* Frees the arrays of that one tree. */
+void DynamicTree::removeSource(const std::string& label){
+    const Tree* tree = findTree(label);
+    trees.erase(trees.begin() + (tree - trees.data()));
+
+    return;
+}
+
+/* Never throws, unlike findTree(). */
+bool DynamicTree::hasSource(const std::string& label) const{
+    if(graph == nullptr){
+        return false;
+    }
+    const unsigned int source = graph->labels.find(label);
+    for(auto it = trees.begin(); it != trees.end(); ++it){
+        if(source != LabelTable::NO_ID && it->source == source){
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Read-only, so constant. */
+unsigned int DynamicTree::sourceCount() const{
+    return trees.size();
+}
+
+/* A single array read, since the tree is always current. */
+unsigned long DynamicTree::distance(const std::string& sourceLabel, const std::string& targetLabel) const{
+    const Tree* tree = findTree(sourceLabel);
+    const unsigned int target = graph->labels.find(targetLabel);
+    if(target == LabelTable::NO_ID){
+        throw std::invalid_argument("[ERROR] One or more specified vertex does not exist. Unable to complete request.");
+    }
+
+    return tree->distance[target];
+}
+
+/* Walks the parents from the target back up to the source, then reverses the part of path appended by this call,
+   just like Graph::reconstruct().                                                                                  */
+unsigned long DynamicTree::shortestPath(const std::string& sourceLabel, const std::string& targetLabel, std::vector<std::string> &path) const{
+    const unsigned long result = distance(sourceLabel, targetLabel);
+    if(result == ULONG_MAX){
+        throw std::logic_error("[ERROR] No path exists between the start and end vertices");
+    }
+    const Tree* tree = findTree(sourceLabel);
+    const std::size_t first = path.size();
+    for(unsigned int curr = graph->labels.find(targetLabel); curr != tree->source; curr = tree->parent[curr]){
+        path.push_back(graph->labels.label(curr));
+    }
+    path.push_back(graph->labels.label(tree->source));
+    std::reverse(path.begin() + first, path.end());
+
+    return result;
+}
+
+/* Read-only, so constant. */
+unsigned long DynamicTree::settledCount() const{
+    return settled;
+}
+
+/* Abstracts the STL container clear() functions. */
+void DynamicTree::clear(){
+    trees.clear();
+
+    return;
+}
+
+/* A new ID extends every tree by one unreached slot. A reused ID was already left unreached when its vertex was
+   removed, since that vertex had lost all of its edges.                                                          */
+void DynamicTree::onVertexAdded(unsigned int vertex){
+    if(vertex >= idCount){
+        idCount = vertex + 1;
+        for(auto it = trees.begin(); it != trees.end(); ++it){
+            resize(*it, idCount);
+        }
+    }
+
+    return;
+}
+
+/* The edges of vertex were all reported before this call, so it is unreached in every remaining tree. */
+void DynamicTree::onVertexRemoved(unsigned int vertex){
+    for(auto it = trees.begin(); it != trees.end(); ++it){
+        if(it->source == vertex){
+            trees.erase(it);
+            break;
+        }
+    }
+
+    return;
+}
+
+/* Only one direction can improve, since the edge is undirected: if dist(u) + w < dist(v), then dist(v) + w > dist(u). */
+void DynamicTree::onEdgeAdded(unsigned int vertex1, unsigned int vertex2, unsigned long weight){
+    for(auto it = trees.begin(); it != trees.end(); ++it){
+        relax(*it, vertex1, vertex2, weight);
+        relax(*it, vertex2, vertex1, weight);
+        settle(*it);
+    }
+
+    return;
+}
+
+/* A deleted non-tree edge changes nothing, since no shortest path in the tree used it. Trees of a source being removed
+   by Graph::removeVertex() are skipped, as onVertexRemoved() drops them right after.                                  */
+void DynamicTree::onEdgeRemoved(unsigned int vertex1, unsigned int vertex2, unsigned long){
+    for(auto it = trees.begin(); it != trees.end(); ++it){
+        if(!graph->labels.live(it->source)){
+            continue;
+        }
+        if(it->parent[vertex2] == vertex1){
+            regrow(*it, vertex2);
+        }
+        else if(it->parent[vertex1] == vertex2){
+            regrow(*it, vertex1);
+        }
+    }
+
+    return;
+}
+
+/* IDs restart from 0, so the arrays are dropped along with the trees. */
+void DynamicTree::onCleared(){
+    trees.clear();
+    idCount = 0;
+
+    return;
+}
+
+/* Called from the graph's destructor. The graph must not be touched again, not even to unsubscribe. */
+void DynamicTree::onDetached(){
+    trees.clear();
+    idCount = 0;
+    graph = nullptr;
+
+    return;
+}
+
+/* Linear scan, since only a handful of sources are maintained. */
+DynamicTree::Tree* DynamicTree::findTree(unsigned int source){
+    for(auto it = trees.begin(); it != trees.end(); ++it){
+        if(it->source == source){
+            return &*it;
+        }
+    }
+
+    return nullptr;
+}
+
+/* Shared by the public queries, which take labels. */
+const DynamicTree::Tree* DynamicTree::findTree(const std::string& label) const{
+    if(graph == nullptr){
+        throw std::logic_error("[ERROR] Observed graph no longer exists. Unable to complete request.");
+    }
+    const unsigned int source = graph->labels.find(label);
+    if(source == LabelTable::NO_ID){
+        throw std::invalid_argument("[ERROR] One or more specified vertex does not exist. Unable to complete request.");
+    }
+    for(auto it = trees.begin(); it != trees.end(); ++it){
+        if(it->source == source){
+            return &*it;
+        }
+    }
+
+    throw std::invalid_argument("[ERROR] Specified vertex is not a maintained source. Unable to complete request.");
+}
+
+/* New slots are unreached and unlinked. */
+void DynamicTree::resize(Tree& tree, unsigned int count){
+    tree.distance.resize(count, ULONG_MAX);
+    tree.parent.resize(count, LabelTable::NO_ID);
+    tree.firstChild.resize(count, LabelTable::NO_ID);
+    tree.nextSibling.resize(count, LabelTable::NO_ID);
+    tree.prevSibling.resize(count, LabelTable::NO_ID);
+
+    return;
+}
+
+/* Pushes vertex onto the front of parent's child list. */
+void DynamicTree::attach(Tree& tree, unsigned int vertex, unsigned int parent){
+    tree.parent[vertex] = parent;
+    tree.prevSibling[vertex] = LabelTable::NO_ID;
+    tree.nextSibling[vertex] = tree.firstChild[parent];
+    if(tree.firstChild[parent] != LabelTable::NO_ID){
+        tree.prevSibling[tree.firstChild[parent]] = vertex;
+    }
+    tree.firstChild[parent] = vertex;
+
+    return;
+}
+
+/* Splices vertex out of its parent's child list. A vertex without a parent is left as is. */
+void DynamicTree::detach(Tree& tree, unsigned int vertex){
+    const unsigned int parent = tree.parent[vertex];
+    if(parent == LabelTable::NO_ID){
+        return;
+    }
+    const unsigned int prev = tree.prevSibling[vertex];
+    const unsigned int next = tree.nextSibling[vertex];
+    if(prev != LabelTable::NO_ID){
+        tree.nextSibling[prev] = next;
+    }
+    else{
+        tree.firstChild[parent] = next;
+    }
+    if(next != LabelTable::NO_ID){
+        tree.prevSibling[next] = prev;
+    }
+    tree.parent[vertex] = LabelTable::NO_ID;
+    tree.prevSibling[vertex] = LabelTable::NO_ID;
+    tree.nextSibling[vertex] = LabelTable::NO_ID;
+
+    return;
+}
+
+/* Same test as the relaxation step of dijkstra() (Dijkstra.hpp). An unreached from offers nothing. */
+void DynamicTree::relax(Tree& tree, unsigned int from, unsigned int to, unsigned long weight){
+    if(tree.distance[from] == ULONG_MAX){
+        return;
+    }
+    const unsigned long testD = saturatingAdd(tree.distance[from], weight);
+    if(testD < tree.distance[to]){
+        detach(tree, to);
+        tree.distance[to] = testD;
+        attach(tree, to, from);
+        queue.push(Vertex(testD, to));  // Decrease-key if to is already queued
+    }
+
+    return;
+}
+
+/* Plain Dijkstra's algorithm, except that the queue is seeded by the caller. Vertices that were not seeded and do not
+   improve are never queued, which is what confines a repair to the part of the tree it affects.                     */
+void DynamicTree::settle(Tree& tree){
+    while(!queue.empty()){
+        const unsigned int curr = queue.top().get_id();
+        queue.pop();
+        ++settled;
+        graph->forEachNeighbor(curr, [&](unsigned int next, unsigned long weight){
+            relax(tree, curr, next, weight);
+        });
+    }
+
+    return;
+}
+
+/* The subtree below root is listed breadth-first through the child lists and cut loose. Each of its vertices then
+   takes the best distance offered by its neighbors. Neighbors outside the subtree still hold correct distances,
+   since deleting an edge cannot shorten any path, and neighbors inside it are still unreached unless they were
+   already offered a distance, which is a real path length as well. settle() finishes the job from there.          */
+void DynamicTree::regrow(Tree& tree, unsigned int root){
+    detach(tree, root);
+    subtree.clear();
+    subtree.push_back(root);
+    for(std::size_t i = 0; i < subtree.size(); ++i){
+        for(unsigned int child = tree.firstChild[subtree[i]]; child != LabelTable::NO_ID; child = tree.nextSibling[child]){
+            subtree.push_back(child);
+        }
+    }
+    for(auto it = subtree.begin(); it != subtree.end(); ++it){
+        tree.distance[*it] = ULONG_MAX;
+        tree.parent[*it] = LabelTable::NO_ID;
+        tree.firstChild[*it] = LabelTable::NO_ID;
+        tree.nextSibling[*it] = LabelTable::NO_ID;
+        tree.prevSibling[*it] = LabelTable::NO_ID;
+    }
+
+    for(auto it = subtree.begin(); it != subtree.end(); ++it){
+        const unsigned int curr = *it;
+        graph->forEachNeighbor(curr, [&](unsigned int next, unsigned long weight){
+            relax(tree, next, curr, weight);
+        });
+    }
+    settle(tree);
+
+    return;
+}
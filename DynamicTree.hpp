@@ -0,0 +1,92 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a set of shortest path trees,
+   one per source vertex, which stay correct while the Graph
+   they were grown in keeps changing. The class subscribes
+   to the graph as a GraphObserver and repairs only the part
+   of each tree that a mutation actually affects, in the
+   style of Ramalingam and Reps.
+
+   Inserting edge u-v can only shorten distances. If
+   dist(u) + w < dist(v), v is hung below u, and a Dijkstra
+   search seeded with v alone pushes the improvement
+   outward. It stops where distances no longer drop, so its
+   work is bounded by the vertices that actually improved.
+
+   Deleting edge u-v matters only if it is a tree edge, say
+   with u the parent of v. Exactly the subtree below v lost
+   its distances. Those vertices are cut loose, each one
+   takes the best distance offered by a neighbor outside the
+   subtree, and a Dijkstra search seeded with them settles
+   the subtree again. Vertices outside it are never touched.
+
+   Each tree stores its children as intrusive linked lists
+   (first child, next and previous sibling), so a vertex is
+   moved to a new parent in O(1) and a subtree is listed in
+   time proportional to its size. settledCount() adds up the
+   vertices settled by every search so far, which is the
+   measure of how much work the repairs have cost.           */
+
+#ifndef DYNAMICTREE_HPP
+#define DYNAMICTREE_HPP
+
+#include "Graph.hpp"
+#include "GraphObserver.hpp"
+#include "PQueue.hpp"
+
+#include <string>
+#include <vector>
+
+class DynamicTree : public GraphObserver{
+public:
+    DynamicTree(Graph& graph);  // Subscribes to graph. No trees until addSource()
+    DynamicTree(const DynamicTree&) = delete;   // graph holds the address of this object
+    DynamicTree& operator=(const DynamicTree&) = delete;
+    ~DynamicTree(); // Unsubscribes from the graph, unless it was destroyed first
+    void addSource(const std::string& label);   // Grows a full shortest path tree from label
+    void removeSource(const std::string& label);    // Drops the tree of label
+    bool hasSource(const std::string& label) const; // True if label is a maintained source
+    unsigned int sourceCount() const;   // Number of maintained trees
+    unsigned long distance(const std::string& sourceLabel, const std::string& targetLabel) const; // ULONG_MAX if target cannot be reached
+    unsigned long shortestPath(const std::string& sourceLabel, const std::string& targetLabel, std::vector<std::string> &path) const; // Same contract as Graph::shortestPath(), without a search
+    unsigned long settledCount() const; // Vertices settled by addSource() and every repair so far
+    void clear();   // Drops every tree. Stays subscribed
+
+    void onVertexAdded(unsigned int vertex) override;
+    void onVertexRemoved(unsigned int vertex) override;     // Drops the tree of vertex, if it was a source
+    void onEdgeAdded(unsigned int vertex1, unsigned int vertex2, unsigned long weight) override;    // Pushes any improvement outward
+    void onEdgeRemoved(unsigned int vertex1, unsigned int vertex2, unsigned long weight) override;  // Regrows the subtree hanging from a lost tree edge
+    void onCleared() override;      // Drops every tree, since every source is gone
+    void onDetached() override;     // Drops every tree and forgets the graph
+
+protected:
+    struct Tree{
+        unsigned int source;
+        std::vector<unsigned long> distance;    // (index/value) = (Graph ID/distance from source), ULONG_MAX if unreached
+        std::vector<unsigned int> parent;       // Predecessor on the path from source, LabelTable::NO_ID if none
+        std::vector<unsigned int> firstChild;   // Head of the child list, LabelTable::NO_ID if a leaf
+        std::vector<unsigned int> nextSibling;  // Child lists are doubly linked, so that detach() is O(1)
+        std::vector<unsigned int> prevSibling;
+    };
+
+    Tree* findTree(unsigned int source);    // nullptr if source is not maintained
+    const Tree* findTree(const std::string& label) const;   // Throws if label is unknown or not a maintained source
+    void resize(Tree& tree, unsigned int count);    // Grows every array of tree to count IDs
+    void attach(Tree& tree, unsigned int vertex, unsigned int parent);  // Hangs vertex below parent
+    void detach(Tree& tree, unsigned int vertex);   // Unhooks vertex from its parent. Its own children stay
+    void relax(Tree& tree, unsigned int from, unsigned int to, unsigned long weight);   // Reparents to below from if that is shorter, and queues it
+    void settle(Tree& tree);    // Dijkstra's algorithm from every queued vertex until the queue is empty
+    void regrow(Tree& tree, unsigned int root); // Recomputes the subtree below root, which lost its tree edge
+
+private:
+    Graph* graph;   // nullptr once the graph is destroyed
+    std::vector<Tree> trees;
+    unsigned int idCount = 0;   // Every tree array spans this many Graph IDs
+    PQueue queue;               // Shared by every search, empty between calls
+    std::vector<unsigned int> subtree;  // regrow() only: vertices of the subtree being regrown
+    unsigned long settled = 0;
+};
+
+#endif
@@ -12,18 +12,69 @@
    well as the distance between the source-vertex and a
    destination-vertex. For example: map A = {(B, 5), (C, 7)}
    implies that source-vertex A has neighbors B and C, whose
-   edges are a length of 5units and 7units respectively.      */
+   edges are a length of 5units and 7units respectively.
+
+   Destination-vertices are stored by the 32-bit ID that
+   class LabelTable assigned to their label, not by the
+   label itself. Only class Graph translates between the
+   two.
+
+   The map draws its nodes from a polymorphic memory
+   resource (std::pmr). Edge is allocator-aware, so a
+   std::pmr::vector<Edge> hands its own resource to every
+   Edge it constructs. This is how class Graph keeps every
+   neighbor map of a graph inside that graph's arena.        */
 
 #include "Edge.hpp"
 
 #include <map>
-#include <string>
+#include <memory_resource>
+#include <utility>
 
 /* Defined solely for course requirement. */
 Edge::Edge(){
     // No logical implementation required
 }
 
+/* Used by std::pmr containers of Edge, which pass their own allocator. */
+Edge::Edge(const allocator_type& allocator) : neighbors(allocator){
+    // No logical implementation required
+}
+
+/* A plain copy does not inherit other's resource, as for any std::pmr container. */
+Edge::Edge(const Edge& other) : neighbors(other.neighbors.begin(), other.neighbors.end()){
+    // No logical implementation required
+}
+
+/* Copy placed in the caller's resource. */
+Edge::Edge(const Edge& other, const allocator_type& allocator) : neighbors(other.neighbors, allocator){
+    // No logical implementation required
+}
+
+/* Declared noexcept so that std::vector moves, rather than copies, when it grows. */
+Edge::Edge(Edge&& other) noexcept : neighbors(std::move(other.neighbors)){
+    // No logical implementation required
+}
+
+/* std::pmr::map only steals the nodes when both resources are equal. */
+Edge::Edge(Edge&& other, const allocator_type& allocator) : neighbors(std::move(other.neighbors), allocator){
+    // No logical implementation required
+}
+
+/* Assignment never changes resources, so the nodes are copied into this object's resource. */
+Edge& Edge::operator=(const Edge& other){
+    neighbors = other.neighbors;
+
+    return *this;
+}
+
+/* Same as above, but steals the nodes when both resources are equal. */
+Edge& Edge::operator=(Edge&& other){
+    neighbors = std::move(other.neighbors);
+
+    return *this;
+}
+
 /* Redundant, but satisfies course requirement.
    Abstracts the STL map and its clear() function. */
 Edge::~Edge(){
@@ -32,17 +83,22 @@ Edge::~Edge(){
 
 /* Because STL map.insert() prevents the entry of elements with
    duplicate keys, this function safely ignores duplicate keys.  */
-void Edge::insert(const std::string& vertex, unsigned long distance){
+void Edge::insert(unsigned int vertex, unsigned long distance){
     neighbors.insert({vertex, distance});
     return;
 }
 
 /* Allows caller to specify a source-vertex and retrieve all of its
    neighbor/distance pairs. Returns an Edge object reference.       */
-const std::map<std::string, unsigned long>& Edge::get_neighbors() const{
+const std::pmr::map<unsigned int, unsigned long>& Edge::get_neighbors() const{
     return neighbors;
 }
 
+/* Read-only, so constant. */
+Edge::allocator_type Edge::get_allocator() const{
+    return neighbors.get_allocator();
+}
+
 /* Although STL map.size() may exceed int-range, main() will
    restrict the number of neighbors to stay within int bounds.        */
 int Edge::get_size() const{
@@ -51,7 +107,7 @@ int Edge::get_size() const{
 
 /* Uses STL map.erase() to remove a target neighbor/distance pair
    once the caller identifies it.                                     */
-void Edge::remove_neighbor(const std::string& target){
+void Edge::remove_neighbor(unsigned int target){
     neighbors.erase(target);
 }
 
@@ -12,26 +12,48 @@
    well as the distance between the source-vertex and a
    destination-vertex. For example: map A = {(B, 5), (C, 7)}
    implies that source-vertex A has neighbors B and C, whose
-   edges are a length of 5units and 7units respectively.      */
+   edges are a length of 5units and 7units respectively.
+
+   Destination-vertices are stored by the 32-bit ID that
+   class LabelTable assigned to their label, not by the
+   label itself. Only class Graph translates between the
+   two.
+
+   The map draws its nodes from a polymorphic memory
+   resource (std::pmr). Edge is allocator-aware, so a
+   std::pmr::vector<Edge> hands its own resource to every
+   Edge it constructs. This is how class Graph keeps every
+   neighbor map of a graph inside that graph's arena.        */
 
 #ifndef EDGE_HPP
 #define EDGE_HPP
 
 #include <map>
-#include <string>
+#include <memory_resource>
+#include <utility>
 
 class Edge{
 public:
-    Edge();   // Default constructor included to fulfill course requirements
+    using allocator_type = std::pmr::polymorphic_allocator<std::pair<const unsigned int, unsigned long>>;  // Makes std::pmr containers pass their resource on
+
+    Edge();   // Default constructor included to fulfill course requirements. Uses the default memory resource
+    explicit Edge(const allocator_type& allocator); // Empty map whose nodes come from allocator's resource
+    Edge(const Edge& other);    // Copies the neighbors into the default memory resource
+    Edge(const Edge& other, const allocator_type& allocator);
+    Edge(Edge&& other) noexcept;    // Takes over other's nodes and resource
+    Edge(Edge&& other, const allocator_type& allocator);    // Takes over other's nodes if the resources match, copies them otherwise
+    Edge& operator=(const Edge& other);     // Keeps this object's resource
+    Edge& operator=(Edge&& other);          // Same as above
     ~Edge();  // Default destructor included to fulfill course requirements. Calls clear()
-    void insert(const std::string& vertex, unsigned long distance);       // Adds one neighbor/distance pair at a time
-    const std::map<std::string, unsigned long>& get_neighbors() const;    // Returns address of a specific vertex's neighbors (Edge object reference)
+    void insert(unsigned int vertex, unsigned long distance);             // Adds one neighbor/distance pair at a time
+    const std::pmr::map<unsigned int, unsigned long>& get_neighbors() const;  // Returns address of a specific vertex's neighbors (Edge object reference)
+    allocator_type get_allocator() const;   // Allocator of the neighbor map
     int get_size() const;   // Returns the number of neighbors
-    void remove_neighbor(const std::string& target);    // Called by wrapper class Graph
+    void remove_neighbor(unsigned int target);  // Called by wrapper class Graph
     void clear();   // Clears map of all elements (neighbors)
 
 private:
-    std::map<std::string, unsigned long> neighbors;    // (key/value) = (neighbor vertex/distance from source)
+    std::pmr::map<unsigned int, unsigned long> neighbors;  // (key/value) = (neighbor vertex ID/distance from source)
 };
 
 
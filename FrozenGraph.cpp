@@ -0,0 +1,572 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a read-only snapshot of class
+   Graph. Where Graph stores a map of (source-vertex, Edge)
+   pairs, FrozenGraph assigns every vertex a dense integer ID
+   and stores the adjacency list in compressed-sparse-row
+   (CSR) form: three contiguous arrays of offsets, targets
+   and weights.
+
+   The neighbors of vertex u are found at indices
+   [offsets[u], offsets[u + 1]) of both targets and weights.
+   For example: offsets = {0, 2, 3}, targets = {1, 2, 0}
+   implies that vertex 0 has neighbors 1 and 2, and vertex 1
+   has neighbor 0.
+
+   A FrozenGraph is built once with Graph::freeze() and is
+   never mutated afterwards. Because relaxation in
+   shortestPath() walks plain arrays instead of red-black
+   tree nodes keyed by strings, query workloads which never
+   change the graph should prefer this class. The
+   shortestPath() contract is identical to that of Graph.
+
+   Because a snapshot never changes, any number of threads
+   may query it at once. shortestPathBatch() runs a whole
+   list of queries on a ThreadPool, each worker reusing its
+   own SearchWorkspace, and reports failures per query
+   instead of throwing.
+
+   distancesToMany() answers one origin against many targets
+   with a single search, and distanceMatrix() runs one such
+   search per origin on a ThreadPool. Both report
+   unreachable targets as ULONG_MAX instead of throwing.
+
+   withinRadius() lists every vertex within a distance of
+   one or more origins (an isochrone), and nearestOf()
+   lists the few targets closest to any of the origins.
+   Both stop searching as soon as their answer is known and
+   return (vertex ID, distance) pairs in order of distance;
+   an empty list, not an exception, means nothing matched.
+
+   reorder() renumbers the vertices so that neighbors get
+   nearby IDs, which keeps the labels and CSR slices that a
+   search touches together in cache: breadth-first order,
+   Reverse Cuthill-McKee order, or the order of a Hilbert
+   curve through the vertex coordinates. Labels follow their
+   vertices, so callers that only use labels never notice.
+
+   The class is a template on the type of the stored edge
+   weights, BasicFrozenGraph<Weight>, for the weight types
+   of WeightTraits.hpp. FrozenGraph, as built by
+   Graph::freeze(), stores unsigned long weights; a
+   BasicFrozenGraph<unsigned int> converted from it needs 8
+   bytes per edge instead of 12. Distances are unsigned long
+   either way, and neighborSlice() lets the searches relax
+   both with RelaxKernel.                                    */
+
+#include "FrozenGraph.hpp"
+#include "SearchStats.hpp"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <exception>
+#include <stdexcept>
+#include <climits>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+
+namespace{
+    const unsigned int PERIPHERAL_ROUNDS = 8;   // BFS sweeps allowed while looking for a peripheral vertex
+    const std::uint32_t HILBERT_SIDE = 1u << 16;    // Coordinates are scaled onto a HILBERT_SIDE x HILBERT_SIDE grid
+
+    /* Position of cell (x, y) along the Hilbert curve filling the grid. Each step picks the quadrant of the current
+       square, adds the cells of the quadrants before it, and rotates (x, y) into that quadrant's orientation.    */
+    std::uint64_t hilbertIndex(std::uint32_t x, std::uint32_t y){
+        std::uint64_t index = 0;
+        for(std::uint32_t side = HILBERT_SIDE / 2; side > 0; side /= 2){
+            const std::uint32_t rx = (x & side) ? 1 : 0;
+            const std::uint32_t ry = (y & side) ? 1 : 0;
+            index += static_cast<std::uint64_t>(side) * side * ((3 * rx) ^ ry);
+            if(ry == 0){
+                if(rx == 1){
+                    x = HILBERT_SIDE - 1 - x;
+                    y = HILBERT_SIDE - 1 - y;
+                }
+                std::swap(x, y);
+            }
+        }
+
+        return index;
+    }
+}
+
+/* Builds an empty snapshot. Graph::freeze() fills it. */
+template<typename Weight>
+BasicFrozenGraph<Weight>::BasicFrozenGraph(){
+    // No logical implementation required
+}
+
+/* Copies every array but the weights, which are converted one by one once they are known to fit. */
+template<typename Weight>
+template<typename Other>
+BasicFrozenGraph<Weight>::BasicFrozenGraph(const BasicFrozenGraph<Other>& other)
+    : labels(other.labels), offsets(other.offsets), targets(other.targets), queueKind(other.queueKind), searchMode(other.searchMode), maxWeight(other.maxWeight){
+    if(other.maxWeight > WeightTraits<Weight>::MAX_WEIGHT){
+        throw std::out_of_range(std::string("[ERROR] Edge weights do not fit in ") + WeightTraits<Weight>::NAME + ". Unable to complete request.");
+    }
+    weights.assign(other.weights.begin(), other.weights.end());
+}
+
+/* Redundant, but satisfies course requirement. */
+template<typename Weight>
+BasicFrozenGraph<Weight>::~BasicFrozenGraph(){
+    clear();
+}
+
+/* Dijkstra's algorithm, following the same steps as Graph::shortestPath(). The difference is that neighbors are read
+   from one contiguous slice of the CSR arrays (see forEachNeighbor()). Labels are only translated at the beginning
+   (start/end) and at the end (reconstruct) of the query.                                                            */
+template<typename Weight>
+unsigned long BasicFrozenGraph<Weight>::shortestPath(const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path) const{
+    SEARCH_STATS(SearchStats::QueryScope statsQuery("frozen"));
+    // Ensure that the snapshot contains the correct vertices to process
+    const unsigned int start = labels.find(startLabel);
+    const unsigned int end = labels.find(endLabel);
+    if(start == LabelTable::NO_ID || end == LabelTable::NO_ID){
+        throw std::invalid_argument("[ERROR] One or more specified vertex does not exist. Unable to complete request.");
+    }
+
+    SearchWorkspace& workspace = SearchWorkspace::local();  // Per-thread, so concurrent queries on one snapshot never share state
+    unsigned int meet = end;                    // Vertex where the forward path ends and the backward path begins
+    unsigned long distance;
+    if(searchMode == SearchMode::Bidirectional){
+        distance = bidirectionalDijkstra(*this, vertexCount(), queueKind, maxWeight, start, end, workspace, meet);
+    }
+    else{
+        distance = dijkstra(*this, vertexCount(), queueKind, maxWeight, start, end, workspace);
+    }
+    if(distance == ULONG_MAX){
+        throw std::logic_error("[ERROR] No path exists between the start and end vertices");  // Throw if no path is found
+    }
+    SEARCH_STATS(SearchStats::PhaseTimer reconstructTimer(SearchStats::Reconstruct));
+    reconstruct(path, workspace.forward(), start, meet);
+    if(meet != end){    // The backward half is emitted from end to meet, so it is appended in reverse
+        std::vector<std::string> backwardPath;
+        reconstruct(backwardPath, workspace.backward(), end, meet);
+        path.insert(path.end(), backwardPath.rbegin() + 1, backwardPath.rend());
+    }
+
+    return distance;
+}
+
+/* Each query runs shortestPath() on whichever worker picks it up. shortestPath() borrows SearchWorkspace::local(), so
+   every worker reuses one workspace for all of its queries and no two queries share state. Every result slot is
+   written by exactly one worker, so the results need no locking. A query that throws (unknown label, no path) only
+   marks its own result.                                                                                             */
+template<typename Weight>
+std::vector<QueryResult> BasicFrozenGraph<Weight>::shortestPathBatch(const std::vector<std::pair<std::string, std::string>>& queries, ThreadPool& pool) const{
+    std::vector<QueryResult> results(queries.size());
+    pool.parallelFor(queries.size(), [&](std::size_t i, unsigned int){
+        QueryResult& result = results[i];
+        try{
+            result.distance = shortestPath(queries[i].first, queries[i].second, result.path);
+        }
+        catch(const std::exception& e){
+            result.distance = ULONG_MAX;
+            result.path.clear();
+            result.error = e.what();
+        }
+    });
+
+    return results;
+}
+
+/* Labels are translated up front, so an unknown label throws before any search runs. Unreachable targets are not an
+   error here, they are reported as ULONG_MAX.                                                                        */
+template<typename Weight>
+std::vector<unsigned long> BasicFrozenGraph<Weight>::distancesToMany(const std::string& originLabel, const std::vector<std::string>& targetLabels) const{
+    const unsigned int origin = vertexId(originLabel);  // Throws if any vertex does not exist
+    const std::vector<unsigned int> targets = vertexIds(targetLabels);
+    std::vector<unsigned int> sortedTargets(targets);
+    std::sort(sortedTargets.begin(), sortedTargets.end());
+    sortedTargets.erase(std::unique(sortedTargets.begin(), sortedTargets.end()), sortedTargets.end());
+
+    std::vector<unsigned long> row(targets.size());
+    distanceRow(origin, targets, sortedTargets, row.data());
+
+    return row;
+}
+
+/* A multi-source search capped at radius. Every settled vertex is within radius, so each one is simply recorded. */
+template<typename Weight>
+std::vector<ReachedVertex> BasicFrozenGraph<Weight>::withinRadius(const std::vector<std::string>& originLabels, unsigned long radius) const{
+    SEARCH_STATS(SearchStats::QueryScope statsQuery("radius"));
+    const std::vector<unsigned int> origins = vertexIds(originLabels);  // Throws if any vertex does not exist
+    std::vector<ReachedVertex> reached;
+    dijkstraBounded(*this, vertexCount(), queueKind, maxWeight, origins, radius, SearchWorkspace::local(), [&](unsigned int id, unsigned long distance){
+        reached.push_back({id, distance});
+        return true;
+    });
+
+    return reached;
+}
+
+/* Same search as withinRadius(), but only targets are recorded, and the search stops at the count-th one. Targets
+   are settled in order of distance, so the first count settled are the nearest. Duplicate targets count once.    */
+template<typename Weight>
+std::vector<ReachedVertex> BasicFrozenGraph<Weight>::nearestOf(const std::vector<std::string>& originLabels, const std::vector<std::string>& targetLabels, std::size_t count, unsigned long radius) const{
+    SEARCH_STATS(SearchStats::QueryScope statsQuery("nearest"));
+    const std::vector<unsigned int> origins = vertexIds(originLabels);  // Throws if any vertex does not exist
+    std::vector<unsigned int> sortedTargets = vertexIds(targetLabels);
+    std::sort(sortedTargets.begin(), sortedTargets.end());
+    sortedTargets.erase(std::unique(sortedTargets.begin(), sortedTargets.end()), sortedTargets.end());
+
+    std::vector<ReachedVertex> nearest;
+    if(count == 0 || sortedTargets.empty()){
+        return nearest;
+    }
+    dijkstraBounded(*this, vertexCount(), queueKind, maxWeight, origins, radius, SearchWorkspace::local(), [&](unsigned int id, unsigned long distance){
+        if(std::binary_search(sortedTargets.begin(), sortedTargets.end(), id)){
+            nearest.push_back({id, distance});
+        }
+        return nearest.size() < count;
+    });
+
+    return nearest;
+}
+
+/* One distanceRow() per origin, spread over pool. Every row is written by exactly one worker into its own slice of
+   the matrix, and each worker reuses its own SearchWorkspace, so rows need no locking. The sorted target list is
+   shared read-only by every row.                                                                                   */
+template<typename Weight>
+std::vector<unsigned long> BasicFrozenGraph<Weight>::distanceMatrix(const std::vector<std::string>& originLabels, const std::vector<std::string>& targetLabels, ThreadPool& pool) const{
+    const std::vector<unsigned int> origins = vertexIds(originLabels);  // Throws if any vertex does not exist
+    const std::vector<unsigned int> targets = vertexIds(targetLabels);
+    std::vector<unsigned int> sortedTargets(targets);
+    std::sort(sortedTargets.begin(), sortedTargets.end());
+    sortedTargets.erase(std::unique(sortedTargets.begin(), sortedTargets.end()), sortedTargets.end());
+
+    std::vector<unsigned long> matrix(origins.size() * targets.size());
+    pool.parallelFor(origins.size(), [&](std::size_t i, unsigned int){
+        distanceRow(origins[i], targets, sortedTargets, matrix.data() + i * targets.size());
+    });
+
+    return matrix;
+}
+
+/* Computes the new sequence of vertices and hands it to the overload below. */
+template<typename Weight>
+std::vector<unsigned int> BasicFrozenGraph<Weight>::reorder(VertexOrder order, const std::vector<Coordinate>& coordinates){
+    const unsigned int n = vertexCount();
+    std::vector<unsigned int> sequence;     // (index/value) = (new ID/old ID)
+    switch(order){
+    case VertexOrder::Bfs:
+        sequence = breadthFirstOrder(false);
+        break;
+    case VertexOrder::ReverseCuthillMcKee:
+        sequence = breadthFirstOrder(true);
+        break;
+    case VertexOrder::Hilbert:
+        sequence = hilbertOrder(coordinates);   // Throws if coordinates do not fit
+        break;
+    default:
+        sequence.resize(n);
+        std::iota(sequence.begin(), sequence.end(), 0);
+    }
+
+    return reorder(sequence);
+}
+
+/* Rebuilds the label table and the CSR arrays in the order of sequence. Labels are interned in new ID order, so each
+   label keeps its vertex and only the dense IDs change. Every slice is sorted by new target ID again, as
+   Graph::freeze() leaves it. Queue kind, search mode and maxWeight are unaffected.                                 */
+template<typename Weight>
+std::vector<unsigned int> BasicFrozenGraph<Weight>::reorder(const std::vector<unsigned int>& sequence){
+    const unsigned int n = vertexCount();
+    if(sequence.size() != n){
+        throw std::invalid_argument("[ERROR] Vertex sequence must list every vertex once. Unable to complete request.");
+    }
+    std::vector<unsigned int> newId(n, LabelTable::NO_ID);
+    for(unsigned int k = 0; k < n; ++k){
+        if(sequence[k] >= n || newId[sequence[k]] != LabelTable::NO_ID){
+            throw std::invalid_argument("[ERROR] Vertex sequence must list every vertex once. Unable to complete request.");
+        }
+        newId[sequence[k]] = k;
+    }
+
+    LabelTable newLabels;
+    std::vector<std::size_t> newOffsets;
+    std::vector<unsigned int> newTargets;
+    std::vector<Weight> newWeights;
+    newOffsets.reserve(static_cast<std::size_t>(n) + 1);
+    newTargets.reserve(targets.size());
+    newWeights.reserve(weights.size());
+    newOffsets.push_back(0);
+    std::vector<std::pair<unsigned int, Weight>> slice;
+    for(unsigned int k = 0; k < n; ++k){
+        const unsigned int old = sequence[k];
+        newLabels.intern(labels.label(old));
+        slice.clear();
+        forEachNeighbor(old, [&](unsigned int next, unsigned long weight){
+            slice.push_back({newId[next], static_cast<Weight>(weight)});
+        });
+        std::sort(slice.begin(), slice.end());
+        for(auto it = slice.begin(); it != slice.end(); ++it){
+            newTargets.push_back(it->first);
+            newWeights.push_back(it->second);
+        }
+        newOffsets.push_back(newTargets.size());
+    }
+
+    labels = newLabels;
+    offsets.swap(newOffsets);
+    targets.swap(newTargets);
+    weights.swap(newWeights);
+
+    return newId;
+}
+
+/* Read-only, so constant. */
+template<typename Weight>
+unsigned int BasicFrozenGraph<Weight>::vertexCount() const{
+    return labels.size();
+}
+
+/* Read-only, so constant. */
+template<typename Weight>
+std::size_t BasicFrozenGraph<Weight>::edgeCount() const{
+    return targets.size();
+}
+
+/* Label-to-ID lookup for callers that want to work on dense IDs. */
+template<typename Weight>
+unsigned int BasicFrozenGraph<Weight>::vertexId(const std::string& label) const{
+    const unsigned int id = labels.find(label);
+    if(id == LabelTable::NO_ID){
+        throw std::invalid_argument("[ERROR] Specified vertex does not exist. Unable to complete request.");
+    }
+
+    return id;
+}
+
+/* ID-to-label lookup, the inverse of vertexId(). */
+template<typename Weight>
+const std::string& BasicFrozenGraph<Weight>::vertexLabel(unsigned int id) const{
+    return labels.label(id);    // Throws if id is out of range
+}
+
+/* Releases all arrays, leaving an empty snapshot. */
+template<typename Weight>
+void BasicFrozenGraph<Weight>::clear(){
+    labels.clear();
+    offsets.clear();
+    targets.clear();
+    weights.clear();
+    maxWeight = 0;
+
+    return;
+}
+
+/* Takes effect on the next shortestPath() call. */
+template<typename Weight>
+void BasicFrozenGraph<Weight>::setQueueKind(QueueKind kind){
+    queueKind = kind;
+
+    return;
+}
+
+/* Read-only, so constant. */
+template<typename Weight>
+QueueKind BasicFrozenGraph<Weight>::getQueueKind() const{
+    return queueKind;
+}
+
+/* Takes effect on the next shortestPath() call. */
+template<typename Weight>
+void BasicFrozenGraph<Weight>::setSearchMode(SearchMode mode){
+    searchMode = mode;
+
+    return;
+}
+
+/* Read-only, so constant. */
+template<typename Weight>
+SearchMode BasicFrozenGraph<Weight>::getSearchMode() const{
+    return searchMode;
+}
+
+/* Read-only, so constant. */
+template<typename Weight>
+unsigned long BasicFrozenGraph<Weight>::getMaxWeight() const{
+    return maxWeight;
+}
+
+/* Same as vertexId(), once per label. */
+template<typename Weight>
+std::vector<unsigned int> BasicFrozenGraph<Weight>::vertexIds(const std::vector<std::string>& labelList) const{
+    std::vector<unsigned int> ids;
+    ids.reserve(labelList.size());
+    for(auto it = labelList.begin(); it != labelList.end(); ++it){
+        ids.push_back(vertexId(*it));
+    }
+
+    return ids;
+}
+
+/* dijkstraToMany() stops as soon as the last distinct target is settled, then row[j] is read off the labels for
+   every target in the caller's order, duplicates included.                                                      */
+template<typename Weight>
+void BasicFrozenGraph<Weight>::distanceRow(unsigned int origin, const std::vector<unsigned int>& targets, const std::vector<unsigned int>& sortedTargets, unsigned long* row) const{
+    SearchWorkspace& workspace = SearchWorkspace::local();
+    dijkstraToMany(*this, vertexCount(), queueKind, maxWeight, origin, sortedTargets, workspace);
+    for(std::size_t j = 0; j < targets.size(); ++j){
+        row[j] = workspace.forward().distance(targets[j]);
+    }
+
+    return;
+}
+
+/* Same logic as Graph::reconstruct(), but every parent is known to be valid.
+   Vertices are translated back to labels as they are loaded into fnlPath.                     */
+template<typename Weight>
+void BasicFrozenGraph<Weight>::reconstruct(std::vector<std::string> &fnlPath, const SearchLabels& fnlEdges, unsigned int start, unsigned int end) const{
+    if(start == end){   // For one-vertex circular path
+        fnlPath.push_back(labels.label(start));
+        return;
+    }
+
+    const std::size_t first = fnlPath.size();   // Only reverse what this call appends
+    unsigned int curr = end;
+    while(curr != start){
+        fnlPath.push_back(labels.label(curr));
+        curr = fnlEdges.parent(curr);
+    }
+    fnlPath.push_back(labels.label(start));
+    std::reverse(fnlPath.begin() + first, fnlPath.end());
+
+    return;
+}
+
+/* Numbers the vertices in breadth-first order, one connected component at a time, so that each vertex sits close to
+   the neighbors it was discovered from. Plain BFS starts every component at its lowest old ID and takes neighbors in
+   slice order. With cuthillMcKee, each component starts at a peripheral vertex and the neighbors discovered by one
+   vertex are taken from lowest to highest degree; the finished sequence is then reversed (Reverse Cuthill-McKee),
+   which keeps the nonzeros of the adjacency matrix in a narrow band around its diagonal.                          */
+template<typename Weight>
+std::vector<unsigned int> BasicFrozenGraph<Weight>::breadthFirstOrder(bool cuthillMcKee) const{
+    const unsigned int n = vertexCount();
+    const auto degree = [&](unsigned int id){
+        return offsets[id + 1] - offsets[id];
+    };
+    std::vector<unsigned int> sequence;
+    sequence.reserve(n);
+    std::vector<bool> visited(n, false);
+    std::vector<unsigned int> depth;    // Scratch of peripheralVertex()
+    std::vector<unsigned int> queue;
+    if(cuthillMcKee){
+        depth.assign(n, LabelTable::NO_ID);
+    }
+    for(unsigned int root = 0; root < n; ++root){
+        if(visited[root]){
+            continue;
+        }
+        const unsigned int start = cuthillMcKee ? peripheralVertex(root, depth, queue) : root;
+        visited[start] = true;
+        sequence.push_back(start);
+        for(std::size_t head = sequence.size() - 1; head < sequence.size(); ++head){   // sequence doubles as the BFS queue
+            const std::size_t first = sequence.size();
+            forEachNeighbor(sequence[head], [&](unsigned int next, unsigned long){
+                if(!visited[next]){
+                    visited[next] = true;
+                    sequence.push_back(next);
+                }
+            });
+            if(cuthillMcKee){
+                std::stable_sort(sequence.begin() + first, sequence.end(), [&](unsigned int a, unsigned int b){
+                    return degree(a) < degree(b);
+                });
+            }
+        }
+    }
+    if(cuthillMcKee){
+        std::reverse(sequence.begin(), sequence.end());
+    }
+
+    return sequence;
+}
+
+/* Orders the vertices along a Hilbert curve laid over the bounding box of coordinates. The curve never jumps, so
+   vertices that are close on the map, which in road-like graphs are the likely neighbors, get close IDs. Ties keep
+   old ID order.                                                                                                  */
+template<typename Weight>
+std::vector<unsigned int> BasicFrozenGraph<Weight>::hilbertOrder(const std::vector<Coordinate>& coordinates) const{
+    const unsigned int n = vertexCount();
+    if(coordinates.size() != n){
+        throw std::invalid_argument("[ERROR] Hilbert order needs one coordinate per vertex. Unable to complete request.");
+    }
+    std::vector<unsigned int> sequence(n);
+    if(n == 0){
+        return sequence;
+    }
+    long minX = coordinates[0].x, maxX = coordinates[0].x;
+    long minY = coordinates[0].y, maxY = coordinates[0].y;
+    for(auto it = coordinates.begin(); it != coordinates.end(); ++it){
+        minX = std::min(minX, it->x);
+        maxX = std::max(maxX, it->x);
+        minY = std::min(minY, it->y);
+        maxY = std::max(maxY, it->y);
+    }
+    const double scaleX = (HILBERT_SIDE - 1) / std::max(1.0, static_cast<double>(maxX) - minX);
+    const double scaleY = (HILBERT_SIDE - 1) / std::max(1.0, static_cast<double>(maxY) - minY);
+
+    std::vector<std::pair<std::uint64_t, unsigned int>> keys(n);
+    for(unsigned int v = 0; v < n; ++v){
+        const std::uint32_t x = static_cast<std::uint32_t>((static_cast<double>(coordinates[v].x) - minX) * scaleX);
+        const std::uint32_t y = static_cast<std::uint32_t>((static_cast<double>(coordinates[v].y) - minY) * scaleY);
+        keys[v] = {hilbertIndex(x, y), v};
+    }
+    std::sort(keys.begin(), keys.end());
+    for(unsigned int k = 0; k < n; ++k){
+        sequence[k] = keys[k].second;
+    }
+
+    return sequence;
+}
+
+/* George-Liu search for a pseudo-peripheral vertex. Each round runs a BFS from the current candidate and moves to the
+   vertex of smallest degree in the deepest level, for as long as that makes the BFS deeper. Such a vertex lies at one
+   end of a long path through the component, which gives Cuthill-McKee narrow levels. depth is restored afterwards.  */
+template<typename Weight>
+unsigned int BasicFrozenGraph<Weight>::peripheralVertex(unsigned int root, std::vector<unsigned int>& depth, std::vector<unsigned int>& queue) const{
+    unsigned int best = root;
+    unsigned int eccentricity = 0;
+    for(unsigned int round = 0; round < PERIPHERAL_ROUNDS; ++round){
+        queue.assign(1, best);
+        depth[best] = 0;
+        for(std::size_t head = 0; head < queue.size(); ++head){
+            const unsigned int curr = queue[head];
+            forEachNeighbor(curr, [&](unsigned int next, unsigned long){
+                if(depth[next] == LabelTable::NO_ID){
+                    depth[next] = depth[curr] + 1;
+                    queue.push_back(next);
+                }
+            });
+        }
+        const unsigned int reach = depth[queue.back()];
+        unsigned int candidate = queue.back();
+        for(auto it = queue.rbegin(); it != queue.rend() && depth[*it] == reach; ++it){ // Deepest level only
+            if(offsets[*it + 1] - offsets[*it] < offsets[candidate + 1] - offsets[candidate]){
+                candidate = *it;
+            }
+        }
+        for(auto it = queue.begin(); it != queue.end(); ++it){
+            depth[*it] = LabelTable::NO_ID;
+        }
+        if(round > 0 && reach <= eccentricity){
+            break;
+        }
+        eccentricity = reach;
+        best = candidate;
+    }
+
+    return best;
+}
+
+template class BasicFrozenGraph<unsigned int>;
+template class BasicFrozenGraph<unsigned long>;
+template BasicFrozenGraph<unsigned int>::BasicFrozenGraph(const BasicFrozenGraph<unsigned long>&);
+template BasicFrozenGraph<unsigned long>::BasicFrozenGraph(const BasicFrozenGraph<unsigned int>&);
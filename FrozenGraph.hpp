@@ -0,0 +1,168 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a read-only snapshot of class
+   Graph. Where Graph stores a map of (source-vertex, Edge)
+   pairs, FrozenGraph assigns every vertex a dense integer ID
+   and stores the adjacency list in compressed-sparse-row
+   (CSR) form: three contiguous arrays of offsets, targets
+   and weights.
+
+   The neighbors of vertex u are found at indices
+   [offsets[u], offsets[u + 1]) of both targets and weights.
+   For example: offsets = {0, 2, 3}, targets = {1, 2, 0}
+   implies that vertex 0 has neighbors 1 and 2, and vertex 1
+   has neighbor 0.
+
+   A FrozenGraph is built once with Graph::freeze() and is
+   never mutated afterwards. Because relaxation in
+   shortestPath() walks plain arrays instead of red-black
+   tree nodes keyed by strings, query workloads which never
+   change the graph should prefer this class. The
+   shortestPath() contract is identical to that of Graph.
+
+   Because a snapshot never changes, any number of threads
+   may query it at once. shortestPathBatch() runs a whole
+   list of queries on a ThreadPool, each worker reusing its
+   own SearchWorkspace, and reports failures per query
+   instead of throwing.
+
+   distancesToMany() answers one origin against many targets
+   with a single search, and distanceMatrix() runs one such
+   search per origin on a ThreadPool. Both report
+   unreachable targets as ULONG_MAX instead of throwing.
+
+   withinRadius() lists every vertex within a distance of
+   one or more origins (an isochrone), and nearestOf()
+   lists the few targets closest to any of the origins.
+   Both stop searching as soon as their answer is known and
+   return (vertex ID, distance) pairs in order of distance;
+   an empty list, not an exception, means nothing matched.
+
+   reorder() renumbers the vertices so that neighbors get
+   nearby IDs, which keeps the labels and CSR slices that a
+   search touches together in cache: breadth-first order,
+   Reverse Cuthill-McKee order, or the order of a Hilbert
+   curve through the vertex coordinates. Labels follow their
+   vertices, so callers that only use labels never notice.
+
+   The class is a template on the type of the stored edge
+   weights, BasicFrozenGraph<Weight>, for the weight types
+   of WeightTraits.hpp. FrozenGraph, as built by
+   Graph::freeze(), stores unsigned long weights; a
+   BasicFrozenGraph<unsigned int> converted from it needs 8
+   bytes per edge instead of 12. Distances are unsigned long
+   either way, and neighborSlice() lets the searches relax
+   both with RelaxKernel.                                    */
+
+#ifndef FROZENGRAPH_HPP
+#define FROZENGRAPH_HPP
+
+#include "LabelTable.hpp"
+#include "Dijkstra.hpp"
+#include "ThreadPool.hpp"
+#include "WeightTraits.hpp"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <climits>
+
+enum class VertexOrder{
+    Original,               // IDs as assigned when the snapshot was built
+    Bfs,                    // Breadth-first, one connected component after another
+    ReverseCuthillMcKee,    // Breadth-first from a peripheral vertex, low degrees first, then reversed
+    Hilbert                 // Along a Hilbert curve through the coordinates. Needs one coordinate per vertex
+};
+
+struct Coordinate{  // Position of a vertex, as read from a DIMACS .co file
+    long x;
+    long y;
+};
+
+struct QueryResult{     // Outcome of one query of FrozenGraph::shortestPathBatch()
+    unsigned long distance = ULONG_MAX; // ULONG_MAX if the query failed
+    std::vector<std::string> path;      // Same as the path filled by shortestPath(), empty if the query failed
+    std::string error;                  // Message of the exception shortestPath() would have thrown, empty on success
+};
+
+struct ReachedVertex{   // One entry of FrozenGraph::withinRadius() and FrozenGraph::nearestOf()
+    unsigned int vertex;    // Dense ID. vertexLabel() translates it
+    unsigned long distance; // Distance to the nearest origin
+};
+
+template<typename Weight>
+class BasicFrozenGraph{
+public:
+    using weight_type = Weight;
+
+    BasicFrozenGraph(); // Empty snapshot. Populated by Graph::freeze()
+    BasicFrozenGraph(const BasicFrozenGraph&) = default;
+    BasicFrozenGraph(BasicFrozenGraph&&) = default; // Moves the arrays instead of copying them. Needed since the destructor is user-declared
+    template<typename Other>
+    explicit BasicFrozenGraph(const BasicFrozenGraph<Other>& other);    // Same snapshot with other weight types. Throws if a weight does not fit
+    BasicFrozenGraph& operator=(const BasicFrozenGraph&) = default;
+    BasicFrozenGraph& operator=(BasicFrozenGraph&&) = default;
+    ~BasicFrozenGraph(); // Default destructor included to fulfill course requirements. Calls clear()
+    unsigned long shortestPath(const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path) const; // Dijkstra's algorithm over CSR arrays
+    std::vector<QueryResult> shortestPathBatch(const std::vector<std::pair<std::string, std::string>>& queries, ThreadPool& pool) const; // Runs every (start, end) query on pool. Results are in query order
+    std::vector<unsigned long> distancesToMany(const std::string& originLabel, const std::vector<std::string>& targetLabels) const; // One search from origin. Entry j is the distance to target j, ULONG_MAX if unreachable
+    std::vector<unsigned long> distanceMatrix(const std::vector<std::string>& originLabels, const std::vector<std::string>& targetLabels, ThreadPool& pool) const; // Row-major. Entry [i * targets + j] is the distance from origin i to target j
+    std::vector<ReachedVertex> withinRadius(const std::vector<std::string>& originLabels, unsigned long radius) const; // Every vertex at most radius from an origin, origins included, nearest first
+    std::vector<ReachedVertex> nearestOf(const std::vector<std::string>& originLabels, const std::vector<std::string>& targetLabels, std::size_t count = 1, unsigned long radius = ULONG_MAX) const; // Up to count distinct targets at most radius from an origin, nearest first
+    std::vector<unsigned int> reorder(VertexOrder order, const std::vector<Coordinate>& coordinates = {}); // Renumbers every vertex. Returns (index/value) = (old ID/new ID)
+    std::vector<unsigned int> reorder(const std::vector<unsigned int>& sequence);   // Same, for a caller's sequence, (index/value) = (new ID/old ID). Throws unless it is a permutation
+    unsigned int vertexCount() const;   // Number of vertices (dense IDs are 0 to vertexCount() - 1)
+    std::size_t edgeCount() const;      // Number of directed edges (each undirected edge is stored twice)
+    unsigned int vertexId(const std::string& label) const;  // Translates a label to its dense ID. Throws if not found
+    const std::string& vertexLabel(unsigned int id) const;  // Translates a dense ID back to its label
+    void clear();   // Releases all arrays
+    void setQueueKind(QueueKind kind);  // Selects the priority queue used by shortestPath(). Copied from Graph by freeze()
+    QueueKind getQueueKind() const;     // Returns the selected priority queue, before Automatic is resolved
+    void setSearchMode(SearchMode mode);    // Selects one- or two-sided search in shortestPath(). Defaults to SearchMode::Unidirectional
+    SearchMode getSearchMode() const;       // Returns the selected search mode
+    unsigned long getMaxWeight() const; // Largest edge weight, drives QueueKind::Automatic
+
+    template<typename Visit>
+    void forEachNeighbor(unsigned int id, Visit visit) const{   // Calls visit(neighbor ID, weight) for each neighbor of id. Used by dijkstra()
+        for(std::size_t i = offsets[id]; i < offsets[id + 1]; ++i){  // Contiguous neighbor slice of id
+            visit(targets[i], weights[i]);
+        }
+    }
+
+    std::size_t neighborSlice(unsigned int id, const unsigned int*& sliceTargets, const Weight*& sliceWeights) const{ // Points at the neighbors of id and returns their count. Used by relaxNeighbors()
+        sliceTargets = targets.data() + offsets[id];
+        sliceWeights = weights.data() + offsets[id];
+        return offsets[id + 1] - offsets[id];
+    }
+
+protected:  // Helper functions. reconstruct() rebuilds shortest vector path from start to end
+    std::vector<unsigned int> vertexIds(const std::vector<std::string>& labelList) const;    // vertexId() of every label
+    void distanceRow(unsigned int origin, const std::vector<unsigned int>& targets, const std::vector<unsigned int>& sortedTargets, unsigned long* row) const; // One-to-many search, writes one entry per target
+    void reconstruct(std::vector<std::string> &fnlPath, const SearchLabels& fnlEdges, unsigned int start, unsigned int end) const;
+    // Helpers of reorder(). Each returns (index/value) = (new ID/old ID)
+    std::vector<unsigned int> breadthFirstOrder(bool cuthillMcKee) const;
+    std::vector<unsigned int> hilbertOrder(const std::vector<Coordinate>& coordinates) const;
+    unsigned int peripheralVertex(unsigned int root, std::vector<unsigned int>& depth, std::vector<unsigned int>& queue) const; // Start of a long BFS in root's component. depth must be all NO_ID, and is left so
+
+private:
+    friend class Graph; // Graph::freeze() fills the arrays below directly
+    friend class MappedGraph;   // MappedGraph::write() stores the arrays below directly
+    friend class GraphImporter; // GraphImporter::build() fills the arrays below directly
+    friend class CompressedGraph;   // CompressedGraph::build() copies the labels below directly
+    template<typename> friend class BasicFrozenGraph;  // The converting constructor reads the arrays of other weight types
+
+    LabelTable labels;                  // (label/dense ID) interning table. No slot is ever released
+    std::vector<std::size_t> offsets;   // vertexCount() + 1 entries. Neighbors of u live in [offsets[u], offsets[u + 1])
+    std::vector<unsigned int> targets;  // Neighbor IDs, grouped by source vertex
+    std::vector<Weight> weights;        // Edge weights, parallel to targets
+    QueueKind queueKind = QueueKind::Automatic;
+    SearchMode searchMode = SearchMode::Unidirectional;
+    unsigned long maxWeight = 0;        // Largest entry of weights
+};
+
+using FrozenGraph = BasicFrozenGraph<unsigned long>;    // The snapshot built by Graph::freeze()
+
+#endif
@@ -6,20 +6,21 @@
    graph element consists of (source-vertex, map of
    neighbor-vertices/distances from source-vertex).
    The pair above is encapsulated by
-   (std::string, class Edge) and represents an adjacency
+   (vertex ID, class Edge) and represents an adjacency
    list for immutable reference in the algorithm.
    
    Class Edge provides further
    encapsulation of (neighbor-vertices, distances from
    source-vertex).
    
-   The adjacency list is implemented in a map-of-maps
-   manner, using STL map, because it provides two benefits.
-   With this implementation of Dijkstra's algorithm,
-   enforcement of "no duplicates" is made simpler by STL map
-   functions. Also, because the look-up time for a map
-   element is less than that of a vector, a map is the
-   preferred sub-ADT for this algorithm.
+   Vertex labels are interned by class LabelTable when
+   addVertex() is called. Every internal structure works on
+   the resulting 32-bit IDs, and labels are only translated
+   at the public API boundary. The adjacency list is a
+   vector of Edge objects indexed by ID, and each Edge is an
+   STL map keyed by neighbor ID. The map keeps enforcement
+   of "no duplicates" simple, while the vector gives
+   constant-time access to any source-vertex.
       
    Details on the algorithm's implementation are provided
    below in shortestPath(), but the design operates by
@@ -30,54 +31,121 @@
    
    By the end of the algorithm, both the shortest distance
    and the path to obtain the shortest distance are made
-   available to the caller.                                  */
+   available to the caller.
+
+   Once a graph is fully built, freeze() converts it into a
+   FrozenGraph, a read-only snapshot with the same
+   shortestPath() contract and a cache-friendly layout.
+
+   Repeat queries can be answered by an optional LRU cache
+   of results (class ResultCache), off until
+   setCacheCapacity() is called. Every mutator bumps the
+   graph version, which retires all cached results at once.
+
+   Objects derived from GraphObserver can subscribe() to be
+   told about every mutation as it happens, which lets
+   class DynamicTree keep shortest path trees up to date.
+   Observers belong to one Graph object and are not copied
+   with it.
+
+   Every neighbor map, and the adjacency list itself, lives
+   in the graph's own arena, a pool resource (std::pmr)
+   which asks an upstream resource for large blocks and
+   carves map nodes out of them. Building a graph therefore
+   costs a handful of large allocations instead of one per
+   edge, and clear() hands all of them back at once. Nodes
+   freed by removals are recycled by the pool. Passing a
+   std::pmr::monotonic_buffer_resource as the upstream
+   turns those blocks into bump allocations as well.         */
 
 #include "Graph.hpp"
-#include "PQueue.hpp"
+#include "SearchStats.hpp"
 
 #include <string>
 #include <stdexcept>
-#include <map>
+#include <vector>
 #include <climits>
 #include <algorithm>
+#include <map>
+#include <memory_resource>
 
 /* Defined solely for course requirement. */
-Graph::Graph(){
+Graph::Graph() : Graph(std::pmr::get_default_resource()){
+    // No logical implementation required
+}
+
+/* The adjacency list is bound to the arena here, and every Edge it creates inherits the arena from it. */
+Graph::Graph(std::pmr::memory_resource* upstream) : arena(upstream), adjacencyList(&arena){
     // No logical implementation required
 }
 
+/* Observers subscribed to other are not copied, since they track other, not the copy. The copy gets an arena of its
+   own on the same upstream, and its maps are rebuilt inside it.                                                    */
+Graph::Graph(const Graph& other) : arena(other.arena.upstream_resource()), labels(other.labels), adjacencyList(other.adjacencyList, &arena), queueKind(other.queueKind),
+    searchMode(other.searchMode), maxWeight(other.maxWeight), version(other.version), cache(other.cache){
+    // No logical implementation required
+}
+
+/* To this graph's observers, the old contents vanish at once, exactly as in clear(). The version moves past both
+   graphs' versions, so no result cached by either one can be mistaken for a result of the other.                   */
+Graph& Graph::operator=(const Graph& other){
+    if(this == &other){
+        return *this;
+    }
+    const unsigned long newVersion = std::max(version, other.version) + 1;
+    labels = other.labels;
+    adjacencyList = other.adjacencyList;
+    queueKind = other.queueKind;
+    searchMode = other.searchMode;
+    maxWeight = other.maxWeight;
+    version = newVersion;
+    cache.clear();
+    cache.setCapacity(other.cache.getCapacity());
+    for(auto it = observers.begin(); it != observers.end(); ++it){
+        (*it)->onCleared();
+    }
+
+    return *this;
+}
+
 /* Allows indirect call to STL map.clear(), freeing all
-   allocated for map in Graph as well as Graph elements. */
+   allocated for map in Graph as well as Graph elements.
+   Observers are detached last, after they see clear().  */
 Graph::~Graph(){
     clear();
+    for(auto it = observers.begin(); it != observers.end(); ++it){
+        (*it)->onDetached();
+    }
 }
 
-/* Function adds a new vertex after checking for duplicates. */
+/* Function adds a new vertex after checking for duplicates. The label is interned
+   here, once, and the resulting ID selects the vertex's slot in adjacencyList.    */
 void Graph::addVertex(const std::string& label){
-    if(adjacencyList.find(label) != adjacencyList.end()){
+    if(labels.find(label) != LabelTable::NO_ID){
         throw std::logic_error("[ERROR] Specified vertex has already been added. Unable to complete request.");
     }
-    adjacencyList.insert({label, Edge()});  // Insert a new (source vector/neighbor map) pair. Neighbor map defaulted as empty
+    placeVertex(label);
+    ++version;
 
     return;
 }
 
 /* Function removes all instances of the target vertex.
    This includes removing instances of the vertex as a
-   neighbor, then of the vertex as a source.            */
-void Graph::removeVertex(std::string& label){
-    if(adjacencyList.find(label) == adjacencyList.end()){
+   neighbor, then of the vertex as a source. See
+   eraseVertex() for the work itself.                   */
+void Graph::removeVertex(const std::string& label){
+    const unsigned int id = labels.find(label);
+    if(id == LabelTable::NO_ID){
         throw std::invalid_argument("[ERROR] Specified vertex not found in adjacency list. Unable to complete request.");
     }
-    for(auto it = adjacencyList.begin(); it != adjacencyList.end(); ++it){ // Traverse all source vertices in the adjacency list...
-        it->second.remove_neighbor(label);                                 // ...and remove any instance of the vertex as a neighbor
-    }
-    adjacencyList.erase(label); // Then remove the vertex as a source, erasing its map of neighbors as well
+    eraseVertex(id);
+    ++version;                  // A reused ID must not hit results cached for the old vertex
 
     return;    
 }
 
-/* Function adds an edge by inserting a new label/weight pair to a source vertex's list
+/* Function adds an edge by inserting a new ID/weight pair to a source vertex's list
    of neighbors. This function confirms [a] no self-loop edges are formed by a single
    vertex, [b] both the source vertex and destination vertex exist in the adjacency
    list before adding neighbors, and [c] the intended edge does not already exist.
@@ -86,15 +154,17 @@ void Graph::addEdge(std::string label1, std::string label2, unsigned long weight
     if(label1 == label2){   // [a] No self-loops
         throw std::invalid_argument("[ERROR] Program does not support self-loop condition. Unable to complete request.");
     }
-    if(adjacencyList.find(label1) == adjacencyList.end() || adjacencyList.find(label2) == adjacencyList.end()){ // [b] Both are source vertices
+    const unsigned int id1 = labels.find(label1);
+    const unsigned int id2 = labels.find(label2);
+    if(id1 == LabelTable::NO_ID || id2 == LabelTable::NO_ID){ // [b] Both are source vertices
         throw std::invalid_argument("[ERROR] One or more specified vertex does not exist. Unable to complete request.");
     }
-    if(adjacencyList.at(label1).get_neighbors().find(label2) != adjacencyList.at(label1).get_neighbors().end()){ // [c] No duplicate edges
+    if(adjacencyList[id1].get_neighbors().find(id2) != adjacencyList[id1].get_neighbors().end()){ // [c] No duplicate edges
         throw std::logic_error("[ERROR] Specified edge already exists. Unable to complete request.");
     }
 
-    adjacencyList.at(label1).insert(label2, weight);   // Undirected edges...
-    adjacencyList.at(label2).insert(label1, weight);   // ...are now formed
+    placeEdge(id1, id2, weight);
+    ++version;
 
     return;
 }
@@ -106,131 +176,369 @@ void Graph::addEdge(std::string label1, std::string label2, unsigned long weight
    NOTE: Function is not called in this Dijkstra's algorithm implementation. */
 void Graph::removeEdge(std::string label1, std::string label2){
     // [a] Confirm that both vertices exist
-    if(adjacencyList.find(label1) == adjacencyList.end() || adjacencyList.find(label2) == adjacencyList.end()){
+    const unsigned int id1 = labels.find(label1);
+    const unsigned int id2 = labels.find(label2);
+    if(id1 == LabelTable::NO_ID || id2 == LabelTable::NO_ID){
         throw std::invalid_argument("[ERROR] One or more specified vertex does not exist. Unable to complete request.");
     }
     // [b] Confirm that there is an edge between both vertices
-    const auto& label1Edges = adjacencyList.at(label1).get_neighbors();
-    if(label1Edges.find(label2) == label1Edges.end()){
+    const auto& label1Edges = adjacencyList[id1].get_neighbors();
+    const auto edge = label1Edges.find(id2);
+    if(edge == label1Edges.end()){
         throw std::logic_error("[ERROR] No edge exists between specified vertices. Unable to complete request.");
     }
+    const unsigned long weight = edge->second;  // Reported to observers once the edge is gone
     // If [a] and [b] are confirmed, remove applicable neighbor of both vertices
-    adjacencyList.at(label1).remove_neighbor(label2);
-    adjacencyList.at(label2).remove_neighbor(label1);
-    
+    eraseEdge(id1, id2, weight);
+    ++version;
 
     return;
 }
 
+/* Applies every mutation of batch in order, with the same checks as the four single mutators above. Each item is
+   validated once, against the graph as the earlier items left it, so a batch may add a vertex and then edges to it.
+   An item which fails its check is skipped and its status says why; nothing is thrown and later items still apply.
+   The version is bumped once for the whole batch, so cached results are retired once as well. Observers still hear
+   about every applied item, as it is applied.                                                                      */
+std::vector<MutationStatus> Graph::applyBatch(const std::vector<Mutation>& batch){
+    std::vector<MutationStatus> statuses;
+    statuses.reserve(batch.size());
+    bool changed = false;
+    for(auto it = batch.begin(); it != batch.end(); ++it){
+        MutationStatus status = MutationStatus::Applied;
+        if(it->kind == MutationKind::AddVertex){
+            if(labels.find(it->label1) != LabelTable::NO_ID){
+                status = MutationStatus::DuplicateVertex;
+            }
+            else{
+                placeVertex(it->label1);
+            }
+        }
+        else if(it->kind == MutationKind::RemoveVertex){
+            const unsigned int id = labels.find(it->label1);
+            if(id == LabelTable::NO_ID){
+                status = MutationStatus::MissingVertex;
+            }
+            else{
+                eraseVertex(id);
+            }
+        }
+        else if(it->kind == MutationKind::AddEdge && it->label1 == it->label2){
+            status = MutationStatus::SelfLoop;
+        }
+        else{   // Both edge mutations look up the same pair
+            const unsigned int id1 = labels.find(it->label1);
+            const unsigned int id2 = labels.find(it->label2);
+            if(id1 == LabelTable::NO_ID || id2 == LabelTable::NO_ID){
+                status = MutationStatus::MissingVertex;
+            }
+            else{
+                const auto& neighborMap = adjacencyList[id1].get_neighbors();
+                const auto edge = neighborMap.find(id2);
+                if(it->kind == MutationKind::AddEdge){
+                    if(edge != neighborMap.end()){
+                        status = MutationStatus::DuplicateEdge;
+                    }
+                    else{
+                        placeEdge(id1, id2, it->weight);
+                    }
+                }
+                else if(edge == neighborMap.end()){
+                    status = MutationStatus::MissingEdge;
+                }
+                else{
+                    eraseEdge(id1, id2, edge->second);
+                }
+            }
+        }
+        changed = changed || status == MutationStatus::Applied;
+        statuses.push_back(status);
+    }
+    if(changed){
+        ++version;
+    }
+
+    return statuses;
+}
+
 /* This function implements Dijkstra's algorithm. The algorithm works "backwards," tracking the distance from each
    vertex back to the startLabel. While doing so, indirect paths between vertices which are shorter than those stored
-   in adjacencyList may be discovered. If so, the shorter distance will be stored in the updateable map shortestDistance.
-   As shortestDistance maintains the shortest path from currLabel to startLabel, the algorithm looks to confirm that
-   currLabel == endLabel. With this confirmation, the shortest path from start to end is identified, and both the total
-   distance and vertex-by-vertex path are made available to the caller.                                                 */
+   in adjacencyList may be discovered. If so, the shorter distance will be stored in the updateable vector shortestDistance.
+   As shortestDistance maintains the shortest path from curr to startLabel, the algorithm looks to confirm that
+   curr == end. With this confirmation, the shortest path from start to end is identified, and both the total
+   distance and vertex-by-vertex path are made available to the caller. Labels are translated to IDs once on entry,
+   and the search state is held in the calling thread's SearchWorkspace, indexed by ID, so the search never compares
+   or copies a string and repeated queries reuse the same arrays. The search
+   loop itself is shared with FrozenGraph and lives in dijkstra() (Dijkstra.hpp), run with the queue selected by
+   setQueueKind(). With SearchMode::Bidirectional, bidirectionalDijkstra() searches from both ends instead, and the
+   path is reconstructed in two halves which are joined at the vertex where the searches met. When the result cache
+   is enabled, a fresh entry for (start, end) is returned without searching, and every search result is stored,
+   including the absence of a path, so repeated unreachable pairs throw without searching either.                 */
 unsigned long Graph::shortestPath(const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path){
+    SEARCH_STATS(SearchStats::QueryScope statsQuery("graph"));
     // Ensure that the adjacency list contains the correct vertices to process
-    if(adjacencyList.find(startLabel) == adjacencyList.end() || adjacencyList.find(endLabel) == adjacencyList.end()){
+    const unsigned int start = labels.find(startLabel);
+    const unsigned int end = labels.find(endLabel);
+    if(start == LabelTable::NO_ID || end == LabelTable::NO_ID){
         throw std::invalid_argument("[ERROR] One or more specified vertex does not exist. Unable to complete request.");
     }
 
-    std::map<std::string, std::string> prevVertex;          // Tracks tentative vertex-to-vertex path
-    std::map<std::string, unsigned long> shortestDistance;  // Tracks tentative total path distance
-    for(auto it = adjacencyList.begin(); it != adjacencyList.end(); ++it){
-        shortestDistance[it->first] = ULONG_MAX;    // Assume that the distance from most vertices back to startLabel is infinite...
-    }
-    shortestDistance[startLabel] = 0;               // ...but we know the distance from startLabel to startLabel is 0
-
-    /* At this point, startLabel provides the only confirmed data.
-       [a] Starting from startLabel, check which neighbor offers the shortest path back to startLabel.
-       [b] If that path is less than the current shortest distance known, update what is known.
-       [c] Insert it in pQueue so that it can be sorted.
-       [d] Whichever path-back-to-startLabel is shortest will then be processed next with top().
-       [e] Once we can confirm that top() == endLabel, we can also confirm that we've found the shortest distance back to startLabel */
-
-    PQueue pQueue;
-    Vertex startVertex(shortestDistance[startLabel], startLabel);   // [a]/[d] Convert data to a Vertex object suitable for pQueue...
-    pQueue.push(startVertex);                                       // ...and push it to pQueue
-    while(!pQueue.empty()){     // Safe pQueue-state guard
-        unsigned long currDistance = pQueue.top().get_distance();    // Obtain distance...
-        std::string currLabel = pQueue.top().get_label();            // ...and label from first Vertex node in queue
-        pQueue.pop();   // Node whose neighbors will be explored is no longer needed
-        if(currDistance != shortestDistance[currLabel]){  // If this is not the correct shortest distance...
-            continue;                                     // ...disregard, and process another node
-        }
-        
-        if(currLabel == endLabel){                               // [e] If shortest path from startLabel to endLabel is found...
-            reconstruct(path, prevVertex, startLabel, endLabel); // ...reconstruct the vertex-to-vertex path...
-            return currDistance;                                 // ...and return the value
-        }
-        
-
-        // Now we refer back to the immutable adjacency list
-        const auto& neighborMap = adjacencyList.at(currLabel).get_neighbors(); // [b] Get the current Vertex node's neighbors
-        for(auto it = neighborMap.begin(); it != neighborMap.end(); ++it){  // Iterate through the neighbors
-            unsigned long testD = it->second + currDistance;            // The neighbor-current distance we plan to test...
-            unsigned long shortestD = shortestDistance.at(it->first);      // ...against neighbor-startLabel distance we are unsure of
-            if(testD < shortestD){                       // If we found a shorter distance
-                prevVertex[it->first] = currLabel;
-                shortestDistance.at(it->first) = testD;    // ...then update what we know
-                Vertex updatedVertex(shortestDistance[it->first], it->first);   // ...format new data for pQueue
-                pQueue.push(updatedVertex); // [c] ...and push to pQueue for sorting. Whichever path-back-to-startLabel is shortest is processed next
-            }
+    unsigned long distance;
+    const std::size_t first = path.size();      // Only the slice appended below is cached
+    if(cache.lookup(start, end, version, distance, path)){
+        if(distance == ULONG_MAX){
+            throw std::logic_error("[ERROR] No path exists between the start and end vertices");
         }
+        return distance;
     }
-    
-    throw std::logic_error("[ERROR] No path exists between the start and end vertices");  // Throw if no path is found
+
+    SearchWorkspace& workspace = SearchWorkspace::local();  // Tentative distances and vertex-to-vertex paths, forward and backward
+    unsigned int meet = end;                        // Vertex where the forward path ends and the backward path begins
+    if(searchMode == SearchMode::Bidirectional){
+        distance = bidirectionalDijkstra(*this, adjacencyList.size(), queueKind, maxWeight, start, end, workspace, meet);
+    }
+    else{
+        distance = dijkstra(*this, adjacencyList.size(), queueKind, maxWeight, start, end, workspace);
+    }
+    if(distance == ULONG_MAX){
+        cache.store(start, end, version, distance, {});
+        throw std::logic_error("[ERROR] No path exists between the start and end vertices");  // Throw if no path is found
+    }
+    SEARCH_STATS(SearchStats::PhaseTimer reconstructTimer(SearchStats::Reconstruct));
+    reconstruct(path, workspace.forward(), start, meet); // Reconstruct the vertex-to-vertex path...
+    if(meet != end){                            // ...stitching on the backward half, which reconstruct() emits from end to meet
+        std::vector<std::string> backwardPath;
+        reconstruct(backwardPath, workspace.backward(), end, meet);
+        path.insert(path.end(), backwardPath.rbegin() + 1, backwardPath.rend());
+    }
+    if(cache.enabled()){
+        cache.store(start, end, version, distance, std::vector<std::string>(path.begin() + first, path.end()));
+    }
+
+    return distance;                            // ...and return the value
 }
 
-/* This function reconstructs the shortest path by referring to elements in a map declared and filled in shortestPath(). Each map element consists of a 
-   (string, string) pair. Any given pair represents two neighbor vertices which form an edge and are part of the total shortest path. Beginning with end
-   (last vertex in path), logic calls push_back(), one vertex (key) at a time, to vector fnlPath. To determine which vertex to visit next, logic refers
-   to the neighbor (value) of the vertex (key) which was just "pushed_back". Logic stops when the visited vertex == start, then start is "pushed_back".
-   After this point, the passed vector fnlPath is simply reversed so that vector[0] == start and vector[size-1] == end.*/
-void Graph::reconstruct(std::vector<std::string> &fnlPath, const std::map<std::string, std::string>& fnlEdges, const std::string& start, const std::string& end){
+/* This function reconstructs the shortest path by referring to the labels filled in shortestPath(). Each parent
+   fnlEdges.parent(v) holds the ID of the vertex which precedes v on the total shortest path, so they form an edge.
+   Beginning with end (last vertex in path), logic calls push_back(), one vertex at a time, to vector fnlPath. To determine
+   which vertex to visit next, logic refers to the predecessor of the vertex which was just "pushed_back". Logic stops when
+   the visited vertex == start, then start is "pushed_back". After this point, the appended part of fnlPath is simply
+   reversed so that it begins with start and ends with end. IDs are translated back to labels as they are loaded.      */
+void Graph::reconstruct(std::vector<std::string> &fnlPath, const SearchLabels& fnlEdges, unsigned int start, unsigned int end){
     // The following three cases avoid unnecessary logic
-    if(start.empty() || end.empty()){
+    if(!labels.live(start) || !labels.live(end)){
         throw std::invalid_argument("[ERROR] Start and/or edge vertex contains invalid data. Unable to complete request");
     }    
     if(start == end){   // For one-vertex circular path
-        fnlPath.push_back(start);
+        fnlPath.push_back(labels.label(start));
         return;
     }
-    if(fnlEdges.find(end) == fnlEdges.end()){
+    if(end >= fnlEdges.size() || fnlEdges.parent(end) == LabelTable::NO_ID){
         throw std::invalid_argument("[ERROR] End vertex does not exist. Unable to complete request.");
     }
     
-    fnlPath.push_back(end); // Load end vertex first
-    std::string curr = fnlEdges[end];
+    const std::size_t first = fnlPath.size();   // Only reverse what this call appends
+    fnlPath.push_back(labels.label(end)); // Load end vertex first
+    unsigned int curr = fnlEdges.parent(end);
     while(curr != start){
-        if(fnlEdges.find(curr) == fnlEdges.end()){  // The fourth/last case to inspect is a broken path from potentially corrupted data
+        if(fnlEdges.parent(curr) == LabelTable::NO_ID){  // The fourth/last case to inspect is a broken path from potentially corrupted data
             throw std::logic_error("[ERROR] Break in vertex path detected. Unable to complete request.");
         }
-        fnlPath.push_back(curr);    // Load current vertex...
-        curr = fnlEdges[curr];      // ...and iterate to 
+        fnlPath.push_back(labels.label(curr));  // Load current vertex...
+        curr = fnlEdges.parent(curr);           // ...and iterate to 
     }
-    fnlPath.push_back(start);                     // After iterations are complete, load start vertex...
-    std::reverse(fnlPath.begin(), fnlPath.end()); // ...and reverse the order
+    fnlPath.push_back(labels.label(start));               // After iterations are complete, load start vertex...
+    std::reverse(fnlPath.begin() + first, fnlPath.end()); // ...and reverse the order
     
     return;
 }
 
-/* This function allows indirect call to STL map.clear(). The function
-   clears all neighbor maps before clearing the adjacency list,
-   releasing memory held by the maps before returning to caller.       */
+/* This function empties the graph. The adjacency list is swapped for an empty one bound to the same arena, and the
+   old list is destroyed with it; its map nodes only go back to the pool's free lists, never to the system. Then the
+   arena returns every block to the upstream resource in one pass, instead of one free per node. The label table is
+   cleared as well, so IDs restart from 0.                                                                          */
 void Graph::clear(){
-    for(auto it = adjacencyList.begin(); it != adjacencyList.end(); ++it){
-        it->second.clear(); // Clear secondary Vertex.neighbors maps first...
+    std::pmr::vector<Edge>(&arena).swap(adjacencyList);    // Nothing may point into the arena past this line...
+    arena.release();        // ...so every block can go back at once...
+    labels.clear();         // ...along with the interned labels
+    maxWeight = 0;
+    ++version;
+    cache.clear();  // Every entry is stale now, so free them eagerly
+    for(auto it = observers.begin(); it != observers.end(); ++it){
+        (*it)->onCleared();
+    }
+
+    return;
+
+}
+
+/* This function builds a FrozenGraph snapshot in two passes over the adjacency list. The first pass assigns each live
+   vertex a dense snapshot ID in ascending Graph ID order, closing the gaps left by removed vertices. The second pass
+   copies each neighbor map into one contiguous slice of the CSR arrays. Neighbor maps are sorted by Graph ID and the
+   renumbering preserves that order, so each slice is sorted as well. Unless order is Original, the snapshot is then
+   renumbered by FrozenGraph::reorder(), which its labels follow. Later changes to this Graph are not reflected in
+   the snapshot.                                                                                                      */
+FrozenGraph Graph::freeze(VertexOrder order) const{
+    FrozenGraph snapshot;
+    std::vector<unsigned int> denseId(adjacencyList.size(), LabelTable::NO_ID);   // (index/value) = (Graph ID/snapshot ID)
+    std::size_t edgeCount = 0;
+    for(unsigned int id = 0; id < adjacencyList.size(); ++id){  // First pass: label/ID tables
+        if(labels.live(id)){
+            denseId[id] = snapshot.labels.intern(labels.label(id));
+            edgeCount += adjacencyList[id].get_neighbors().size();
+        }
     }
-    adjacencyList.clear();  // ...then clear high-level map container
+
+    snapshot.offsets.reserve(snapshot.labels.size() + 1);
+    snapshot.targets.reserve(edgeCount);
+    snapshot.weights.reserve(edgeCount);
+    snapshot.offsets.push_back(0);
+    for(unsigned int id = 0; id < adjacencyList.size(); ++id){  // Second pass: CSR arrays
+        if(!labels.live(id)){
+            continue;
+        }
+        const auto& neighborMap = adjacencyList[id].get_neighbors();
+        for(auto nt = neighborMap.begin(); nt != neighborMap.end(); ++nt){
+            snapshot.targets.push_back(denseId[nt->first]);
+            snapshot.weights.push_back(nt->second);
+        }
+        snapshot.offsets.push_back(snapshot.targets.size());
+    }
+    snapshot.queueKind = queueKind;
+    snapshot.searchMode = searchMode;
+    snapshot.maxWeight = maxWeight;
+    if(order != VertexOrder::Original){
+        snapshot.reorder(order);    // Throws for Hilbert, which needs coordinates
+    }
+
+    return snapshot;
+}
+
+/* Takes effect on the next shortestPath() call. */
+void Graph::setQueueKind(QueueKind kind){
+    queueKind = kind;
 
     return;
+}
 
+/* Read-only, so constant. */
+QueueKind Graph::getQueueKind() const{
+    return queueKind;
 }
 
+/* Takes effect on the next shortestPath() call. */
+void Graph::setSearchMode(SearchMode mode){
+    searchMode = mode;
 
+    return;
+}
 
+/* Read-only, so constant. */
+SearchMode Graph::getSearchMode() const{
+    return searchMode;
+}
+
+/* Read-only, so constant. */
+unsigned long Graph::getMaxWeight() const{
+    return maxWeight;
+}
 
+/* Shrinking evicts least recently used results at once. */
+void Graph::setCacheCapacity(std::size_t capacity){
+    cache.setCapacity(capacity);
 
+    return;
+}
+
+/* Read-only, so constant. */
+const ResultCache& Graph::getCache() const{
+    return cache;
+}
+
+/* Read-only, so constant. */
+unsigned long Graph::getVersion() const{
+    return version;
+}
+
+/* Read-only, so constant. */
+std::pmr::memory_resource* Graph::getUpstream() const{
+    return arena.upstream_resource();
+}
+
+/* Linear scan, since a graph only has a handful of observers. */
+void Graph::subscribe(GraphObserver& observer){
+    if(std::find(observers.begin(), observers.end(), &observer) == observers.end()){
+        observers.push_back(&observer);
+    }
+
+    return;
+}
 
+/* Order of the remaining observers is preserved. */
+void Graph::unsubscribe(GraphObserver& observer){
+    observers.erase(std::remove(observers.begin(), observers.end(), &observer), observers.end());
 
+    return;
+}
+
+/* Interns label and opens its slot in adjacencyList, then tells observers. label must not be interned yet. */
+unsigned int Graph::placeVertex(const std::string& label){
+    const unsigned int id = labels.intern(label);
+    if(id >= adjacencyList.size()){
+        adjacencyList.resize(id + 1);   // New slot. Neighbor map defaulted as empty
+    }
+    for(auto it = observers.begin(); it != observers.end(); ++it){
+        (*it)->onVertexAdded(id);
+    }
+
+    return id;
+}
+
+/* Because addEdge() always inserts both directions, the vertex's own neighbor map lists every vertex that holds it
+   as a neighbor. Only those maps are visited, so the cost is O(degree log degree) rather than a pass over every
+   vertex in the graph. Observers are told about each lost edge, then about the vertex.                              */
+void Graph::eraseVertex(unsigned int id){
+    const auto& neighborMap = adjacencyList[id].get_neighbors();
+    for(auto nt = neighborMap.begin(); nt != neighborMap.end(); ++nt){  // Traverse only the vertex's own neighbors...
+        adjacencyList[nt->first].remove_neighbor(id);                   // ...and remove the vertex from each of their maps
+    }
+    std::map<unsigned int, unsigned long> incident;     // Kept only to report the lost edges to observers
+    if(!observers.empty()){
+        incident.insert(neighborMap.begin(), neighborMap.end());
+    }
+    adjacencyList[id].clear();  // Then remove the vertex as a source, erasing its map of neighbors as well...
+    labels.release(id);         // ...and free its ID for reuse
+    for(auto it = observers.begin(); it != observers.end(); ++it){
+        for(auto nt = incident.begin(); nt != incident.end(); ++nt){
+            (*it)->onEdgeRemoved(id, nt->first, nt->second);
+        }
+        (*it)->onVertexRemoved(id);
+    }
+
+    return;
+}
+
+/* Forms the undirected edge id1-id2, then tells observers. The edge must not exist yet. */
+void Graph::placeEdge(unsigned int id1, unsigned int id2, unsigned long weight){
+    adjacencyList[id1].insert(id2, weight);   // Undirected edges...
+    adjacencyList[id2].insert(id1, weight);   // ...are now formed
+    if(weight > maxWeight){
+        maxWeight = weight;     // Keeps QueueKind::Automatic informed
+    }
+    for(auto it = observers.begin(); it != observers.end(); ++it){
+        (*it)->onEdgeAdded(id1, id2, weight);
+    }
+
+    return;
+}
+
+/* Removes both directions of the edge id1-id2, then tells observers. weight is only passed on to them. */
+void Graph::eraseEdge(unsigned int id1, unsigned int id2, unsigned long weight){
+    adjacencyList[id1].remove_neighbor(id2);
+    adjacencyList[id2].remove_neighbor(id1);
+    for(auto it = observers.begin(); it != observers.end(); ++it){
+        (*it)->onEdgeRemoved(id1, id2, weight);
+    }
+
+    return;
+}
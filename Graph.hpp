@@ -6,20 +6,21 @@
    graph element consists of (source-vertex, map of
    neighbor-vertices/distances from source-vertex).
    The pair above is encapsulated by
-   (std::string, class Edge) and represents an adjacency
+   (vertex ID, class Edge) and represents an adjacency
    list for immutable reference in the algorithm.
    
    Class Edge provides further
    encapsulation of (neighbor-vertices, distances from
    source-vertex).
    
-   The adjacency list is implemented in a map-of-maps
-   manner, using STL map, because it provides two benefits.
-   With this implementation of Dijkstra's algorithm,
-   enforcement of "no duplicates" is made simpler by STL map
-   functions. Also, because the look-up time for a map
-   element is less than that of a vector, a map is the
-   preferred sub-ADT for this algorithm.
+   Vertex labels are interned by class LabelTable when
+   addVertex() is called. Every internal structure works on
+   the resulting 32-bit IDs, and labels are only translated
+   at the public API boundary. The adjacency list is a
+   vector of Edge objects indexed by ID, and each Edge is an
+   STL map keyed by neighbor ID. The map keeps enforcement
+   of "no duplicates" simple, while the vector gives
+   constant-time access to any source-vertex.
       
    Details on the algorithm's implementation are provided
    below in shortestPath(), but the design operates by
@@ -30,7 +31,32 @@
    
    By the end of the algorithm, both the shortest distance
    and the path to obtain the shortest distance are made
-   available to the caller.                                  */
+   available to the caller.
+
+   Once a graph is fully built, freeze() converts it into a
+   FrozenGraph, a read-only snapshot with the same
+   shortestPath() contract and a cache-friendly layout.
+
+   Repeat queries can be answered by an optional LRU cache
+   of results (class ResultCache), off until
+   setCacheCapacity() is called. Every mutator bumps the
+   graph version, which retires all cached results at once.
+
+   Objects derived from GraphObserver can subscribe() to be
+   told about every mutation as it happens, which lets
+   class DynamicTree keep shortest path trees up to date.
+   Observers belong to one Graph object and are not copied
+   with it.
+
+   Every neighbor map, and the adjacency list itself, lives
+   in the graph's own arena, a pool resource (std::pmr)
+   which asks an upstream resource for large blocks and
+   carves map nodes out of them. Building a graph therefore
+   costs a handful of large allocations instead of one per
+   edge, and clear() hands all of them back at once. Nodes
+   freed by removals are recycled by the pool. Passing a
+   std::pmr::monotonic_buffer_resource as the upstream
+   turns those blocks into bump allocations as well.         */
 
 #ifndef GRAPH_HPP
 #define GRAPH_HPP
@@ -38,26 +64,95 @@
 #include "GraphBase.hpp"
 #include "Edge.hpp"
 #include "Vertex.hpp"
+#include "FrozenGraph.hpp"
+#include "LabelTable.hpp"
+#include "Dijkstra.hpp"
+#include "ResultCache.hpp"
+#include "GraphObserver.hpp"
 
 #include <string>
-#include <map>
+#include <vector>
+#include <cstddef>
+#include <memory_resource>
+
+enum class MutationKind{
+    AddVertex,      // Adds label1
+    RemoveVertex,   // Removes label1 and its edges
+    AddEdge,        // Adds the edge label1-label2 of weight
+    RemoveEdge      // Removes the edge label1-label2
+};
+
+struct Mutation{        // One item of Graph::applyBatch()
+    MutationKind kind;
+    std::string label1;
+    std::string label2;         // Ignored by vertex mutations
+    unsigned long weight = 0;   // Ignored by all but MutationKind::AddEdge
+};
+
+enum class MutationStatus{  // Outcome of one item of Graph::applyBatch()
+    Applied,
+    DuplicateVertex,    // AddVertex of a label that already exists
+    MissingVertex,      // A named vertex does not exist
+    SelfLoop,           // AddEdge with label1 == label2
+    DuplicateEdge,      // AddEdge of an edge that already exists
+    MissingEdge         // RemoveEdge of an edge that does not exist
+};
 
 class Graph : public GraphBase{
 public:
-    Graph(); // Default constructor included to fulfill course requirements
-    ~Graph(); // Default destructor included to fulfill course requirements. Calls clear()
+    Graph(); // Default constructor included to fulfill course requirements. The arena draws on the default memory resource
+    explicit Graph(std::pmr::memory_resource* upstream); // The arena draws its blocks from upstream, which must outlive the graph
+    Graph(const Graph& other);  // Copies vertices, edges and settings into a new arena on other's upstream. The copy starts with no observers
+    Graph& operator=(const Graph& other);   // Keeps this graph's observers, and reports the replacement to them as onCleared()
+    ~Graph(); // Default destructor included to fulfill course requirements. Calls clear(), then detaches every observer
     void addVertex(const std::string& label); // Checks for duplicates before adding a vertex
-    void removeVertex(std::string& label); // Removes all instances of a vertex, whether it is a source or neighbor vertex
+    void removeVertex(const std::string& label); // Removes all instances of a vertex, whether it is a source or neighbor vertex
     void addEdge(std::string label1, std::string label2, unsigned long weight); // Observes project guidelines, then adds an undirected edge 
     void removeEdge(std::string label1, std::string label2); // Removes an undirected edge. Not called in this Dijkstra algorithm implementation, however
-    unsigned long shortestPath(std::string startLabel, std::string endLabel, std::vector<std::string> &path); // Dijkstra's algorithm, calls reconstruct()
-    void clear(); // Clears map of all elements (all instances of all vertices)
+    std::vector<MutationStatus> applyBatch(const std::vector<Mutation>& batch); // Applies every valid item in order, skips the rest. Never throws for an invalid item
+    unsigned long shortestPath(const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path); // Dijkstra's algorithm, calls reconstruct()
+    void clear(); // Clears map of all elements (all instances of all vertices), then releases the arena
+    FrozenGraph freeze(VertexOrder order = VertexOrder::Original) const; // Builds a read-only CSR snapshot for query workloads which never mutate the graph. Hilbert is unavailable, since Graph holds no coordinates
+    void setQueueKind(QueueKind kind);  // Selects the priority queue used by shortestPath(). Defaults to QueueKind::Automatic
+    QueueKind getQueueKind() const;     // Returns the selected priority queue, before Automatic is resolved
+    void setSearchMode(SearchMode mode);    // Selects one- or two-sided search in shortestPath(). Defaults to SearchMode::Unidirectional
+    SearchMode getSearchMode() const;       // Returns the selected search mode
+    unsigned long getMaxWeight() const; // Largest weight ever passed to addEdge(), drives QueueKind::Automatic
+    void setCacheCapacity(std::size_t capacity);    // Results kept by shortestPath(). 0 (the default) disables the cache
+    const ResultCache& getCache() const;    // Capacity, size and hit/miss/eviction counters of the result cache
+    unsigned long getVersion() const;       // Bumped by every successful addVertex(), removeVertex(), addEdge(), removeEdge() and clear()
+    void subscribe(GraphObserver& observer);    // Reports every later mutation to observer. Subscribing twice has no effect
+    void unsubscribe(GraphObserver& observer);  // Stops the reports. Unknown observers are ignored
+    std::pmr::memory_resource* getUpstream() const; // Resource the arena draws its blocks from
+
+    template<typename Visit>
+    void forEachNeighbor(unsigned int id, Visit visit) const{   // Calls visit(neighbor ID, weight) for each neighbor of id. Used by dijkstra()
+        const auto& neighborMap = adjacencyList[id].get_neighbors();
+        for(auto it = neighborMap.begin(); it != neighborMap.end(); ++it){
+            visit(it->first, it->second);
+        }
+    }
 
 protected:  // Helper function, rebuilds shortest vector path from start to end
-    void reconstruct(std::vector<std::string> &fnlPath, const std::map<std::string, std::string>& fnlEdges, const std::string& start, const std::string& end); 
+    void reconstruct(std::vector<std::string> &fnlPath, const SearchLabels& fnlEdges, unsigned int start, unsigned int end); 
+    // Mutation helpers shared by the single mutators and applyBatch(). Callers validate first and bump version after
+    unsigned int placeVertex(const std::string& label);
+    void eraseVertex(unsigned int id);  // O(degree), thanks to undirected symmetry
+    void placeEdge(unsigned int id1, unsigned int id2, unsigned long weight);
+    void eraseEdge(unsigned int id1, unsigned int id2, unsigned long weight);
 
 private:
-    std::map<std::string, Edge> adjacencyList;
+    friend class DynamicTree;   // Reads labels and adjacencyList while repairing its trees
+
+    std::pmr::unsynchronized_pool_resource arena;   // Owns the adjacency list and every neighbor map. Declared first, so destroyed last
+    LabelTable labels;                  // (label/ID) interning table. IDs index adjacencyList
+    std::pmr::vector<Edge> adjacencyList;   // (index/value) = (source vertex ID/neighbors). Slots of removed vertices are empty
+    QueueKind queueKind = QueueKind::Automatic;
+    SearchMode searchMode = SearchMode::Unidirectional;
+    unsigned long maxWeight = 0;        // Upper bound on every edge weight. Not lowered by removals
+    unsigned long version = 0;          // Tags cached results. Entries from older versions are stale
+    ResultCache cache;                  // (start, end) IDs to (distance, path), least recently used evicted first
+    std::vector<GraphObserver*> observers;  // Notified in subscription order
 };
 
 
@@ -39,11 +39,11 @@ class GraphBase{
 public:
     GraphBase() = default;  // Not necessary, but fulfills course requirements. No source file, so set to default
     virtual ~GraphBase() = default; // Prevents call to incorrect destructor from derived class objects. No source file, so set to default
-    virtual void addVertex(std::string label) = 0; // Checks for duplicates before adding a vertex
-    virtual void removeVertex(std::string label) = 0; // Removes all source and neighbor vertex instances
+    virtual void addVertex(const std::string& label) = 0; // Checks for duplicates before adding a vertex
+    virtual void removeVertex(const std::string& label) = 0; // Removes all source and neighbor vertex instances
     virtual void addEdge(std::string label1, std::string label2, unsigned long weight) = 0; // Observes project guidelines, then adds edge 
     virtual void removeEdge(std::string label1, std::string label2) = 0; // Removes the undirected edge between two vertices
-    virtual unsigned long shortestPath(std::string startLabel, std::string endLabel, std::vector<std::string> &path) = 0; // Dijkstra's algorithm
+    virtual unsigned long shortestPath(const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path) = 0; // Dijkstra's algorithm
 };
 
 #endif
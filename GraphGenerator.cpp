@@ -0,0 +1,289 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines seeded generators of synthetic
+   FrozenGraph instances, used to benchmark the engines on
+   graphs of any size without input files. Four families
+   are offered:
+       Grid        4-neighbor lattice, uniform random weights.
+       Geometric   Random geometric graph: points scattered
+                   uniformly over a square, joined when closer
+                   than a radius chosen for the requested
+                   average degree. Weight is Euclidean length.
+       PowerLaw    Barabasi-Albert preferential attachment,
+                   so degrees follow a power law with a few
+                   very large hubs. Uniform random weights.
+       RoadLike    Lattice with jittered positions, randomly
+                   dropped streets, occasional diagonals, and
+                   every 32nd row and column a highway three
+                   times faster. Weight is travel time.
+
+   The same seed and vertex count always give the same
+   graph. Vertex i is labeled "i + 1", as GraphImporter
+   labels DIMACS vertices, and the edges are bulk-built by
+   GraphImporter::importEdges(). Every family except
+   PowerLaw also records a position per vertex, available
+   from coordinates() until the next call.                   */
+
+#include "GraphGenerator.hpp"
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace{
+    using RawEdge = GraphImporter::RawEdge;
+
+    constexpr double PI = 3.14159265358979323846;
+
+    /* Columns of a row-major lattice holding count vertices. */
+    unsigned int latticeWidth(unsigned int count){
+        return std::max(1u, static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<double>(count)))));
+    }
+
+    /* Euclidean length, rounded up so that no edge weighs 0. */
+    unsigned long length(const Coordinate& a, const Coordinate& b){
+        const double dx = static_cast<double>(a.x - b.x);
+        const double dy = static_cast<double>(a.y - b.y);
+        return std::max(1ul, static_cast<unsigned long>(std::ceil(std::sqrt(dx * dx + dy * dy))));
+    }
+}
+
+/* Workers are only used by the bulk build. Generation itself is sequential, so that it is reproducible. */
+GraphGenerator::GraphGenerator(unsigned long seed, unsigned int threadCount) : importer(threadCount), seed(seed){
+    // No logical implementation required
+}
+
+/* Redundant, but satisfies course requirement. */
+GraphGenerator::~GraphGenerator(){
+    clear();
+}
+
+/* Dispatches to the generator of family. */
+FrozenGraph GraphGenerator::generate(GraphFamily family, unsigned int vertexCount){
+    switch(family){
+    case GraphFamily::Grid:
+        return grid(vertexCount);
+    case GraphFamily::Geometric:
+        return geometric(vertexCount);
+    case GraphFamily::PowerLaw:
+        return powerLaw(vertexCount);
+    case GraphFamily::RoadLike:
+        return roadLike(vertexCount);
+    }
+
+    return grid(vertexCount);
+}
+
+/* Vertex i sits at row i / width and column i % width. It is joined to its right neighbor in the same row and to the
+   vertex below it, when those exist, so the last row may be shorter than the others.                                */
+FrozenGraph GraphGenerator::grid(unsigned int vertexCount, unsigned long maxWeight){
+    std::mt19937_64 random(seed);
+    std::uniform_int_distribution<unsigned long> weight(1, std::max(1ul, maxWeight));
+    const unsigned int width = latticeWidth(vertexCount);
+    std::vector<std::vector<RawEdge>> chunks(1);
+    chunks[0].reserve(2 * static_cast<std::size_t>(vertexCount));
+    coords.resize(vertexCount);
+    for(unsigned int v = 0; v < vertexCount; ++v){
+        coords[v] = {static_cast<long>(v % width), static_cast<long>(v / width)};
+        if(v % width + 1 < width && v + 1 < vertexCount){
+            chunks[0].push_back({v, v + 1, weight(random)});
+        }
+        if(static_cast<unsigned long>(v) + width < vertexCount){
+            chunks[0].push_back({v, v + width, weight(random)});
+        }
+    }
+
+    return importer.importEdges(vertexCount, chunks);
+}
+
+/* Points are binned into square cells one radius wide with a counting sort, so each point is only compared with the
+   points of its own cell and the 8 around it. A radius r over a square of side S gives an expected degree of
+   pi * r^2 * n / S^2, which is solved for r.                                                                        */
+FrozenGraph GraphGenerator::geometric(unsigned int vertexCount, double averageDegree){
+    std::mt19937_64 random(seed);
+    std::uniform_int_distribution<long> position(0, GEOMETRIC_SIDE - 1);
+    coords.resize(vertexCount);
+    for(unsigned int v = 0; v < vertexCount; ++v){
+        coords[v].x = position(random);
+        coords[v].y = position(random);
+    }
+
+    const double radius = GEOMETRIC_SIDE * std::sqrt(averageDegree / (PI * std::max(1u, vertexCount)));
+    const long cellsPerSide = std::max(1l, std::min(static_cast<long>(GEOMETRIC_SIDE / std::max(1.0, radius)), 1l << 15));
+    const long cellSide = (GEOMETRIC_SIDE + cellsPerSide - 1) / cellsPerSide;
+    auto cellOf = [&](long x, long y){
+        return static_cast<std::size_t>(y / cellSide) * cellsPerSide + x / cellSide;
+    };
+    std::vector<std::size_t> cellStart(static_cast<std::size_t>(cellsPerSide) * cellsPerSide + 1, 0);
+    for(unsigned int v = 0; v < vertexCount; ++v){
+        ++cellStart[cellOf(coords[v].x, coords[v].y) + 1];
+    }
+    for(std::size_t c = 1; c < cellStart.size(); ++c){
+        cellStart[c] += cellStart[c - 1];
+    }
+    std::vector<unsigned int> members(vertexCount);
+    {
+        std::vector<std::size_t> fill(cellStart.begin(), cellStart.end() - 1);
+        for(unsigned int v = 0; v < vertexCount; ++v){
+            members[fill[cellOf(coords[v].x, coords[v].y)]++] = v;
+        }
+    }
+
+    const double limit = radius * radius;
+    std::vector<std::vector<RawEdge>> chunks(1);
+    chunks[0].reserve(static_cast<std::size_t>(averageDegree * vertexCount / 2) + 1);
+    for(unsigned int v = 0; v < vertexCount; ++v){
+        const long cx = coords[v].x / cellSide;
+        const long cy = coords[v].y / cellSide;
+        for(long ny = std::max(0l, cy - 1); ny <= std::min(cellsPerSide - 1, cy + 1); ++ny){
+            for(long nx = std::max(0l, cx - 1); nx <= std::min(cellsPerSide - 1, cx + 1); ++nx){
+                const std::size_t cell = static_cast<std::size_t>(ny) * cellsPerSide + nx;
+                for(std::size_t i = cellStart[cell]; i < cellStart[cell + 1]; ++i){
+                    const unsigned int u = members[i];
+                    const double dx = static_cast<double>(coords[u].x - coords[v].x);
+                    const double dy = static_cast<double>(coords[u].y - coords[v].y);
+                    if(u > v && dx * dx + dy * dy <= limit){    // Each pair is seen from both ends, and kept from the lower
+                        chunks[0].push_back({v, u, length(coords[v], coords[u])});
+                    }
+                }
+            }
+        }
+    }
+
+    return importer.importEdges(vertexCount, chunks);
+}
+
+/* Starts from a clique of edgesPerVertex + 1 vertices. Every later vertex draws edgesPerVertex endpoints from the list
+   of all edge endpoints so far, which picks an existing vertex with probability proportional to its degree. A vertex
+   drawn twice yields a duplicate edge, which the bulk build merges, so a few vertices end up with fewer edges.        */
+FrozenGraph GraphGenerator::powerLaw(unsigned int vertexCount, unsigned int edgesPerVertex, unsigned long maxWeight){
+    std::mt19937_64 random(seed);
+    std::uniform_int_distribution<unsigned long> weight(1, std::max(1ul, maxWeight));
+    const unsigned int m = std::max(1u, edgesPerVertex);
+    const unsigned int core = std::min(vertexCount, m + 1);
+    std::vector<std::vector<RawEdge>> chunks(1);
+    chunks[0].reserve(static_cast<std::size_t>(vertexCount) * m);
+    std::vector<unsigned int> endpoints;    // Every vertex appears once per edge it has
+    endpoints.reserve(2 * static_cast<std::size_t>(vertexCount) * m);
+    for(unsigned int u = 0; u < core; ++u){
+        for(unsigned int v = u + 1; v < core; ++v){
+            chunks[0].push_back({u, v, weight(random)});
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+    for(unsigned int v = core; v < vertexCount; ++v){
+        const std::size_t drawn = endpoints.size();     // Edges of v itself are not candidates
+        for(unsigned int k = 0; k < m; ++k){
+            const unsigned int u = endpoints[std::uniform_int_distribution<std::size_t>(0, drawn - 1)(random)];
+            chunks[0].push_back({u, v, weight(random)});
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+    coords.clear();
+
+    return importer.importEdges(vertexCount, chunks);
+}
+
+/* Intersections form the same row-major lattice as grid(), each moved by up to 30% of the spacing in x and y. Streets
+   are dropped with probability 0.15 unless they belong to a highway, and a diagonal to the lower right neighbor is
+   added with probability 0.05. Weight is travel time: length on streets, a third of it on highways.                  */
+FrozenGraph GraphGenerator::roadLike(unsigned int vertexCount){
+    std::mt19937_64 random(seed);
+    std::uniform_int_distribution<long> jitter(-3 * ROAD_SPACING / 10, 3 * ROAD_SPACING / 10);
+    std::uniform_real_distribution<double> chance(0.0, 1.0);
+    const unsigned int width = latticeWidth(vertexCount);
+    coords.resize(vertexCount);
+    for(unsigned int v = 0; v < vertexCount; ++v){
+        coords[v].x = static_cast<long>(v % width) * ROAD_SPACING + jitter(random);
+        coords[v].y = static_cast<long>(v / width) * ROAD_SPACING + jitter(random);
+    }
+
+    std::vector<std::vector<RawEdge>> chunks(1);
+    chunks[0].reserve(2 * static_cast<std::size_t>(vertexCount));
+    auto street = [&](unsigned int u, unsigned int v, bool highway){
+        if(highway || chance(random) >= 0.15){
+            const unsigned long travel = length(coords[u], coords[v]);
+            chunks[0].push_back({u, v, highway ? std::max(1ul, travel / 3) : travel});
+        }
+    };
+    for(unsigned int v = 0; v < vertexCount; ++v){
+        const unsigned int row = v / width;
+        const unsigned int column = v % width;
+        if(column + 1 < width && v + 1 < vertexCount){
+            street(v, v + 1, row % 32 == 0);
+        }
+        if(static_cast<unsigned long>(v) + width < vertexCount){
+            street(v, v + width, column % 32 == 0);
+        }
+        if(column + 1 < width && static_cast<unsigned long>(v) + width + 1 < vertexCount && chance(random) < 0.05){
+            chunks[0].push_back({v, v + width + 1, length(coords[v], coords[v + width + 1])});
+        }
+    }
+
+    return importer.importEdges(vertexCount, chunks);
+}
+
+/* Read-only, so constant. */
+const std::vector<Coordinate>& GraphGenerator::coordinates() const{
+    return coords;
+}
+
+/* Applies to every later call. */
+void GraphGenerator::setSeed(unsigned long newSeed){
+    seed = newSeed;
+
+    return;
+}
+
+/* Read-only, so constant. */
+unsigned long GraphGenerator::getSeed() const{
+    return seed;
+}
+
+/* Abstracts the STL container clear() functions. */
+void GraphGenerator::clear(){
+    coords.clear();
+
+    return;
+}
+
+/* Short names used on the benchmark command line and in its JSON output. */
+std::string GraphGenerator::familyName(GraphFamily family){
+    switch(family){
+    case GraphFamily::Grid:
+        return "grid";
+    case GraphFamily::Geometric:
+        return "geometric";
+    case GraphFamily::PowerLaw:
+        return "powerlaw";
+    case GraphFamily::RoadLike:
+        return "road";
+    }
+
+    return "grid";
+}
+
+/* Inverse of familyName(). */
+GraphFamily GraphGenerator::parseFamily(const std::string& name){
+    if(name == "grid"){
+        return GraphFamily::Grid;
+    }
+    if(name == "geometric"){
+        return GraphFamily::Geometric;
+    }
+    if(name == "powerlaw"){
+        return GraphFamily::PowerLaw;
+    }
+    if(name == "road"){
+        return GraphFamily::RoadLike;
+    }
+
+    throw std::invalid_argument("[ERROR] Unknown graph family \"" + name + "\". Unable to complete request.");
+}
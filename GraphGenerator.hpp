@@ -0,0 +1,71 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares seeded generators of synthetic
+   FrozenGraph instances, used to benchmark the engines on
+   graphs of any size without input files. Four families
+   are offered:
+       Grid        4-neighbor lattice, uniform random weights.
+       Geometric   Random geometric graph: points scattered
+                   uniformly over a square, joined when closer
+                   than a radius chosen for the requested
+                   average degree. Weight is Euclidean length.
+       PowerLaw    Barabasi-Albert preferential attachment,
+                   so degrees follow a power law with a few
+                   very large hubs. Uniform random weights.
+       RoadLike    Lattice with jittered positions, randomly
+                   dropped streets, occasional diagonals, and
+                   every 32nd row and column a highway three
+                   times faster. Weight is travel time.
+
+   The same seed and vertex count always give the same
+   graph. Vertex i is labeled "i + 1", as GraphImporter
+   labels DIMACS vertices, and the edges are bulk-built by
+   GraphImporter::importEdges(). Every family except
+   PowerLaw also records a position per vertex, available
+   from coordinates() until the next call.                   */
+
+#ifndef GRAPHGENERATOR_HPP
+#define GRAPHGENERATOR_HPP
+
+#include "FrozenGraph.hpp"
+#include "GraphImporter.hpp"
+
+#include <string>
+#include <vector>
+
+enum class GraphFamily{
+    Grid,       // 4-neighbor lattice
+    Geometric,  // Random geometric graph
+    PowerLaw,   // Barabasi-Albert preferential attachment
+    RoadLike    // Jittered lattice with highways
+};
+
+class GraphGenerator{
+public:
+    static constexpr long GEOMETRIC_SIDE = 1000000; // Side of the square that Geometric points are scattered over
+    static constexpr long ROAD_SPACING = 1000;      // Distance between neighboring RoadLike intersections, before jitter
+
+    GraphGenerator(unsigned long seed = 1, unsigned int threadCount = 0);  // threadCount 0 means one per hardware thread
+    ~GraphGenerator(); // Default destructor included to fulfill course requirements. Calls clear()
+    FrozenGraph generate(GraphFamily family, unsigned int vertexCount);    // Calls one of the four below with its default parameters
+    FrozenGraph grid(unsigned int vertexCount, unsigned long maxWeight = 100);  // Row-major lattice, about sqrt(vertexCount) wide
+    FrozenGraph geometric(unsigned int vertexCount, double averageDegree = 6.0);
+    FrozenGraph powerLaw(unsigned int vertexCount, unsigned int edgesPerVertex = 3, unsigned long maxWeight = 100);
+    FrozenGraph roadLike(unsigned int vertexCount);
+    const std::vector<Coordinate>& coordinates() const; // (index/value) = (dense ID/position) of the last generated graph. Empty after powerLaw()
+    void setSeed(unsigned long newSeed);
+    unsigned long getSeed() const;
+    void clear();   // Forgets the coordinates
+
+    static std::string familyName(GraphFamily family);  // "grid", "geometric", "powerlaw" or "road"
+    static GraphFamily parseFamily(const std::string& name);    // Inverse of familyName(). Throws if unknown
+
+private:
+    GraphImporter importer;
+    unsigned long seed;
+    std::vector<Coordinate> coords;
+};
+
+#endif
@@ -0,0 +1,562 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a bulk importer which builds a
+   FrozenGraph straight from a text edge list, without one
+   Graph::addVertex()/addEdge() call per element. Two
+   formats are read:
+       DIMACS  .gr lines "a u v w" (arc from u to v of weight
+               w, vertices numbered 1 to n as declared by
+               "p sp n m"), and optionally .co lines
+               "v id x y" holding vertex coordinates.
+       CSV     lines "source,target,weight", where source and
+               target are arbitrary labels. A first line
+               whose weight is not a number is taken as a
+               header and skipped.
+
+   The file is mapped into memory and cut into chunks at
+   line boundaries. The chunks are parsed in parallel on a
+   ThreadPool by a hand-written number and field scanner
+   that never allocates per line; CSV labels stay pointers
+   into the mapped file until they are interned. The
+   adjacency is then bulk-built in CSR form: edges are
+   grouped by their lower endpoint with a counting pass,
+   each group is sorted and cleaned of duplicates in
+   parallel, and the CSR arrays are filled in one pass.
+
+   Edges are undirected, as in Graph. A pair of vertices
+   listed more than once is handled by DuplicatePolicy.
+   DIMACS lists every road in both directions, so there the
+   reverse arc of an arc is not a duplicate; both become one
+   edge weighing the smaller of the two. Self-loops are
+   dropped, or rejected under DuplicatePolicy::Error.
+
+   importEdges() runs the same bulk build on edge lists
+   that are already in memory, such as the synthetic graphs
+   of class GraphGenerator.
+
+   setVertexOrder() makes importDimacs() and importCsv()
+   finish with FrozenGraph::reorder(). Hilbert order uses
+   the .co coordinates, which are renumbered along with the
+   vertices.                                                 */
+
+#include "GraphImporter.hpp"
+#include "LabelTable.hpp"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <climits>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace{
+    const std::size_t CHUNKS_PER_WORKER = 4;    // Spare chunks let idle workers steal from slow ones
+
+    /* Read-only mapping of a whole text file, released when it goes out of scope. */
+    class MappedText{
+    public:
+        explicit MappedText(const std::string& fileName){
+            const int descriptor = ::open(fileName.c_str(), O_RDONLY);
+            if(descriptor < 0){
+                throw std::runtime_error("[ERROR] Unable to open input file for reading. Unable to complete request.");
+            }
+            struct stat status;
+            if(fstat(descriptor, &status) != 0){
+                ::close(descriptor);
+                throw std::runtime_error("[ERROR] Unable to read input file size. Unable to complete request.");
+            }
+            size = status.st_size;
+            if(size > 0){
+                mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                if(mapping == MAP_FAILED){
+                    ::close(descriptor);
+                    throw std::runtime_error("[ERROR] Unable to map input file. Unable to complete request.");
+                }
+                madvise(mapping, size, MADV_SEQUENTIAL);
+            }
+            ::close(descriptor);
+        }
+        ~MappedText(){
+            if(mapping != nullptr){
+                munmap(mapping, size);
+            }
+        }
+        MappedText(const MappedText&) = delete;
+        MappedText& operator=(const MappedText&) = delete;
+        const char* begin() const{
+            return static_cast<const char*>(mapping);
+        }
+        const char* end() const{
+            return begin() + size;
+        }
+
+    private:
+        void* mapping = nullptr;
+        std::size_t size = 0;
+    };
+
+    /* Cuts [begin, end) into about pieces ranges, moving every cut forward to just after a newline. */
+    std::vector<std::pair<const char*, const char*>> splitLines(const char* begin, const char* end, std::size_t pieces){
+        std::vector<std::pair<const char*, const char*>> ranges;
+        const std::size_t step = std::max<std::size_t>(1, (end - begin) / std::max<std::size_t>(1, pieces));
+        const char* from = begin;
+        while(from < end){
+            const char* to = end - from > static_cast<std::ptrdiff_t>(step) ? from + step : end;
+            const char* newline = static_cast<const char*>(std::memchr(to - 1, '\n', end - (to - 1)));
+            to = newline != nullptr ? newline + 1 : end;
+            ranges.push_back({from, to});
+            from = to;
+        }
+
+        return ranges;
+    }
+
+    /* End of the line starting at p: its newline, or end. */
+    const char* lineEnd(const char* p, const char* end){
+        const char* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+
+        return newline != nullptr ? newline : end;
+    }
+
+    /* Skips spaces, tabs and the carriage return of a CRLF line. */
+    void skipBlanks(const char*& p, const char* end){
+        while(p < end && (*p == ' ' || *p == '\t' || *p == '\r')){
+            ++p;
+        }
+
+        return;
+    }
+
+    /* Reads a decimal number after optional blanks. Fails on no digits or on overflow. */
+    bool readUnsigned(const char*& p, const char* end, unsigned long& value){
+        skipBlanks(p, end);
+        if(p == end || *p < '0' || *p > '9'){
+            return false;
+        }
+        value = 0;
+        while(p < end && *p >= '0' && *p <= '9'){
+            const unsigned long digit = *p - '0';
+            if(value > (ULONG_MAX - digit) / 10){
+                return false;
+            }
+            value = value * 10 + digit;
+            ++p;
+        }
+
+        return true;
+    }
+
+    /* Same as above, with an optional minus sign. */
+    bool readSigned(const char*& p, const char* end, long& value){
+        skipBlanks(p, end);
+        const bool negative = p < end && *p == '-';
+        if(negative){
+            ++p;
+        }
+        unsigned long magnitude;
+        if(!readUnsigned(p, end, magnitude) || magnitude > static_cast<unsigned long>(LONG_MAX)){
+            return false;
+        }
+        value = negative ? -static_cast<long>(magnitude) : static_cast<long>(magnitude);
+
+        return true;
+    }
+
+    /* True if only blanks are left on the line. */
+    bool atLineEnd(const char* p, const char* end){
+        skipBlanks(p, end);
+
+        return p == end;
+    }
+
+    /* Reads one CSV field up to the next comma (or the end of the line), without its surrounding blanks. */
+    bool readField(const char*& p, const char* end, const char*& field, std::size_t& length){
+        skipBlanks(p, end);
+        field = p;
+        const char* comma = p < end ? static_cast<const char*>(std::memchr(p, ',', end - p)) : nullptr;
+        const char* last = comma != nullptr ? comma : end;
+        while(last > field && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r')){
+            --last;
+        }
+        length = last - field;
+        p = comma != nullptr ? comma + 1 : end;
+
+        return comma != nullptr;
+    }
+
+    /* Per-chunk bookkeeping for error messages. Lines are counted so that a failing chunk can name the global line. */
+    struct ChunkStatus{
+        std::size_t lines = 0;      // Lines read so far
+        std::size_t badLine = 0;    // Line of the first malformed line within the chunk, 0 if none
+    };
+
+    /* Throws for the first malformed line of the file, if any. Every chunk before the failing one was read in full. */
+    void checkChunks(const std::vector<ChunkStatus>& status, const char* fileKind){
+        std::size_t before = 0;
+        for(auto it = status.begin(); it != status.end(); ++it){
+            if(it->badLine != 0){
+                throw std::runtime_error("[ERROR] Malformed line " + std::to_string(before + it->badLine) + " in " + fileKind + ". Unable to complete request.");
+            }
+            before += it->lines;
+        }
+
+        return;
+    }
+
+    struct GroupEntry{  // An edge stored under its lower endpoint
+        unsigned int other;     // Higher endpoint
+        unsigned int reversed;  // 1 if the line listed the higher endpoint first
+        unsigned long weight;
+    };
+}
+
+/* The pool is started once and reused by every import. */
+GraphImporter::GraphImporter(unsigned int threadCount, DuplicatePolicy policy) : pool(new ThreadPool(threadCount)), policy(policy){
+    // No logical implementation required
+}
+
+/* Redundant, but satisfies course requirement. */
+GraphImporter::~GraphImporter(){
+    clear();
+}
+
+/* Each chunk collects its arcs, the vertex count of a "p" line if it holds one, and its line count. Only the vertex
+   labels "1" to "n" are interned, in order, so dense ID i belongs to DIMACS vertex i + 1. Coordinates, if requested,
+   are parsed the same way and stored by dense ID. A vertex order other than Original is applied last, and the
+   coordinates are moved to the new IDs.                                                                            */
+FrozenGraph GraphImporter::importDimacs(const std::string& graphFile, const std::string& coordinateFile){
+    unsigned long declared = 0;
+    std::vector<std::vector<RawEdge>> chunks;
+    {
+        MappedText text(graphFile);
+        const auto ranges = splitLines(text.begin(), text.end(), pool->size() * CHUNKS_PER_WORKER);
+        chunks.resize(ranges.size());
+        std::vector<ChunkStatus> status(ranges.size());
+        std::vector<unsigned long> declaredIn(ranges.size(), 0);
+        pool->parallelFor(ranges.size(), [&](std::size_t i, unsigned int){
+            const char* end = ranges[i].second;
+            for(const char* p = ranges[i].first; p < end; ){
+                const char* eol = lineEnd(p, end);
+                ++status[i].lines;
+                skipBlanks(p, eol);
+                bool valid = true;
+                if(p < eol && *p == 'a'){
+                    unsigned long u, v, w;
+                    ++p;
+                    valid = readUnsigned(p, eol, u) && readUnsigned(p, eol, v) && readUnsigned(p, eol, w) && atLineEnd(p, eol)
+                         && u >= 1 && v >= 1 && u <= UINT_MAX - 1 && v <= UINT_MAX - 1;
+                    if(valid){
+                        chunks[i].push_back({static_cast<unsigned int>(u - 1), static_cast<unsigned int>(v - 1), w});
+                    }
+                }
+                else if(p < eol && *p == 'p'){
+                    unsigned long n, m;
+                    ++p;
+                    skipBlanks(p, eol);
+                    valid = eol - p > 2 && p[0] == 's' && p[1] == 'p';
+                    p += 2;
+                    valid = valid && readUnsigned(p, eol, n) && readUnsigned(p, eol, m) && atLineEnd(p, eol) && n < LabelTable::NO_ID;
+                    if(valid){
+                        declaredIn[i] = n;
+                        chunks[i].reserve(m / ranges.size());
+                    }
+                }
+                else{
+                    valid = p == eol || *p == 'c';  // Blank lines and comments
+                }
+                if(!valid){
+                    status[i].badLine = status[i].lines;
+                    return;
+                }
+                p = eol + 1;
+            }
+        });
+        checkChunks(status, "graph file");
+        declared = *std::max_element(declaredIn.begin(), declaredIn.end());
+    }
+    if(declared == 0){
+        throw std::runtime_error("[ERROR] Graph file has no \"p sp\" line. Unable to complete request.");
+    }
+
+    FrozenGraph graph;
+    for(unsigned long v = 1; v <= declared; ++v){
+        graph.labels.intern(std::to_string(v));
+    }
+    build(graph, chunks, true);
+
+    coords.clear();
+    if(!coordinateFile.empty()){
+        MappedText text(coordinateFile);
+        const auto ranges = splitLines(text.begin(), text.end(), pool->size() * CHUNKS_PER_WORKER);
+        std::vector<std::vector<std::pair<unsigned long, Coordinate>>> parsed(ranges.size());
+        std::vector<ChunkStatus> status(ranges.size());
+        pool->parallelFor(ranges.size(), [&](std::size_t i, unsigned int){
+            const char* end = ranges[i].second;
+            for(const char* p = ranges[i].first; p < end; ){
+                const char* eol = lineEnd(p, end);
+                ++status[i].lines;
+                skipBlanks(p, eol);
+                bool valid = p == eol || *p == 'c' || *p == 'p';   // The "p aux sp co n" line carries nothing needed here
+                if(p < eol && *p == 'v'){
+                    unsigned long id;
+                    Coordinate position;
+                    ++p;
+                    valid = readUnsigned(p, eol, id) && readSigned(p, eol, position.x) && readSigned(p, eol, position.y) && atLineEnd(p, eol)
+                         && id >= 1 && id <= declared;
+                    if(valid){
+                        parsed[i].push_back({id - 1, position});
+                    }
+                }
+                if(!valid){
+                    status[i].badLine = status[i].lines;
+                    return;
+                }
+                p = eol + 1;
+            }
+        });
+        checkChunks(status, "coordinate file");
+        coords.assign(declared, Coordinate{0, 0});
+        for(auto it = parsed.begin(); it != parsed.end(); ++it){
+            for(auto pt = it->begin(); pt != it->end(); ++pt){
+                coords[pt->first] = pt->second;
+            }
+        }
+    }
+    if(order != VertexOrder::Original){
+        const std::vector<unsigned int> newId = graph.reorder(order, coords);  // Throws for Hilbert without coordinates
+        std::vector<Coordinate> moved(coords.size());
+        for(std::size_t v = 0; v < coords.size(); ++v){
+            moved[newId[v]] = coords[v];
+        }
+        coords.swap(moved);
+    }
+
+    return graph;
+}
+
+/* Chunks are parsed in parallel into (label, label, weight) triples which still point into the mapped file. Labels
+   are then interned in file order, on one thread, reusing a single string buffer for lookups so that labels seen
+   before cost no allocation. The mapping must outlive the interning, so both happen inside one scope.              */
+FrozenGraph GraphImporter::importCsv(const std::string& fileName){
+    struct LabeledEdge{
+        const char* source;
+        std::size_t sourceLength;
+        const char* target;
+        std::size_t targetLength;
+        unsigned long weight;
+    };
+
+    FrozenGraph graph;
+    std::vector<std::vector<RawEdge>> chunks;
+    {
+        MappedText text(fileName);
+        const auto ranges = splitLines(text.begin(), text.end(), pool->size() * CHUNKS_PER_WORKER);
+        std::vector<std::vector<LabeledEdge>> parsed(ranges.size());
+        std::vector<ChunkStatus> status(ranges.size());
+        pool->parallelFor(ranges.size(), [&](std::size_t i, unsigned int){
+            const char* end = ranges[i].second;
+            for(const char* p = ranges[i].first; p < end; ){
+                const char* eol = lineEnd(p, end);
+                ++status[i].lines;
+                const bool header = i == 0 && status[i].lines == 1;
+                const char* blank = p;
+                if(atLineEnd(blank, eol)){  // Blank line
+                    p = eol + 1;
+                    continue;
+                }
+                LabeledEdge edge;
+                bool valid = readField(p, eol, edge.source, edge.sourceLength) && readField(p, eol, edge.target, edge.targetLength);
+                valid = valid && readUnsigned(p, eol, edge.weight) && atLineEnd(p, eol) && edge.sourceLength > 0 && edge.targetLength > 0;
+                if(valid){
+                    parsed[i].push_back(edge);
+                }
+                else if(!header){
+                    status[i].badLine = status[i].lines;
+                    return;
+                }
+                p = eol + 1;
+            }
+        });
+        checkChunks(status, "CSV file");
+
+        chunks.resize(parsed.size());
+        std::string scratch;
+        for(std::size_t i = 0; i < parsed.size(); ++i){
+            chunks[i].reserve(parsed[i].size());
+            for(auto it = parsed[i].begin(); it != parsed[i].end(); ++it){
+                scratch.assign(it->source, it->sourceLength);
+                const unsigned int source = graph.labels.intern(scratch);
+                scratch.assign(it->target, it->targetLength);
+                const unsigned int target = graph.labels.intern(scratch);
+                chunks[i].push_back({source, target, it->weight});
+            }
+            std::vector<LabeledEdge>().swap(parsed[i]); // Release each chunk as soon as it is interned
+        }
+    }
+    build(graph, chunks, false);
+    if(order != VertexOrder::Original){
+        graph.reorder(order);   // Throws for Hilbert, since CSV files carry no coordinates
+    }
+
+    return graph;
+}
+
+/* Takes effect on the next import. */
+void GraphImporter::setDuplicatePolicy(DuplicatePolicy newPolicy){
+    policy = newPolicy;
+
+    return;
+}
+
+/* Read-only, so constant. */
+DuplicatePolicy GraphImporter::getDuplicatePolicy() const{
+    return policy;
+}
+
+/* Takes effect on the next importDimacs() or importCsv(). */
+void GraphImporter::setVertexOrder(VertexOrder newOrder){
+    order = newOrder;
+
+    return;
+}
+
+/* Read-only, so constant. */
+VertexOrder GraphImporter::getVertexOrder() const{
+    return order;
+}
+
+/* Read-only, so constant. */
+const std::vector<Coordinate>& GraphImporter::coordinates() const{
+    return coords;
+}
+
+/* Read-only, so constant. */
+unsigned int GraphImporter::threadCount() const{
+    return pool->size();
+}
+
+/* Abstracts the STL vector clear() function. */
+void GraphImporter::clear(){
+    coords.clear();
+
+    return;
+}
+
+/* Each chunk is one list of undirected edges, and every edge is listed once. Vertices are labeled like DIMACS ones,
+   so a generated graph can be written out as a .gr file and read back with the same labels. Coordinates are left
+   untouched.                                                                                                     */
+FrozenGraph GraphImporter::importEdges(unsigned int vertexCount, const std::vector<std::vector<RawEdge>>& chunks){
+    FrozenGraph graph;
+    for(unsigned long v = 1; v <= vertexCount; ++v){
+        graph.labels.intern(std::to_string(v));
+    }
+    build(graph, chunks, false);
+
+    return graph;
+}
+
+/* Builds the CSR arrays of graph, whose labels are already interned.
+       [a] Count the edges of each lower endpoint, then place every edge in its group, keeping file order.
+       [b] In parallel, sort each group by higher endpoint (stably, so file order survives among equal pairs), and
+           collapse every run of equal pairs into one edge under the duplicate policy. With bothDirections, a run
+           only holds a duplicate if one direction appears more than once.
+       [c] Count the degree of every vertex, and fill each edge into the lists of both endpoints. Groups are visited
+           in ascending order, so every neighbor list comes out sorted, just like Graph::freeze() produces.       */
+void GraphImporter::build(FrozenGraph& graph, const std::vector<std::vector<RawEdge>>& chunks, bool bothDirections){
+    const unsigned int n = graph.labels.size();
+    std::vector<std::size_t> groupStart(n + 1, 0);  // [a]
+    for(auto ct = chunks.begin(); ct != chunks.end(); ++ct){
+        for(auto it = ct->begin(); it != ct->end(); ++it){
+            if(it->source >= n || it->target >= n){
+                throw std::out_of_range("[ERROR] Edge refers to an undeclared vertex. Unable to complete request.");
+            }
+            if(it->source == it->target){
+                if(policy == DuplicatePolicy::Error){
+                    throw std::invalid_argument("[ERROR] Program does not support self-loop condition. Unable to complete request.");
+                }
+                continue;
+            }
+            ++groupStart[std::min(it->source, it->target) + 1];
+        }
+    }
+    for(unsigned int v = 0; v < n; ++v){
+        groupStart[v + 1] += groupStart[v];
+    }
+    std::vector<GroupEntry> grouped(groupStart[n]);
+    {
+        std::vector<std::size_t> fill(groupStart.begin(), groupStart.end() - 1);
+        for(auto ct = chunks.begin(); ct != chunks.end(); ++ct){
+            for(auto it = ct->begin(); it != ct->end(); ++it){
+                if(it->source != it->target){
+                    const unsigned int lower = std::min(it->source, it->target);
+                    grouped[fill[lower]++] = {std::max(it->source, it->target), it->source > it->target ? 1u : 0u, it->weight};
+                }
+            }
+        }
+    }
+
+    std::vector<std::size_t> kept(n, 0);    // [b]
+    pool->parallelFor(n, [&](std::size_t lower, unsigned int){
+        const auto first = grouped.begin() + groupStart[lower];
+        const auto last = grouped.begin() + groupStart[lower + 1];
+        std::stable_sort(first, last, [](const GroupEntry& a, const GroupEntry& b){
+            return a.other < b.other;
+        });
+        auto out = first;
+        for(auto run = first; run != last; ){
+            auto runEnd = run;
+            std::size_t forward = 0, backward = 0;
+            unsigned long weight = run->weight;
+            for(; runEnd != last && runEnd->other == run->other; ++runEnd){
+                (runEnd->reversed ? backward : forward) += 1;
+                weight = std::min(weight, runEnd->weight);
+            }
+            const bool duplicate = bothDirections ? (forward > 1 || backward > 1) : (runEnd - run > 1);
+            if(duplicate && policy == DuplicatePolicy::Error){
+                throw std::logic_error("[ERROR] Edge between " + graph.labels.label(lower) + " and " + graph.labels.label(run->other) + " is listed more than once. Unable to complete request.");
+            }
+            if(duplicate && policy == DuplicatePolicy::KeepFirst){
+                weight = run->weight;
+            }
+            *out++ = {run->other, 0, weight};
+            run = runEnd;
+        }
+        kept[lower] = out - first;
+    });
+
+    graph.offsets.assign(n + 1, 0); // [c]
+    for(unsigned int lower = 0; lower < n; ++lower){
+        for(std::size_t i = groupStart[lower]; i < groupStart[lower] + kept[lower]; ++i){
+            ++graph.offsets[lower + 1];
+            ++graph.offsets[grouped[i].other + 1];
+        }
+    }
+    for(unsigned int v = 0; v < n; ++v){
+        graph.offsets[v + 1] += graph.offsets[v];
+    }
+    graph.targets.resize(graph.offsets[n]);
+    graph.weights.resize(graph.offsets[n]);
+    graph.maxWeight = 0;
+    std::vector<std::size_t> fill(graph.offsets.begin(), graph.offsets.end() - 1);
+    for(unsigned int lower = 0; lower < n; ++lower){
+        for(std::size_t i = groupStart[lower]; i < groupStart[lower] + kept[lower]; ++i){
+            const GroupEntry& edge = grouped[i];
+            graph.targets[fill[lower]] = edge.other;
+            graph.weights[fill[lower]++] = edge.weight;
+            graph.targets[fill[edge.other]] = lower;
+            graph.weights[fill[edge.other]++] = edge.weight;
+            graph.maxWeight = std::max(graph.maxWeight, edge.weight);
+        }
+    }
+
+    return;
+}
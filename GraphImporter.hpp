@@ -0,0 +1,91 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a bulk importer which builds a
+   FrozenGraph straight from a text edge list, without one
+   Graph::addVertex()/addEdge() call per element. Two
+   formats are read:
+       DIMACS  .gr lines "a u v w" (arc from u to v of weight
+               w, vertices numbered 1 to n as declared by
+               "p sp n m"), and optionally .co lines
+               "v id x y" holding vertex coordinates.
+       CSV     lines "source,target,weight", where source and
+               target are arbitrary labels. A first line
+               whose weight is not a number is taken as a
+               header and skipped.
+
+   The file is mapped into memory and cut into chunks at
+   line boundaries. The chunks are parsed in parallel on a
+   ThreadPool by a hand-written number and field scanner
+   that never allocates per line; CSV labels stay pointers
+   into the mapped file until they are interned. The
+   adjacency is then bulk-built in CSR form: edges are
+   grouped by their lower endpoint with a counting pass,
+   each group is sorted and cleaned of duplicates in
+   parallel, and the CSR arrays are filled in one pass.
+
+   Edges are undirected, as in Graph. A pair of vertices
+   listed more than once is handled by DuplicatePolicy.
+   DIMACS lists every road in both directions, so there the
+   reverse arc of an arc is not a duplicate; both become one
+   edge weighing the smaller of the two. Self-loops are
+   dropped, or rejected under DuplicatePolicy::Error.
+
+   importEdges() runs the same bulk build on edge lists
+   that are already in memory, such as the synthetic graphs
+   of class GraphGenerator.
+
+   setVertexOrder() makes importDimacs() and importCsv()
+   finish with FrozenGraph::reorder(). Hilbert order uses
+   the .co coordinates, which are renumbered along with the
+   vertices.                                                 */
+
+#ifndef GRAPHIMPORTER_HPP
+#define GRAPHIMPORTER_HPP
+
+#include "FrozenGraph.hpp"
+#include "ThreadPool.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+enum class DuplicatePolicy{
+    KeepMin,    // Keep the smallest weight listed for the pair
+    KeepFirst,  // Keep the weight listed first in the file
+    Error       // Throw, naming the pair
+};
+
+class GraphImporter{
+public:
+    struct RawEdge{     // One parsed line or generated edge, endpoints as dense IDs
+        unsigned int source;
+        unsigned int target;
+        unsigned long weight;
+    };
+
+    GraphImporter(unsigned int threadCount = 0, DuplicatePolicy policy = DuplicatePolicy::KeepMin);   // threadCount 0 means one per hardware thread
+    ~GraphImporter(); // Default destructor included to fulfill course requirements. Calls clear()
+    FrozenGraph importDimacs(const std::string& graphFile, const std::string& coordinateFile = ""); // Vertex i + 1 of the file gets label "i + 1", and dense ID i unless a vertex order is set
+    FrozenGraph importCsv(const std::string& fileName);     // Dense IDs follow the first appearance of each label
+    FrozenGraph importEdges(unsigned int vertexCount, const std::vector<std::vector<RawEdge>>& chunks); // Vertex i gets label "i + 1" and dense ID i. Never reordered, so IDs match chunks
+    void setDuplicatePolicy(DuplicatePolicy newPolicy);
+    DuplicatePolicy getDuplicatePolicy() const;
+    void setVertexOrder(VertexOrder newOrder);  // Renumbering applied by importDimacs() and importCsv(). Defaults to VertexOrder::Original
+    VertexOrder getVertexOrder() const;
+    const std::vector<Coordinate>& coordinates() const;     // (index/value) = (dense ID/position) of the last importDimacs() with a .co file
+    unsigned int threadCount() const;   // Number of workers
+    void clear();   // Forgets the coordinates
+
+protected:
+    void build(FrozenGraph& graph, const std::vector<std::vector<RawEdge>>& chunks, bool bothDirections); // Bulk CSR build of graph, whose labels are interned, with duplicate handling
+
+private:
+    std::unique_ptr<ThreadPool> pool;
+    DuplicatePolicy policy;
+    VertexOrder order = VertexOrder::Original;
+    std::vector<Coordinate> coords; // (index/value) = (dense ID/position)
+};
+
+#endif
@@ -0,0 +1,39 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares an interface for objects which
+   follow the mutations of a Graph. An observer is passed
+   to Graph::subscribe(), and from then on the graph calls
+   one of the functions below after each successful
+   addVertex(), removeVertex(), addEdge(), removeEdge() and
+   clear(). Every call is made once the graph already
+   reflects the change, so an observer may read the graph
+   from inside it. Vertices are reported by their Graph ID.
+
+   removeVertex() reports each incident edge through
+   onEdgeRemoved() before it reports the vertex itself
+   through onVertexRemoved(). By then every one of those
+   edges is gone, and the vertex's ID has been released.
+
+   A callback must not subscribe or unsubscribe observers,
+   nor mutate the graph it observes. When the graph is
+   destroyed, onDetached() is the last call an observer
+   receives from it.                                          */
+
+#ifndef GRAPHOBSERVER_HPP
+#define GRAPHOBSERVER_HPP
+
+class GraphObserver{
+public:
+    GraphObserver() = default;  // Not necessary, but fulfills course requirements. No source file, so set to default
+    virtual ~GraphObserver() = default; // Prevents call to incorrect destructor from derived class objects. No source file, so set to default
+    virtual void onVertexAdded(unsigned int vertex) = 0;    // vertex may reuse the ID of a removed vertex
+    virtual void onVertexRemoved(unsigned int vertex) = 0;  // Follows onEdgeRemoved() for every edge the vertex had
+    virtual void onEdgeAdded(unsigned int vertex1, unsigned int vertex2, unsigned long weight) = 0;
+    virtual void onEdgeRemoved(unsigned int vertex1, unsigned int vertex2, unsigned long weight) = 0;
+    virtual void onCleared() = 0;   // Every vertex and edge is gone, and IDs restart from 0
+    virtual void onDetached() = 0;  // The graph is being destroyed. No further calls will come from it
+};
+
+#endif
@@ -0,0 +1,144 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a StatsSink which aggregates
+   per-query SearchStats into distributions, one set per
+   engine. Each metric keeps its count, sum and maximum,
+   plus a histogram with power-of-two buckets: bucket k
+   holds values from 2^(k-1) to 2^k - 1, and bucket 0 holds
+   0. Memory stays constant however many queries are
+   recorded, and percentiles are exact to within a factor
+   of two, which is enough to tell a typical query from a
+   slow one. Times are kept in microseconds.
+
+   record() takes a mutex, so the sink is safe to share by
+   every thread. write() prints the whole aggregate as one
+   JSON object keyed by engine name.                          */
+
+#include "HistogramSink.hpp"
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <ostream>
+
+namespace{
+    /* Bucket of value: 0 for 0, otherwise the position of its highest set bit, plus one. */
+    unsigned int bucketOf(unsigned long value){
+        return value == 0 ? 0 : 64 - __builtin_clzl(value);
+    }
+
+    /* Largest value that falls into bucket. */
+    unsigned long bucketCeiling(unsigned int bucket){
+        return bucket == 0 ? 0 : bucket >= 64 ? ~0ul : (1ul << bucket) - 1;
+    }
+}
+
+/* Constant definition, needed by code which takes the array's address. */
+constexpr const char* HistogramSink::METRIC_NAMES[HistogramSink::METRIC_COUNT];
+
+/* Defined solely for course requirement. */
+HistogramSink::HistogramSink(){
+    // No logical implementation required
+}
+
+/* Redundant, but satisfies course requirement. */
+HistogramSink::~HistogramSink(){
+    clear();
+}
+
+/* Nanosecond times are turned into microseconds before they are bucketed. */
+void HistogramSink::record(const SearchStats& stats){
+    const unsigned long values[METRIC_COUNT] = {
+        stats.settled, stats.relaxations, stats.pushes, stats.pops, stats.stale, stats.peakQueue,
+        static_cast<unsigned long>(stats.phaseNs[SearchStats::Init] / 1000),
+        static_cast<unsigned long>(stats.phaseNs[SearchStats::Search] / 1000),
+        static_cast<unsigned long>(stats.phaseNs[SearchStats::Reconstruct] / 1000),
+        static_cast<unsigned long>(stats.totalNs / 1000)
+    };
+    std::lock_guard<std::mutex> guard(lock);
+    Summary& summary = engines[stats.engine];
+    ++summary.count;
+    for(unsigned int m = 0; m < METRIC_COUNT; ++m){
+        Distribution& distribution = summary.metrics[m];
+        distribution.sum += values[m];
+        if(values[m] > distribution.max){
+            distribution.max = values[m];
+        }
+        ++distribution.buckets[bucketOf(values[m])];
+    }
+
+    return;
+}
+
+/* 0 for an engine that recorded nothing. */
+unsigned long HistogramSink::count(const std::string& engine) const{
+    std::lock_guard<std::mutex> guard(lock);
+    const auto found = engines.find(engine);
+    return found == engines.end() ? 0 : found->second.count;
+}
+
+/* See percentileLocked(). */
+unsigned long HistogramSink::percentile(const std::string& engine, Metric metric, double fraction) const{
+    std::lock_guard<std::mutex> guard(lock);
+    const auto found = engines.find(engine);
+    return found == engines.end() ? 0 : percentileLocked(found->second, metric, fraction);
+}
+
+/* Exact, since the sum is kept alongside the buckets. */
+double HistogramSink::mean(const std::string& engine, Metric metric) const{
+    std::lock_guard<std::mutex> guard(lock);
+    const auto found = engines.find(engine);
+    if(found == engines.end() || found->second.count == 0){
+        return 0;
+    }
+
+    return found->second.metrics[metric].sum / found->second.count;
+}
+
+/* One object per engine, one object per metric inside it. */
+void HistogramSink::write(std::ostream& out) const{
+    std::lock_guard<std::mutex> guard(lock);
+    out << "{";
+    bool firstEngine = true;
+    for(auto it = engines.begin(); it != engines.end(); ++it){
+        out << (firstEngine ? "\n" : ",\n") << "  \"" << it->first << "\": {\"count\": " << it->second.count;
+        for(unsigned int m = 0; m < METRIC_COUNT; ++m){
+            const Distribution& distribution = it->second.metrics[m];
+            out << ",\n    \"" << METRIC_NAMES[m] << "\": {\"mean\": " << (it->second.count ? distribution.sum / it->second.count : 0.0)
+                << ", \"p50\": " << percentileLocked(it->second, static_cast<Metric>(m), 0.50)
+                << ", \"p90\": " << percentileLocked(it->second, static_cast<Metric>(m), 0.90)
+                << ", \"p99\": " << percentileLocked(it->second, static_cast<Metric>(m), 0.99)
+                << ", \"max\": " << distribution.max << "}";
+        }
+        out << "}";
+        firstEngine = false;
+    }
+    out << "\n}\n";
+
+    return;
+}
+
+/* Abstracts the STL container clear() functions. */
+void HistogramSink::clear(){
+    std::lock_guard<std::mutex> guard(lock);
+    engines.clear();
+
+    return;
+}
+
+/* Walks the buckets until they hold at least fraction of all queries. */
+unsigned long HistogramSink::percentileLocked(const Summary& summary, Metric metric, double fraction) const{
+    const Distribution& distribution = summary.metrics[metric];
+    const double wanted = fraction * summary.count;
+    unsigned long seen = 0;
+    for(unsigned int b = 0; b < BUCKETS; ++b){
+        seen += distribution.buckets[b];
+        if(seen > 0 && seen >= wanted){
+            return bucketCeiling(b) < distribution.max ? bucketCeiling(b) : distribution.max;
+        }
+    }
+
+    return distribution.max;
+}
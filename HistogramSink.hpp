@@ -0,0 +1,67 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a StatsSink which aggregates
+   per-query SearchStats into distributions, one set per
+   engine. Each metric keeps its count, sum and maximum,
+   plus a histogram with power-of-two buckets: bucket k
+   holds values from 2^(k-1) to 2^k - 1, and bucket 0 holds
+   0. Memory stays constant however many queries are
+   recorded, and percentiles are exact to within a factor
+   of two, which is enough to tell a typical query from a
+   slow one. Times are kept in microseconds.
+
+   record() takes a mutex, so the sink is safe to share by
+   every thread. write() prints the whole aggregate as one
+   JSON object keyed by engine name.                          */
+
+#ifndef HISTOGRAMSINK_HPP
+#define HISTOGRAMSINK_HPP
+
+#include "StatsSink.hpp"
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <ostream>
+
+class HistogramSink : public StatsSink{
+public:
+    enum Metric{
+        Settled, Relaxations, Pushes, Pops, Stale, PeakQueue,
+        InitUs, SearchUs, ReconstructUs, TotalUs,
+        METRIC_COUNT
+    };
+    static constexpr unsigned int BUCKETS = 65;     // Bucket 0 for 0, then one per bit of a 64-bit value
+    static constexpr const char* METRIC_NAMES[METRIC_COUNT] = {"settled", "relaxations", "pushes", "pops", "stale", "peakQueue",
+                                                               "initUs", "searchUs", "reconstructUs", "totalUs"};
+
+    HistogramSink();    // Empty aggregate
+    ~HistogramSink() override;  // Default destructor included to fulfill course requirements. Calls clear()
+    void record(const SearchStats& stats) override;
+    unsigned long count(const std::string& engine) const;   // Queries recorded for engine
+    unsigned long percentile(const std::string& engine, Metric metric, double fraction) const; // Upper edge of the bucket holding that fraction of queries, capped at the maximum
+    double mean(const std::string& engine, Metric metric) const;
+    void write(std::ostream& out) const;    // Count, mean, p50, p90, p99 and max of every metric of every engine, as JSON
+    void clear();   // Forgets every query
+
+private:
+    struct Distribution{
+        double sum = 0;
+        unsigned long max = 0;
+        unsigned long buckets[BUCKETS] = {};
+    };
+
+    struct Summary{
+        unsigned long count = 0;
+        Distribution metrics[METRIC_COUNT];
+    };
+
+    unsigned long percentileLocked(const Summary& summary, Metric metric, double fraction) const;  // Body of percentile(). lock must be held
+
+    mutable std::mutex lock;
+    std::map<std::string, Summary> engines; // (key/value) = (engine name/aggregate)
+};
+
+#endif
@@ -0,0 +1,460 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a hub labeling index for
+   distance queries on a FrozenGraph. Every vertex v stores
+   a label L(v): a list of (hub, distance) pairs. Labels are
+   built so that any two vertices share a hub which lies on
+   a shortest path between them, so that
+       dist(s, t) = min over h in L(s) and L(t) of
+                    dist(s, h) + dist(h, t).
+   Both labels are sorted by hub, so a query is one linear
+   merge of two short lists, with no search at all.
+
+   Labels come from a ContractionHierarchy. L(v) starts as
+   the upward search space of v, which already has the
+   property above, since every shortest path climbs to its
+   highest ranked vertex. Most of those entries are then
+   pruned: an entry (h, d) is dropped when the unpruned
+   labels of v and h prove dist(v, h) < d. Every vertex is
+   searched and pruned independently, so both steps run in
+   parallel on a ThreadPool.
+
+   Hubs are stored by rank, in ascending order, and each
+   label is compressed into a byte stream of variable-length
+   integers: the gap to the previous hub, the distance, and
+   optionally the gap down to the entry's parent hub. The
+   parent is the vertex before the hub on the upward path
+   from v, so following parents walks the path back to v.
+   shortestPath() does that on both sides of the best hub
+   and lets the hierarchy unpack shortcuts, which gives the
+   same path as ContractionHierarchy::shortestPath(). The
+   byte streams are saved and loaded as they are.            */
+
+#include "HubLabels.hpp"
+#include "SearchStats.hpp"
+#include "SearchWorkspace.hpp"
+#include "LabelTable.hpp"
+#include "WeightTraits.hpp"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <memory_resource>
+#include <stdexcept>
+#include <climits>
+#include <cstdint>
+
+namespace{
+    const char FILE_MAGIC[4] = {'S', 'P', 'H', 'L'};   // First bytes of every file written by save()
+    const std::uint32_t FILE_VERSION = 1;
+
+    /* Seven bits per byte, lowest first. The high bit of a byte says that another byte follows. */
+    void putVarint(std::vector<std::uint8_t>& stream, std::uint64_t value){
+        while(value >= 0x80){
+            stream.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        stream.push_back(static_cast<std::uint8_t>(value));
+
+        return;
+    }
+
+    /* Reverses putVarint(), advancing cursor past the bytes it read. */
+    std::uint64_t getVarint(const std::uint8_t*& cursor){
+        std::uint64_t value = *cursor & 0x7F;
+        for(unsigned int shift = 7; *cursor++ & 0x80; shift += 7){
+            value |= static_cast<std::uint64_t>(*cursor & 0x7F) << shift;
+        }
+
+        return value;
+    }
+
+    struct LabelCursor{ // Walks one compressed label entry by entry, without building it
+        const std::uint8_t* next;
+        const std::uint8_t* end;
+        bool parents;
+        unsigned int hub = 0;
+        unsigned long distance = 0;
+
+        /* Loads the next entry. Returns false once the label is exhausted. */
+        bool advance(){
+            if(next == end){
+                return false;
+            }
+            hub += getVarint(next);
+            distance = getVarint(next);
+            if(parents){
+                getVarint(next);    // Parent gap, only needed to rebuild paths
+            }
+
+            return true;
+        }
+    };
+}
+
+/* Defined solely for course requirement. */
+HubLabels::HubLabels(){
+    // No logical implementation required
+}
+
+/* Redundant, but satisfies course requirement. */
+HubLabels::~HubLabels(){
+    clear();
+}
+
+/* Runs in two parallel passes over the vertices, with the current labels kept until both succeed.
+   [a] Each worker runs the upward search of one vertex (ContractionHierarchy::upwardSpace()) and keeps the whole search
+       space, translated to ranks and sorted, as that vertex's unpruned label.
+   [b] Each worker then checks every entry (h, d) of one vertex v. The unpruned label of v is spread over a dense array
+       indexed by rank, and the unpruned label of h is scanned against it. Any common hub w with
+       d(v, w) + d(w, h) < d proves that d is not the true distance, so the entry can never give the best sum of a
+       query and is dropped. Exact entries are always kept, which includes the parent of every kept entry, since a
+       prefix of a shortest path is a shortest path. The survivors are encoded straight into that vertex's stream.
+   The check costs one scan of L(h) per entry, and high ranked hubs, which appear in most labels, have the shortest
+   labels of all.                                                                                                     */
+void HubLabels::build(const FrozenGraph& graph, const ContractionHierarchy& hierarchy, ThreadPool& pool, bool withParents){
+    if(hierarchy.vertexCount() != graph.vertexCount()){
+        throw std::invalid_argument("[ERROR] Hierarchy was built for a different graph. Unable to complete request.");
+    }
+    const unsigned int n = graph.vertexCount();
+    std::vector<unsigned int> builtRanks(n);
+    std::vector<unsigned int> builtOrder(n);
+    for(unsigned int v = 0; v < n; ++v){
+        builtRanks[v] = hierarchy.rank(v);
+        builtOrder[builtRanks[v]] = v;
+    }
+
+    std::vector<std::vector<Entry>> unpruned(n);
+    pool.parallelFor(n, [&](std::size_t v, unsigned int){  // [a]
+        SearchWorkspace& workspace = SearchWorkspace::local();
+        std::vector<std::pair<unsigned int, unsigned long>> space;
+        hierarchy.upwardSpace(v, workspace, space);
+        const SearchLabels& tree = workspace.forward();
+        std::vector<Entry>& label = unpruned[v];
+        label.reserve(space.size());
+        for(auto it = space.begin(); it != space.end(); ++it){
+            const unsigned int parent = tree.parent(it->first);
+            label.push_back({builtRanks[it->first], it->second, parent == LabelTable::NO_ID ? LabelTable::NO_ID : builtRanks[parent]});
+        }
+        std::sort(label.begin(), label.end(), [](const Entry& a, const Entry& b){
+            return a.hub < b.hub;
+        });
+    });
+
+    std::vector<std::vector<std::uint8_t>> streams(n);
+    std::vector<std::size_t> kept(n, 0);
+    std::vector<std::vector<unsigned long>> dense(pool.size());    // Per worker, (index/value) = (rank/distance from v)
+    pool.parallelFor(n, [&](std::size_t v, unsigned int worker){   // [b]
+        std::vector<unsigned long>& best = dense[worker];
+        if(best.empty()){
+            best.assign(n, ULONG_MAX);
+        }
+        const std::vector<Entry>& label = unpruned[v];
+        for(auto it = label.begin(); it != label.end(); ++it){
+            best[it->hub] = it->distance;
+        }
+        std::vector<Entry> survivors;
+        for(auto it = label.begin(); it != label.end(); ++it){
+            const std::vector<Entry>& hubLabel = unpruned[builtOrder[it->hub]];
+            bool dominated = false;
+            for(auto ht = hubLabel.begin(); ht != hubLabel.end() && !dominated; ++ht){
+                dominated = saturatingAdd(best[ht->hub], ht->distance) < it->distance;   // ULONG_MAX, unreached or too long, never dominates
+            }
+            if(!dominated){
+                survivors.push_back(*it);
+            }
+        }
+        for(auto it = label.begin(); it != label.end(); ++it){
+            best[it->hub] = ULONG_MAX;
+        }
+        kept[v] = survivors.size();
+        encode(survivors, withParents, streams[v]);
+    });
+
+    std::vector<std::uint64_t> builtOffsets(n + 1, 0);
+    std::size_t builtEntries = 0;
+    for(unsigned int v = 0; v < n; ++v){
+        builtOffsets[v + 1] = builtOffsets[v] + streams[v].size();
+        builtEntries += kept[v];
+    }
+    std::vector<std::uint8_t> builtBytes;
+    builtBytes.reserve(builtOffsets[n]);
+    for(unsigned int v = 0; v < n; ++v){
+        builtBytes.insert(builtBytes.end(), streams[v].begin(), streams[v].end());
+        std::vector<std::uint8_t>().swap(streams[v]);   // Release each stream as soon as it is copied
+    }
+
+    vertices = n;
+    edges = graph.edgeCount();
+    parents = withParents;
+    entries = builtEntries;
+    ranks.swap(builtRanks);
+    order.swap(builtOrder);
+    offsets.swap(builtOffsets);
+    bytes.swap(builtBytes);
+
+    return;
+}
+
+/* Read-only, so constant. */
+unsigned long HubLabels::distance(unsigned int start, unsigned int end) const{
+    if(start >= vertices || end >= vertices){
+        throw std::out_of_range("[ERROR] Specified vertex ID is out of range. Unable to complete request.");
+    }
+    unsigned int meet;
+
+    return merge(start, end, meet);
+}
+
+/* Same checks and errors as FrozenGraph::shortestPath(), without the path. */
+unsigned long HubLabels::distance(const FrozenGraph& graph, const std::string& startLabel, const std::string& endLabel) const{
+    SEARCH_STATS(SearchStats::QueryScope statsQuery("hl"));
+    if(graph.vertexCount() != vertices || graph.edgeCount() != edges){
+        throw std::invalid_argument("[ERROR] Hub labels were built for a different graph. Unable to complete request.");
+    }
+    const unsigned int start = graph.vertexId(startLabel);  // Throws if either vertex does not exist
+    const unsigned int end = graph.vertexId(endLabel);
+    unsigned int meet;
+    const unsigned long result = merge(start, end, meet);
+    if(result == ULONG_MAX){
+        throw std::logic_error("[ERROR] No path exists between the start and end vertices");  // Throw if no path is found
+    }
+
+    return result;
+}
+
+/* Finds the best hub by merge(), then walks parent hubs from it down to start, and again down to end. Each step is
+   one upward edge of hierarchy, so the two halves are unpacked exactly as in ContractionHierarchy::shortestPath(). */
+unsigned long HubLabels::shortestPath(const FrozenGraph& graph, const ContractionHierarchy& hierarchy, const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path) const{
+    SEARCH_STATS(SearchStats::QueryScope statsQuery("hl"));
+    if(graph.vertexCount() != vertices || graph.edgeCount() != edges || hierarchy.vertexCount() != vertices){
+        throw std::invalid_argument("[ERROR] Hub labels were built for a different graph. Unable to complete request.");
+    }
+    if(!parents){
+        throw std::logic_error("[ERROR] Hub labels were built without parents. Unable to complete request.");
+    }
+    const unsigned int start = graph.vertexId(startLabel);  // Throws if either vertex does not exist
+    const unsigned int end = graph.vertexId(endLabel);
+    unsigned int meet = LabelTable::NO_ID;
+    const unsigned long result = merge(start, end, meet);
+    if(result == ULONG_MAX){
+        throw std::logic_error("[ERROR] No path exists between the start and end vertices");  // Throw if no path is found
+    }
+
+    SEARCH_STATS(SearchStats::PhaseTimer reconstructTimer(SearchStats::Reconstruct));
+    std::vector<Entry> startHubs, endHubs;
+    decode(start, startHubs);
+    decode(end, endHubs);
+    const auto parentOf = [](const std::vector<Entry>& label, unsigned int hub){    // Labels are sorted by hub
+        const Entry key = {hub, 0, 0};
+        return std::lower_bound(label.begin(), label.end(), key, [](const Entry& a, const Entry& b){
+            return a.hub < b.hub;
+        })->parent;
+    };
+
+    std::pmr::memory_resource& scratch = SearchWorkspace::local().scratch();
+    std::pmr::vector<std::pair<unsigned int, std::size_t>> hops(&scratch);    // (lower endpoint, upward edge) from meet down to start
+    for(unsigned int curr = meet; curr != ranks[start]; ){
+        const unsigned int lower = parentOf(startHubs, curr);
+        hops.push_back({order[lower], hierarchy.findUpward(order[lower], order[curr])});
+        curr = lower;
+    }
+    std::pmr::vector<unsigned int> vertexPath(1, start, &scratch);
+    for(auto it = hops.rbegin(); it != hops.rend(); ++it){  // Upward half, start to meet
+        hierarchy.unpack(it->first, it->second, vertexPath);
+    }
+    for(unsigned int curr = meet; curr != ranks[end]; ){    // Downward half, meet to end
+        const unsigned int lower = parentOf(endHubs, curr);
+        hierarchy.unpack(order[curr], hierarchy.findUpward(order[lower], order[curr]), vertexPath);
+        curr = lower;
+    }
+    for(auto it = vertexPath.begin(); it != vertexPath.end(); ++it){
+        path.push_back(graph.vertexLabel(*it));
+    }
+
+    return result;
+}
+
+/* Read-only, so constant. */
+bool HubLabels::hasParents() const{
+    return parents;
+}
+
+/* Read-only, so constant. */
+unsigned int HubLabels::vertexCount() const{
+    return vertices;
+}
+
+/* Read-only, so constant. */
+std::size_t HubLabels::entryCount() const{
+    return entries;
+}
+
+/* Read-only, so constant. */
+std::size_t HubLabels::byteCount() const{
+    return bytes.size();
+}
+
+/* Writes the header, the rank table and the compressed labels exactly as they are held in memory, so load() only
+   has to read them back. Ranks are stored because the hubs and parents inside the labels are ranks.            */
+void HubLabels::save(const std::string& fileName) const{
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if(!file){
+        throw std::runtime_error("[ERROR] Unable to open hub label file for writing. Unable to complete request.");
+    }
+    const std::uint32_t header[3] = {FILE_VERSION, vertices, parents ? 1u : 0u};
+    const std::uint64_t counts[3] = {edges, entries, bytes.size()};
+    file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(counts), sizeof(counts));
+    for(auto it = ranks.begin(); it != ranks.end(); ++it){
+        const std::uint32_t rank = *it;
+        file.write(reinterpret_cast<const char*>(&rank), sizeof(rank));
+    }
+    file.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(std::uint64_t));
+    file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    if(!file){
+        throw std::runtime_error("[ERROR] Failed to write hub label file. Unable to complete request.");
+    }
+
+    return;
+}
+
+/* Reverses save(). The file must have been written for a graph with the same vertex and edge counts, and the rank
+   table and offsets must be consistent, otherwise queries would read past the labels. On any error the current
+   labels are left unchanged.                                                                                      */
+void HubLabels::load(const std::string& fileName, const FrozenGraph& graph){
+    std::ifstream file(fileName, std::ios::binary);
+    if(!file){
+        throw std::runtime_error("[ERROR] Unable to open hub label file for reading. Unable to complete request.");
+    }
+    char magic[sizeof(FILE_MAGIC)];
+    std::uint32_t header[3];
+    std::uint64_t counts[3];
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    file.read(reinterpret_cast<char*>(counts), sizeof(counts));
+    if(!file || !std::equal(magic, magic + sizeof(magic), FILE_MAGIC) || header[0] != FILE_VERSION){
+        throw std::runtime_error("[ERROR] File is not a hub label file of a supported version. Unable to complete request.");
+    }
+    if(header[1] != graph.vertexCount() || counts[0] != graph.edgeCount()){
+        throw std::invalid_argument("[ERROR] Hub label file was built for a different graph. Unable to complete request.");
+    }
+
+    const unsigned int n = header[1];
+    std::vector<unsigned int> loadedRanks(n);
+    std::vector<unsigned int> loadedOrder(n, LabelTable::NO_ID);
+    std::vector<std::uint64_t> loadedOffsets(static_cast<std::size_t>(n) + 1);
+    for(auto it = loadedRanks.begin(); it != loadedRanks.end(); ++it){
+        std::uint32_t rank;
+        file.read(reinterpret_cast<char*>(&rank), sizeof(rank));
+        *it = rank;
+    }
+    file.read(reinterpret_cast<char*>(loadedOffsets.data()), loadedOffsets.size() * sizeof(std::uint64_t));
+    if(!file){
+        throw std::runtime_error("[ERROR] Hub label file is truncated. Unable to complete request.");
+    }
+    for(unsigned int v = 0; v < n; ++v){
+        if(loadedRanks[v] >= n || loadedOrder[loadedRanks[v]] != LabelTable::NO_ID || loadedOffsets[v] > loadedOffsets[v + 1]){
+            throw std::runtime_error("[ERROR] Hub label file is corrupted. Unable to complete request.");
+        }
+        loadedOrder[loadedRanks[v]] = v;
+    }
+    if(loadedOffsets[0] != 0 || loadedOffsets[n] != counts[2]){
+        throw std::runtime_error("[ERROR] Hub label file is corrupted. Unable to complete request.");
+    }
+    std::vector<std::uint8_t> loadedBytes(counts[2]);
+    file.read(reinterpret_cast<char*>(loadedBytes.data()), loadedBytes.size());
+    if(!file){
+        throw std::runtime_error("[ERROR] Hub label file is truncated. Unable to complete request.");
+    }
+
+    vertices = n;
+    edges = counts[0];
+    parents = header[2] != 0;
+    entries = counts[1];
+    ranks.swap(loadedRanks);
+    order.swap(loadedOrder);
+    offsets.swap(loadedOffsets);
+    bytes.swap(loadedBytes);
+
+    return;
+}
+
+/* Abstracts the STL vector clear() functions. */
+void HubLabels::clear(){
+    order.clear();
+    ranks.clear();
+    offsets.clear();
+    bytes.clear();
+    vertices = 0;
+    edges = 0;
+    entries = 0;
+    parents = false;
+
+    return;
+}
+
+/* Standard sorted-list intersection, decoding both labels on the fly. Every common hub is a candidate meeting point,
+   and the smallest sum is the distance. meet is left unchanged if the labels share no hub.                         */
+unsigned long HubLabels::merge(unsigned int start, unsigned int end, unsigned int& meet) const{
+    LabelCursor a = {bytes.data() + offsets[start], bytes.data() + offsets[start + 1], parents};
+    LabelCursor b = {bytes.data() + offsets[end], bytes.data() + offsets[end + 1], parents};
+    unsigned long best = ULONG_MAX;
+    bool moreA = a.advance();
+    bool moreB = b.advance();
+    while(moreA && moreB){
+        if(a.hub < b.hub){
+            moreA = a.advance();
+        }
+        else if(b.hub < a.hub){
+            moreB = b.advance();
+        }
+        else{
+            const unsigned long through = saturatingAdd(a.distance, b.distance);   // ULONG_MAX never beats best
+            if(through < best){
+                best = through;
+                meet = a.hub;
+            }
+            moreA = a.advance();
+            moreB = b.advance();
+        }
+    }
+
+    return best;
+}
+
+/* Same walk as merge(), but every entry is kept, parent included. */
+void HubLabels::decode(unsigned int vertex, std::vector<Entry>& label) const{
+    label.clear();
+    const std::uint8_t* next = bytes.data() + offsets[vertex];
+    const std::uint8_t* end = bytes.data() + offsets[vertex + 1];
+    unsigned int hub = 0;
+    while(next != end){
+        hub += getVarint(next);
+        const unsigned long distance = getVarint(next);
+        const unsigned int gap = parents ? getVarint(next) : 0;
+        label.push_back({hub, distance, gap == 0 ? LabelTable::NO_ID : hub - gap});
+    }
+
+    return;
+}
+
+/* Hubs are written as the gap to the previous hub, and parents as the gap below their own hub. Parents always rank
+   lower than their hub, so the parent gap is at least 1, and 0 is free to mark the vertex's own entry.          */
+void HubLabels::encode(const std::vector<Entry>& label, bool withParents, std::vector<std::uint8_t>& stream) const{
+    unsigned int previous = 0;
+    for(auto it = label.begin(); it != label.end(); ++it){
+        putVarint(stream, it->hub - previous);
+        putVarint(stream, it->distance);
+        if(withParents){
+            putVarint(stream, it->parent == LabelTable::NO_ID ? 0 : it->hub - it->parent);
+        }
+        previous = it->hub;
+    }
+
+    return;
+}
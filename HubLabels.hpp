@@ -0,0 +1,85 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a hub labeling index for
+   distance queries on a FrozenGraph. Every vertex v stores
+   a label L(v): a list of (hub, distance) pairs. Labels are
+   built so that any two vertices share a hub which lies on
+   a shortest path between them, so that
+       dist(s, t) = min over h in L(s) and L(t) of
+                    dist(s, h) + dist(h, t).
+   Both labels are sorted by hub, so a query is one linear
+   merge of two short lists, with no search at all.
+
+   Labels come from a ContractionHierarchy. L(v) starts as
+   the upward search space of v, which already has the
+   property above, since every shortest path climbs to its
+   highest ranked vertex. Most of those entries are then
+   pruned: an entry (h, d) is dropped when the unpruned
+   labels of v and h prove dist(v, h) < d. Every vertex is
+   searched and pruned independently, so both steps run in
+   parallel on a ThreadPool.
+
+   Hubs are stored by rank, in ascending order, and each
+   label is compressed into a byte stream of variable-length
+   integers: the gap to the previous hub, the distance, and
+   optionally the gap down to the entry's parent hub. The
+   parent is the vertex before the hub on the upward path
+   from v, so following parents walks the path back to v.
+   shortestPath() does that on both sides of the best hub
+   and lets the hierarchy unpack shortcuts, which gives the
+   same path as ContractionHierarchy::shortestPath(). The
+   byte streams are saved and loaded as they are.            */
+
+#ifndef HUBLABELS_HPP
+#define HUBLABELS_HPP
+
+#include "FrozenGraph.hpp"
+#include "ContractionHierarchy.hpp"
+#include "ThreadPool.hpp"
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class HubLabels{
+public:
+    HubLabels();    // Empty index. Populated by build() or load()
+    ~HubLabels();   // Default destructor included to fulfill course requirements. Calls clear()
+    void build(const FrozenGraph& graph, const ContractionHierarchy& hierarchy, ThreadPool& pool, bool withParents = true); // Pruned labels from the upward search spaces of hierarchy, which must be built for graph. Parents enable shortestPath()
+    unsigned long distance(unsigned int start, unsigned int end) const; // Label merge. ULONG_MAX if end cannot be reached
+    unsigned long distance(const FrozenGraph& graph, const std::string& startLabel, const std::string& endLabel) const; // Distance-only variant of FrozenGraph::shortestPath(), which throws the same way
+    unsigned long shortestPath(const FrozenGraph& graph, const ContractionHierarchy& hierarchy, const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path) const; // Same contract as FrozenGraph::shortestPath(). Requires parents
+    bool hasParents() const;        // True if build() stored parent hubs
+    unsigned int vertexCount() const;   // Vertex count of the graph the labels were built for
+    std::size_t entryCount() const;     // Total (hub, distance) pairs over all labels
+    std::size_t byteCount() const;      // Size of the compressed labels
+    void save(const std::string& fileName) const;  // Writes the compressed labels to a binary file
+    void load(const std::string& fileName, const FrozenGraph& graph);  // Reads labels written by save() for the same graph
+    void clear();   // Releases all labels
+
+protected:
+    struct Entry{   // One decoded label entry
+        unsigned int hub;       // Rank of the hub
+        unsigned long distance; // dist(vertex, hub)
+        unsigned int parent;    // Rank of the vertex before the hub on the upward path, LabelTable::NO_ID for the vertex itself
+    };
+
+    unsigned long merge(unsigned int start, unsigned int end, unsigned int& meet) const; // Best sum over common hubs, and the rank of the hub reaching it
+    void decode(unsigned int vertex, std::vector<Entry>& label) const;  // Whole label of vertex, in hub order
+    void encode(const std::vector<Entry>& label, bool withParents, std::vector<std::uint8_t>& stream) const; // Appends label, which must be in hub order, to stream
+
+private:
+    unsigned int vertices = 0;      // Vertex count of the graph the labels were built for
+    std::size_t edges = 0;          // Edge count of the graph the labels were built for, checked by load() and the queries
+    bool parents = false;           // Whether each entry carries its parent gap
+    std::size_t entries = 0;        // Total entries over all labels
+    std::vector<unsigned int> order;        // (index/value) = (rank/vertex ID)
+    std::vector<unsigned int> ranks;        // (index/value) = (vertex ID/rank)
+    std::vector<std::uint64_t> offsets;     // vertices + 1 entries. The label of v lives in bytes [offsets[v], offsets[v + 1])
+    std::vector<std::uint8_t> bytes;        // Every label, compressed back to back
+};
+
+#endif
@@ -0,0 +1,137 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a label-interning table. Each
+   vertex label (std::string) is mapped to a 32-bit ID once,
+   when the vertex is added, and every other structure
+   (Edge, Vertex, PQueue and the search state in Graph)
+   works on that ID instead of on a copy of the string.
+   Strings only appear again at the public API boundary.
+
+   IDs are dense indices into a slot table, so they can be
+   used directly as vector indices. When a label is
+   released its slot is recycled by the next intern() call,
+   which keeps the slot table from growing under repeated
+   add/remove cycles. For example: intern("A") = 0,
+   intern("B") = 1, release(0), intern("C") = 0.             */
+
+#include "LabelTable.hpp"
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+/* Defined solely for course requirement. */
+LabelTable::LabelTable(){
+    // No logical implementation required
+}
+
+/* The slot table stores pointers to the keys of ids, so a member-wise
+   copy would point into other's map. Slots are re-pointed after copying. */
+LabelTable::LabelTable(const LabelTable& other) : ids(other.ids), names(other.names.size(), nullptr), freeSlots(other.freeSlots){
+    for(auto it = ids.begin(); it != ids.end(); ++it){
+        names[it->second] = &it->first;
+    }
+}
+
+/* Same as the copy constructor. */
+LabelTable& LabelTable::operator=(const LabelTable& other){
+    if(this != &other){
+        ids = other.ids;
+        names.assign(other.names.size(), nullptr);
+        freeSlots = other.freeSlots;
+        for(auto it = ids.begin(); it != ids.end(); ++it){
+            names[it->second] = &it->first;
+        }
+    }
+
+    return *this;
+}
+
+/* Redundant, but satisfies course requirement. */
+LabelTable::~LabelTable(){
+    clear();
+}
+
+/* Returns the existing ID of label if it has one. Otherwise the most recently
+   released slot is reused, or a new slot is appended to the end of the table. */
+unsigned int LabelTable::intern(const std::string& label){
+    auto found = ids.find(label);
+    if(found != ids.end()){
+        return found->second;
+    }
+
+    unsigned int id;
+    if(!freeSlots.empty()){
+        id = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else{
+        if(names.size() >= NO_ID){  // Data security check, NO_ID is reserved
+            throw std::length_error("[ERROR] Label table is full. Unable to complete request.");
+        }
+        id = names.size();
+        names.push_back(nullptr);
+    }
+    auto it = ids.insert({label, id}).first;
+    names[id] = &it->first; // Keys of an unordered_map never move, so the pointer stays valid until release()
+
+    return id;
+}
+
+/* Read-only, so constant. */
+unsigned int LabelTable::find(const std::string& label) const{
+    auto it = ids.find(label);
+    if(it == ids.end()){
+        return NO_ID;
+    }
+
+    return it->second;
+}
+
+/* Read-only, so constant. */
+const std::string& LabelTable::label(unsigned int id) const{
+    if(!live(id)){  // Data security check
+        throw std::out_of_range("[ERROR] Specified vertex ID is not assigned. Unable to complete request.");
+    }
+
+    return *names[id];
+}
+
+/* Read-only, so constant. */
+bool LabelTable::live(unsigned int id) const{
+    return id < names.size() && names[id] != nullptr;
+}
+
+/* Erases the label and marks its slot as free. */
+void LabelTable::release(unsigned int id){
+    if(!live(id)){  // Data security check
+        throw std::out_of_range("[ERROR] Specified vertex ID is not assigned. Unable to complete request.");
+    }
+    const std::string* key = names[id];
+    names[id] = nullptr;
+    freeSlots.push_back(id);
+    ids.erase(*key);
+
+    return;
+}
+
+/* Read-only, so constant. */
+unsigned int LabelTable::size() const{
+    return ids.size();
+}
+
+/* Read-only, so constant. */
+unsigned int LabelTable::capacity() const{
+    return names.size();
+}
+
+/* Abstracts the STL containers and their clear() functions. */
+void LabelTable::clear(){
+    names.clear();
+    freeSlots.clear();
+    ids.clear();
+
+    return;
+}
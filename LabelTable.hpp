@@ -0,0 +1,50 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a label-interning table. Each
+   vertex label (std::string) is mapped to a 32-bit ID once,
+   when the vertex is added, and every other structure
+   (Edge, Vertex, PQueue and the search state in Graph)
+   works on that ID instead of on a copy of the string.
+   Strings only appear again at the public API boundary.
+
+   IDs are dense indices into a slot table, so they can be
+   used directly as vector indices. When a label is
+   released its slot is recycled by the next intern() call,
+   which keeps the slot table from growing under repeated
+   add/remove cycles. For example: intern("A") = 0,
+   intern("B") = 1, release(0), intern("C") = 0.             */
+
+#ifndef LABELTABLE_HPP
+#define LABELTABLE_HPP
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <climits>
+
+class LabelTable{
+public:
+    static constexpr unsigned int NO_ID = UINT_MAX;    // Returned by find() for unknown labels. Never assigned to a label
+
+    LabelTable();   // Default constructor included to fulfill course requirements
+    LabelTable(const LabelTable& other);             // Rebuilds the slot table so that it refers to this object's keys
+    LabelTable& operator=(const LabelTable& other);  // Same as above
+    ~LabelTable();  // Default destructor included to fulfill course requirements. Calls clear()
+    unsigned int intern(const std::string& label);  // Returns the ID of label, assigning a new one if needed
+    unsigned int find(const std::string& label) const; // Returns the ID of label, or NO_ID if it was never interned
+    const std::string& label(unsigned int id) const;   // Returns the label of a live ID
+    bool live(unsigned int id) const;   // True if id is currently assigned to a label
+    void release(unsigned int id);      // Forgets a label. Its ID is reused by a later intern()
+    unsigned int size() const;          // Number of live labels
+    unsigned int capacity() const;      // Number of slots. Every live ID is below capacity()
+    void clear();   // Forgets all labels and slots
+
+private:
+    std::unordered_map<std::string, unsigned int> ids;  // (key/value) = (label/ID). Owns the only copy of each string
+    std::vector<const std::string*> names;  // (index/value) = (ID/pointer to key in ids). nullptr marks a free slot
+    std::vector<unsigned int> freeSlots;    // Released IDs, reused last-in first-out
+};
+
+#endif
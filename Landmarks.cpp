@@ -0,0 +1,424 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines the landmark tables used by
+   ALT search (A*, Landmarks, Triangle inequality). A small
+   number K of vertices are chosen as landmarks, and the
+   distance from each landmark to every vertex of a
+   FrozenGraph is computed once. For any landmark L, the
+   triangle inequality gives
+       dist(v, t) >= |dist(L, t) - dist(L, v)|
+   so the largest of these K differences is a lower bound
+   on the remaining distance from v to the end-vertex t.
+   shortestPath() feeds that bound to astar() (Dijkstra.hpp)
+   so that point-to-point queries explore far fewer vertices
+   than plain Dijkstra.
+
+   Landmarks are picked with one of two strategies. Farthest
+   repeatedly adds the vertex farthest from all landmarks
+   chosen so far. Avoid grows a shortest path tree from a
+   root vertex, finds the subtree whose distances are worst
+   covered by the current landmarks, and places the next
+   landmark at a leaf of that subtree.
+
+   Preprocessing runs K full searches, so the tables can be
+   saved to a binary file and loaded again by later
+   processes which work on the same FrozenGraph.              */
+
+#include "Landmarks.hpp"
+#include "SearchStats.hpp"
+#include "Dijkstra.hpp"
+#include "PQueue.hpp"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include <climits>
+#include <cstdint>
+
+namespace{
+    const char FILE_MAGIC[4] = {'S', 'P', 'L', 'M'};   // First bytes of every file written by save()
+    const std::uint32_t FILE_VERSION = 2;               // Bumped whenever the layout below changes
+
+    /* |a - b| for two finite distances. */
+    unsigned long difference(unsigned long a, unsigned long b){
+        return a > b ? a - b : b - a;
+    }
+}
+
+/* Defined solely for course requirement. */
+Landmarks::Landmarks(){
+    // No logical implementation required
+}
+
+/* Redundant, but satisfies course requirement. */
+Landmarks::~Landmarks(){
+    clear();
+}
+
+/* Picks landmarks one at a time, each from the distance columns of the landmarks picked before it. The first landmark
+   is always the vertex farthest from vertex 0. A vertex which no landmark can reach yet lies in a component without a
+   landmark, so it is picked by the Farthest rule before Avoid is tried; that way every component gets a landmark. Once
+   all columns exist, they are transposed into the vertex-major table so that lowerBound() reads K adjacent values.  */
+void Landmarks::build(const FrozenGraph& graph, unsigned int count, LandmarkStrategy strategy){
+    clear();
+    vertexCount = graph.vertexCount();
+    edgeCount = graph.edgeCount();
+    if(count > vertexCount){
+        count = vertexCount;    // There cannot be more landmarks than vertices
+    }
+    components = computeComponents(graph);  // Needed by lowerBound() even without landmarks
+    if(count == 0){
+        return;
+    }
+
+    std::vector<std::vector<unsigned long>> columns;
+    std::mt19937 rng(vertexCount);  // Seeded from the graph, so that a rebuild picks the same roots
+    columns.push_back(computeColumn(graph, 0));
+    landmarkIds.push_back(pickFarthest(columns));   // Farthest from vertex 0...
+    columns[0] = computeColumn(graph, landmarkIds[0]);  // ...replaces vertex 0 as the first landmark
+    while(landmarkIds.size() < count){
+        unsigned int next = pickFarthest(columns);
+        bool covered = true;
+        for(auto it = columns.begin(); it != columns.end(); ++it){
+            covered = covered && (*it)[next] != ULONG_MAX;
+        }
+        if(strategy == LandmarkStrategy::Avoid && covered){
+            next = pickAvoid(graph, columns, rng() % vertexCount);
+        }
+        if(std::find(landmarkIds.begin(), landmarkIds.end(), next) != landmarkIds.end()){
+            break;  // Every vertex is a landmark already, or no vertex is left uncovered
+        }
+        landmarkIds.push_back(next);
+        columns.push_back(computeColumn(graph, next));
+    }
+
+    const std::size_t k = landmarkIds.size();
+    distances.assign(static_cast<std::size_t>(vertexCount) * k, ULONG_MAX);
+    for(std::size_t i = 0; i < k; ++i){
+        for(unsigned int v = 0; v < vertexCount; ++v){
+            distances[v * k + i] = columns[i][v];
+        }
+    }
+
+    return;
+}
+
+/* Same steps as FrozenGraph::shortestPath(), but astar() replaces dijkstra() and lowerBound() is its potential. A
+   PQueue is used regardless of the graph's QueueKind, because A* keys may grow faster than Dial's buckets allow.   */
+unsigned long Landmarks::shortestPath(const FrozenGraph& graph, const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path) const{
+    SEARCH_STATS(SearchStats::QueryScope statsQuery("alt"));
+    if(graph.vertexCount() != vertexCount || graph.edgeCount() != edgeCount){
+        throw std::invalid_argument("[ERROR] Landmark tables were built for a different graph. Unable to complete request.");
+    }
+    const unsigned int start = graph.vertexId(startLabel);  // Throws if either vertex does not exist
+    const unsigned int end = graph.vertexId(endLabel);
+
+    SearchWorkspace& workspace = SearchWorkspace::local();
+    SearchLabels& labels = workspace.forward();
+    SEARCH_STATS(SearchStats::PhaseTimer initTimer(SearchStats::Init));
+    labels.reset(vertexCount);
+    SEARCH_STATS(initTimer.stop());
+    SEARCH_STATS(SearchStats::PhaseTimer searchTimer(SearchStats::Search));
+    PQueue& pQueue = workspace.heap();
+    pQueue.reserve(vertexCount);
+    const unsigned long distance = astar(graph, pQueue, start, end, labels, [&](unsigned int id){
+        return lowerBound(id, end);
+    });
+    SEARCH_STATS(searchTimer.stop());
+    if(distance == ULONG_MAX){
+        throw std::logic_error("[ERROR] No path exists between the start and end vertices");  // Throw if no path is found
+    }
+
+    SEARCH_STATS(SearchStats::PhaseTimer reconstructTimer(SearchStats::Reconstruct));
+    const std::size_t first = path.size();  // Rebuild the path from end back to start, then reverse what was appended
+    for(unsigned int curr = end; curr != start; curr = labels.parent(curr)){
+        path.push_back(graph.vertexLabel(curr));
+    }
+    path.push_back(graph.vertexLabel(start));
+    std::reverse(path.begin() + first, path.end());
+
+    return distance;
+}
+
+/* Largest triangle-inequality bound over all landmarks. Vertices of different components prove that target is
+   unreachable. A landmark without a finite distance to both vertices says nothing: it is in another component, or
+   one of the distances is too long for an unsigned long.                                                         */
+unsigned long Landmarks::lowerBound(unsigned int vertex, unsigned int target) const{
+    if(components[vertex] != components[target]){
+        return ULONG_MAX;
+    }
+    const std::size_t k = landmarkIds.size();
+    const unsigned long* fromVertex = distances.data() + vertex * k;
+    const unsigned long* fromTarget = distances.data() + target * k;
+    unsigned long bound = 0;
+    for(std::size_t i = 0; i < k; ++i){
+        if(fromVertex[i] == ULONG_MAX || fromTarget[i] == ULONG_MAX){
+            continue;
+        }
+        bound = std::max(bound, difference(fromVertex[i], fromTarget[i]));
+    }
+
+    return bound;
+}
+
+/* Read-only, so constant. */
+unsigned int Landmarks::landmarkCount() const{
+    return landmarkIds.size();
+}
+
+/* Read-only, so constant. */
+unsigned int Landmarks::landmark(unsigned int index) const{
+    if(index >= landmarkIds.size()){
+        throw std::out_of_range("[ERROR] Specified landmark index is out of range. Unable to complete request.");
+    }
+
+    return landmarkIds[index];
+}
+
+/* Layout: magic, version, vertex count, edge count, K, K landmark IDs, the vertex-major table, then one component per
+   vertex. Integers are
+   written in the byte order of this machine, so a file is meant to be read back on the same platform.            */
+void Landmarks::save(const std::string& fileName) const{
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if(!file){
+        throw std::runtime_error("[ERROR] Unable to open landmark file for writing. Unable to complete request.");
+    }
+    const std::uint32_t header[2] = {FILE_VERSION, vertexCount};
+    const std::uint64_t edges = edgeCount;
+    const std::uint32_t k = landmarkIds.size();
+    file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(&edges), sizeof(edges));
+    file.write(reinterpret_cast<const char*>(&k), sizeof(k));
+    for(auto it = landmarkIds.begin(); it != landmarkIds.end(); ++it){
+        const std::uint32_t id = *it;
+        file.write(reinterpret_cast<const char*>(&id), sizeof(id));
+    }
+    for(auto it = distances.begin(); it != distances.end(); ++it){
+        const std::uint64_t distance = *it;
+        file.write(reinterpret_cast<const char*>(&distance), sizeof(distance));
+    }
+    for(auto it = components.begin(); it != components.end(); ++it){
+        const std::uint32_t component = *it;
+        file.write(reinterpret_cast<const char*>(&component), sizeof(component));
+    }
+    if(!file){
+        throw std::runtime_error("[ERROR] Failed to write landmark file. Unable to complete request.");
+    }
+
+    return;
+}
+
+/* Reverses save(). The file must have been written for a graph with the same vertex and edge counts, otherwise
+   the tables would silently produce wrong bounds. On any error the current tables are left unchanged.          */
+void Landmarks::load(const std::string& fileName, const FrozenGraph& graph){
+    std::ifstream file(fileName, std::ios::binary);
+    if(!file){
+        throw std::runtime_error("[ERROR] Unable to open landmark file for reading. Unable to complete request.");
+    }
+    char magic[sizeof(FILE_MAGIC)];
+    std::uint32_t header[2];
+    std::uint64_t edges;
+    std::uint32_t k;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    file.read(reinterpret_cast<char*>(&edges), sizeof(edges));
+    file.read(reinterpret_cast<char*>(&k), sizeof(k));
+    if(!file || !std::equal(magic, magic + sizeof(magic), FILE_MAGIC) || header[0] != FILE_VERSION){
+        throw std::runtime_error("[ERROR] File is not a landmark file of a supported version. Unable to complete request.");
+    }
+    if(header[1] != graph.vertexCount() || edges != graph.edgeCount() || k > header[1]){
+        throw std::invalid_argument("[ERROR] Landmark file was built for a different graph. Unable to complete request.");
+    }
+
+    std::vector<unsigned int> loadedIds(k);
+    std::vector<unsigned long> loadedDistances(static_cast<std::size_t>(header[1]) * k);
+    for(auto it = loadedIds.begin(); it != loadedIds.end(); ++it){
+        std::uint32_t id;
+        file.read(reinterpret_cast<char*>(&id), sizeof(id));
+        *it = id;
+    }
+    for(auto it = loadedDistances.begin(); it != loadedDistances.end(); ++it){
+        std::uint64_t distance;
+        file.read(reinterpret_cast<char*>(&distance), sizeof(distance));
+        *it = distance;
+    }
+    std::vector<unsigned int> loadedComponents(header[1]);
+    for(auto it = loadedComponents.begin(); it != loadedComponents.end(); ++it){
+        std::uint32_t component;
+        file.read(reinterpret_cast<char*>(&component), sizeof(component));
+        *it = component;
+    }
+    if(!file){
+        throw std::runtime_error("[ERROR] Landmark file is truncated. Unable to complete request.");
+    }
+
+    vertexCount = header[1];
+    edgeCount = edges;
+    landmarkIds.swap(loadedIds);
+    distances.swap(loadedDistances);
+    components.swap(loadedComponents);
+
+    return;
+}
+
+/* Abstracts the STL vector clear() functions. */
+void Landmarks::clear(){
+    landmarkIds.clear();
+    distances.clear();
+    components.clear();
+    vertexCount = 0;
+    edgeCount = 0;
+
+    return;
+}
+
+/* Breadth-first search from every vertex not yet labeled. Weights play no part, so no distance can overflow here. */
+std::vector<unsigned int> Landmarks::computeComponents(const FrozenGraph& graph) const{
+    std::vector<unsigned int> component(graph.vertexCount(), LabelTable::NO_ID);
+    std::vector<unsigned int> queue;
+    for(unsigned int root = 0; root < graph.vertexCount(); ++root){
+        if(component[root] != LabelTable::NO_ID){
+            continue;
+        }
+        component[root] = root;
+        queue.assign(1, root);
+        for(std::size_t head = 0; head < queue.size(); ++head){
+            graph.forEachNeighbor(queue[head], [&](unsigned int next, unsigned long){
+                if(component[next] == LabelTable::NO_ID){
+                    component[next] = root;
+                    queue.push_back(next);
+                }
+            });
+        }
+    }
+
+    return component;
+}
+
+/* Runs dijkstra() with an end-vertex that never exists, so that every vertex reachable from source is settled. */
+std::vector<unsigned long> Landmarks::computeColumn(const FrozenGraph& graph, unsigned int source, std::vector<unsigned int>* prevVertex) const{
+    SearchWorkspace& workspace = SearchWorkspace::local();
+    dijkstra(graph, graph.vertexCount(), graph.getQueueKind(), graph.getMaxWeight(), source, LabelTable::NO_ID, workspace);
+
+    const SearchLabels& labels = workspace.forward();
+    std::vector<unsigned long> column(graph.vertexCount());
+    for(unsigned int v = 0; v < graph.vertexCount(); ++v){
+        column[v] = labels.distance(v);
+    }
+    if(prevVertex != nullptr){
+        prevVertex->resize(graph.vertexCount());
+        for(unsigned int v = 0; v < graph.vertexCount(); ++v){
+            (*prevVertex)[v] = labels.parent(v);
+        }
+    }
+
+    return column;
+}
+
+/* A vertex's coverage is its distance to the nearest landmark. Unreachable counts as infinitely far, which makes
+   vertices in a component without a landmark win. Ties go to the smallest ID, which keeps build() deterministic.  */
+unsigned int Landmarks::pickFarthest(const std::vector<std::vector<unsigned long>>& columns) const{
+    unsigned int farthest = 0;
+    unsigned long farthestDistance = 0;
+    for(unsigned int v = 0; v < vertexCount; ++v){
+        unsigned long nearest = ULONG_MAX;
+        for(auto it = columns.begin(); it != columns.end(); ++it){
+            nearest = std::min(nearest, (*it)[v]);
+        }
+        if(nearest > farthestDistance){
+            farthest = v;
+            farthestDistance = nearest;
+        }
+    }
+
+    return farthest;
+}
+
+/* The Avoid rule. Each vertex v in the shortest path tree of root gets the weight dist(root, v) - lowerBound(root, v),
+   the amount by which the current landmarks underestimate its distance. A subtree's size is the sum of its weights, or
+   zero if it already contains a landmark. Starting at the vertex with the largest size, the walk always descends into
+   the child with the largest size, and the leaf it ends on becomes the next landmark. Sizes are summed bottom-up by visiting vertices in order of
+   decreasing distance, so every child is finished before its parent.                                                 */
+unsigned int Landmarks::pickAvoid(const FrozenGraph& graph, const std::vector<std::vector<unsigned long>>& columns, unsigned int root) const{
+    std::vector<unsigned int> prevVertex;
+    const std::vector<unsigned long> rootDistance = computeColumn(graph, root, &prevVertex);
+
+    std::vector<unsigned int> order;    // Vertices of the tree, farthest first
+    for(unsigned int v = 0; v < vertexCount; ++v){
+        if(rootDistance[v] != ULONG_MAX){
+            order.push_back(v);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b){
+        return rootDistance[a] > rootDistance[b] || (rootDistance[a] == rootDistance[b] && a > b);
+    });
+
+    std::vector<unsigned long> size(vertexCount, 0);
+    std::vector<char> hasLandmark(vertexCount, 0);
+    for(auto it = landmarkIds.begin(); it != landmarkIds.end(); ++it){
+        hasLandmark[*it] = 1;
+    }
+    for(auto it = order.begin(); it != order.end(); ++it){
+        const unsigned int v = *it;
+        unsigned long bound = 0;
+        for(auto ct = columns.begin(); ct != columns.end(); ++ct){
+            if((*ct)[root] != ULONG_MAX && (*ct)[v] != ULONG_MAX){
+                bound = std::max(bound, difference((*ct)[root], (*ct)[v]));
+            }
+        }
+        size[v] += rootDistance[v] - bound;
+        if(hasLandmark[v]){
+            size[v] = 0;
+        }
+        if(v != root){  // Hand the subtree over to the parent
+            const unsigned int parent = prevVertex[v];
+            hasLandmark[parent] = hasLandmark[parent] || hasLandmark[v];
+            size[parent] += size[v];
+        }
+    }
+    unsigned int curr = root;   // Top of the worst covered subtree
+    for(auto it = order.begin(); it != order.end(); ++it){
+        if(size[*it] > size[curr]){
+            curr = *it;
+        }
+    }
+    if(size[curr] == 0){
+        return pickFarthest(columns);   // Nothing under root is worth covering, fall back to Farthest
+    }
+
+    std::vector<std::size_t> childBegin(vertexCount + 1, 0);  // Children of each tree vertex in CSR form
+    std::vector<unsigned int> children(order.size());
+    for(auto it = order.begin(); it != order.end(); ++it){
+        if(*it != root){
+            ++childBegin[prevVertex[*it] + 1];
+        }
+    }
+    for(unsigned int v = 0; v < vertexCount; ++v){
+        childBegin[v + 1] += childBegin[v];
+    }
+    std::vector<std::size_t> fill(childBegin.begin(), childBegin.end() - 1);
+    for(auto it = order.begin(); it != order.end(); ++it){
+        if(*it != root){
+            children[fill[prevVertex[*it]]++] = *it;
+        }
+    }
+
+    while(true){
+        unsigned int largest = curr;
+        for(std::size_t i = childBegin[curr]; i < childBegin[curr + 1]; ++i){
+            if(size[children[i]] > 0 && (largest == curr || size[children[i]] > size[largest])){
+                largest = children[i];
+            }
+        }
+        if(largest == curr){    // Leaf of the worst covered subtree
+            return curr;
+        }
+        curr = largest;
+    }
+}
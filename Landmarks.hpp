@@ -0,0 +1,75 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares the landmark tables used by
+   ALT search (A*, Landmarks, Triangle inequality). A small
+   number K of vertices are chosen as landmarks, and the
+   distance from each landmark to every vertex of a
+   FrozenGraph is computed once. For any landmark L, the
+   triangle inequality gives
+       dist(v, t) >= |dist(L, t) - dist(L, v)|
+   so the largest of these K differences is a lower bound
+   on the remaining distance from v to the end-vertex t.
+   shortestPath() feeds that bound to astar() (Dijkstra.hpp)
+   so that point-to-point queries explore far fewer vertices
+   than plain Dijkstra.
+
+   Landmarks are picked with one of two strategies. Farthest
+   repeatedly adds the vertex farthest from all landmarks
+   chosen so far. Avoid grows a shortest path tree from a
+   root vertex, finds the subtree whose distances are worst
+   covered by the current landmarks, and places the next
+   landmark at a leaf of that subtree.
+
+   Every vertex also records its connected component, which
+   proves a target unreachable at once. The distance tables
+   cannot prove this on their own: a distance too long for
+   an unsigned long reads as ULONG_MAX, the same as an
+   unreachable vertex.
+
+   Preprocessing runs K full searches, so the tables can be
+   saved to a binary file and loaded again by later
+   processes which work on the same FrozenGraph.              */
+
+#ifndef LANDMARKS_HPP
+#define LANDMARKS_HPP
+
+#include "FrozenGraph.hpp"
+
+#include <string>
+#include <vector>
+
+enum class LandmarkStrategy{
+    Farthest,   // Each landmark is the vertex farthest from all previous landmarks
+    Avoid       // Each landmark is a leaf of the shortest path subtree worst covered by previous landmarks
+};
+
+class Landmarks{
+public:
+    Landmarks();    // Empty tables. Populated by build() or load()
+    ~Landmarks();   // Default destructor included to fulfill course requirements. Calls clear()
+    void build(const FrozenGraph& graph, unsigned int count, LandmarkStrategy strategy = LandmarkStrategy::Avoid); // Picks count landmarks and computes their distance tables
+    unsigned long shortestPath(const FrozenGraph& graph, const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path) const; // A* guided by lowerBound(), same contract as FrozenGraph::shortestPath()
+    unsigned long lowerBound(unsigned int vertex, unsigned int target) const;  // Lower bound on dist(vertex, target), ULONG_MAX if target is unreachable
+    unsigned int landmarkCount() const;     // Number of landmarks, K
+    unsigned int landmark(unsigned int index) const;    // Dense ID of the index-th landmark
+    void save(const std::string& fileName) const;  // Writes the tables to a binary file
+    void load(const std::string& fileName, const FrozenGraph& graph);  // Reads tables written by save() for the same graph
+    void clear();   // Releases all tables
+
+protected:  // Helper functions for build(). Each column holds the distances from one landmark to every vertex
+    std::vector<unsigned int> computeComponents(const FrozenGraph& graph) const;  // (index/value) = (vertex ID/component), numbered by lowest vertex
+    std::vector<unsigned long> computeColumn(const FrozenGraph& graph, unsigned int source, std::vector<unsigned int>* prevVertex = nullptr) const; // One full search from source
+    unsigned int pickFarthest(const std::vector<std::vector<unsigned long>>& columns) const;   // Vertex farthest from all landmarks in columns
+    unsigned int pickAvoid(const FrozenGraph& graph, const std::vector<std::vector<unsigned long>>& columns, unsigned int root) const; // Leaf of the worst covered subtree below root
+
+private:
+    unsigned int vertexCount = 0;   // Vertex count of the graph the tables were built for
+    std::size_t edgeCount = 0;      // Edge count of the graph the tables were built for, checked by load()
+    std::vector<unsigned int> landmarkIds;  // (index/value) = (landmark index/dense ID)
+    std::vector<unsigned long> distances;   // Vertex-major table. dist(landmark i, v) is distances[v * K + i]
+    std::vector<unsigned int> components;   // (index/value) = (vertex ID/connected component)
+};
+
+#endif
@@ -0,0 +1,398 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a read-only graph which lives
+   in a memory-mapped file. write() stores a FrozenGraph in
+   a versioned binary layout, and open() maps that file with
+   mmap(). Nothing is parsed or copied on open(): the CSR
+   arrays, the label table and a label index sorted by
+   label are used in place, straight from the page cache.
+   Every process that opens the same file shares the same
+   physical pages, and pages are only read from disk when a
+   query first touches them.
+
+   The file holds, in order: a fixed-size header (magic,
+   version, byte-order mark, counts and section offsets),
+   the CSR offsets, targets and weights of FrozenGraph, the
+   label offsets and label bytes, and the IDs sorted by
+   label. Every section starts on an 8-byte boundary, so
+   each one can be read directly as an array. Labels are
+   found by binary search over the sorted IDs.
+
+   shortestPath() follows the same contract as
+   FrozenGraph::shortestPath(), and forEachNeighbor() lets
+   the templates of Dijkstra.hpp run on the mapped arrays.   */
+
+#include "MappedGraph.hpp"
+#include "SearchStats.hpp"
+#include "LabelTable.hpp"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <climits>
+#include <cstring>
+#include <cstdint>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace{
+    const char FILE_MAGIC[4] = {'S', 'P', 'G', 'F'};   // First bytes of every file written by write()
+    const std::uint32_t FILE_VERSION = 1;               // Bumped whenever the layout below changes
+    const std::uint32_t BYTE_ORDER_MARK = 0x01020304;        // Reads back differently on a machine of the other endianness
+
+    struct FileHeader{
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t byteOrder;
+        std::uint32_t vertexCount;
+        std::uint64_t edgeCount;
+        std::uint64_t maxWeight;
+        std::uint32_t queueKind;
+        std::uint32_t searchMode;
+        std::uint64_t offsetsAt;        // Byte offset of each section from the start of the file
+        std::uint64_t targetsAt;
+        std::uint64_t weightsAt;
+        std::uint64_t labelOffsetsAt;
+        std::uint64_t labelBytesAt;
+        std::uint64_t sortedIdsAt;
+        std::uint64_t fileSize;
+    };
+
+    /* Rounds a byte count up to the next section boundary. */
+    std::uint64_t align(std::uint64_t bytes){
+        return (bytes + 7) & ~std::uint64_t(7);
+    }
+
+    /* Writes count elements of type T, converting each one from its in-memory type. */
+    template<typename T, typename Iterator>
+    void writeArray(std::ofstream& file, Iterator first, Iterator last){
+        for(; first != last; ++first){
+            const T value = *first;
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        return;
+    }
+
+    /* Pads the file with zeros up to the next section boundary. */
+    void writePadding(std::ofstream& file, std::uint64_t written){
+        static const char zeros[8] = {0};
+        file.write(zeros, align(written) - written);
+
+        return;
+    }
+}
+
+/* Defined solely for course requirement. */
+MappedGraph::MappedGraph(){
+    // No logical implementation required
+}
+
+/* The mapping must be released, or it would outlive the object. */
+MappedGraph::~MappedGraph(){
+    close();
+}
+
+/* Section offsets are computed first, so the header can be written in one piece before the sections. Labels are
+   sorted here, once, so that open() has nothing left to build.                                                  */
+void MappedGraph::write(const FrozenGraph& graph, const std::string& fileName){
+    const unsigned int count = graph.vertexCount();
+    std::vector<std::uint64_t> labelOffsets(count + 1, 0);
+    for(unsigned int v = 0; v < count; ++v){
+        labelOffsets[v + 1] = labelOffsets[v] + graph.vertexLabel(v).size();
+    }
+    std::vector<std::uint32_t> sortedIds(count);
+    for(unsigned int v = 0; v < count; ++v){
+        sortedIds[v] = v;
+    }
+    std::sort(sortedIds.begin(), sortedIds.end(), [&](std::uint32_t a, std::uint32_t b){
+        return graph.vertexLabel(a) < graph.vertexLabel(b);
+    });
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FILE_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.vertexCount = count;
+    header.edgeCount = graph.edgeCount();
+    header.maxWeight = graph.getMaxWeight();
+    header.queueKind = static_cast<std::uint32_t>(graph.getQueueKind());
+    header.searchMode = static_cast<std::uint32_t>(graph.getSearchMode());
+    header.offsetsAt = align(sizeof(FileHeader));
+    header.targetsAt = header.offsetsAt + (std::uint64_t(count) + 1) * sizeof(std::uint64_t);
+    header.weightsAt = header.targetsAt + align(header.edgeCount * sizeof(std::uint32_t));
+    header.labelOffsetsAt = header.weightsAt + header.edgeCount * sizeof(std::uint64_t);
+    header.labelBytesAt = header.labelOffsetsAt + (std::uint64_t(count) + 1) * sizeof(std::uint64_t);
+    header.sortedIdsAt = header.labelBytesAt + align(labelOffsets[count]);
+    header.fileSize = header.sortedIdsAt + align(std::uint64_t(count) * sizeof(std::uint32_t));
+
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if(!file){
+        throw std::runtime_error("[ERROR] Unable to open graph file for writing. Unable to complete request.");
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writePadding(file, sizeof(header));
+    writeArray<std::uint64_t>(file, graph.offsets.begin(), graph.offsets.end());
+    writeArray<std::uint32_t>(file, graph.targets.begin(), graph.targets.end());
+    writePadding(file, header.edgeCount * sizeof(std::uint32_t));
+    writeArray<std::uint64_t>(file, graph.weights.begin(), graph.weights.end());
+    writeArray<std::uint64_t>(file, labelOffsets.begin(), labelOffsets.end());
+    for(unsigned int v = 0; v < count; ++v){
+        file.write(graph.vertexLabel(v).data(), graph.vertexLabel(v).size());
+    }
+    writePadding(file, labelOffsets[count]);
+    writeArray<std::uint32_t>(file, sortedIds.begin(), sortedIds.end());
+    writePadding(file, std::uint64_t(count) * sizeof(std::uint32_t));
+    if(!file){
+        throw std::runtime_error("[ERROR] Failed to write graph file. Unable to complete request.");
+    }
+
+    return;
+}
+
+/* Convenience for callers holding a mutable graph. */
+void MappedGraph::write(const Graph& graph, const std::string& fileName){
+    write(graph.freeze(), fileName);
+
+    return;
+}
+
+/* Every header field is checked against the real file size before any section pointer is set. One O(V + E) pass
+   then checks every index the searches follow: offsets and label offsets never decrease or leave their section,
+   and every target and sorted ID is a vertex. Weights must not exceed maxWeight, which sizes Dial's buckets. A
+   truncated, foreign or corrupt file is therefore rejected instead of being read out of bounds. The file
+   descriptor is not needed once the file is mapped. On any error, the graph is left closed.                     */
+void MappedGraph::open(const std::string& fileName){
+    close();
+    const int descriptor = ::open(fileName.c_str(), O_RDONLY);
+    if(descriptor < 0){
+        throw std::runtime_error("[ERROR] Unable to open graph file for reading. Unable to complete request.");
+    }
+    struct stat status;
+    if(fstat(descriptor, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(FileHeader))){
+        ::close(descriptor);
+        throw std::runtime_error("[ERROR] Graph file is too short. Unable to complete request.");
+    }
+    void* region = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if(region == MAP_FAILED){
+        throw std::runtime_error("[ERROR] Unable to map graph file. Unable to complete request.");
+    }
+    mapping = region;
+    mappingSize = status.st_size;
+
+    const FileHeader& header = *static_cast<const FileHeader*>(mapping);
+    const std::uint64_t nodes = header.vertexCount;
+    const bool valid = std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0
+                    && header.version == FILE_VERSION
+                    && header.byteOrder == BYTE_ORDER_MARK
+                    && header.fileSize == mappingSize
+                    && header.queueKind <= static_cast<std::uint32_t>(QueueKind::Buckets)
+                    && header.searchMode <= static_cast<std::uint32_t>(SearchMode::Bidirectional)
+                    && header.edgeCount <= header.fileSize     // Keeps the section sizes below from wrapping around
+                    && header.offsetsAt == align(sizeof(FileHeader))
+                    && header.targetsAt == header.offsetsAt + (nodes + 1) * sizeof(std::uint64_t)
+                    && header.weightsAt == header.targetsAt + align(header.edgeCount * sizeof(std::uint32_t))
+                    && header.labelOffsetsAt == header.weightsAt + header.edgeCount * sizeof(std::uint64_t)
+                    && header.labelBytesAt == header.labelOffsetsAt + (nodes + 1) * sizeof(std::uint64_t)
+                    && header.sortedIdsAt <= header.fileSize
+                    && header.sortedIdsAt + align(nodes * sizeof(std::uint32_t)) == header.fileSize;
+    if(!valid){
+        close();
+        throw std::runtime_error("[ERROR] Graph file is corrupted or from another version. Unable to complete request.");
+    }
+
+    const char* base = static_cast<const char*>(mapping);
+    vertices = header.vertexCount;
+    edges = header.edgeCount;
+    maxWeight = header.maxWeight;
+    queueKind = static_cast<QueueKind>(header.queueKind);
+    searchMode = static_cast<SearchMode>(header.searchMode);
+    offsets = reinterpret_cast<const std::uint64_t*>(base + header.offsetsAt);
+    targets = reinterpret_cast<const std::uint32_t*>(base + header.targetsAt);
+    weights = reinterpret_cast<const std::uint64_t*>(base + header.weightsAt);
+    labelOffsets = reinterpret_cast<const std::uint64_t*>(base + header.labelOffsetsAt);
+    labelBytes = base + header.labelBytesAt;
+    sortedIds = reinterpret_cast<const std::uint32_t*>(base + header.sortedIdsAt);
+    const std::uint64_t labelLength = header.sortedIdsAt - header.labelBytesAt;
+    bool consistent = offsets[0] == 0 && labelOffsets[0] == 0 && header.sortedIdsAt >= header.labelBytesAt;
+    for(unsigned int v = 0; consistent && v < vertices; ++v){
+        consistent = offsets[v] <= offsets[v + 1] && labelOffsets[v] <= labelOffsets[v + 1] && sortedIds[v] < vertices;
+    }
+    consistent = consistent && offsets[vertices] == edges && labelOffsets[vertices] <= labelLength;
+    for(std::size_t e = 0; consistent && e < edges; ++e){
+        consistent = targets[e] < vertices && weights[e] <= maxWeight;
+    }
+    if(!consistent){
+        close();
+        throw std::runtime_error("[ERROR] Graph file is corrupted or from another version. Unable to complete request.");
+    }
+
+    return;
+}
+
+/* Unmaps the file and forgets every section pointer. Safe to call on a closed graph. */
+void MappedGraph::close(){
+    if(mapping != nullptr){
+        munmap(mapping, mappingSize);
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    vertices = 0;
+    edges = 0;
+    maxWeight = 0;
+    offsets = nullptr;
+    targets = nullptr;
+    weights = nullptr;
+    labelOffsets = nullptr;
+    labelBytes = nullptr;
+    sortedIds = nullptr;
+
+    return;
+}
+
+/* Read-only, so constant. */
+bool MappedGraph::isOpen() const{
+    return mapping != nullptr;
+}
+
+/* Same steps as FrozenGraph::shortestPath(). Labels are found by binary search instead of hashing. */
+unsigned long MappedGraph::shortestPath(const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path) const{
+    SEARCH_STATS(SearchStats::QueryScope statsQuery("mapped"));
+    // Ensure that the file contains the correct vertices to process
+    const unsigned int start = findId(startLabel);
+    const unsigned int end = findId(endLabel);
+    if(start == LabelTable::NO_ID || end == LabelTable::NO_ID){
+        throw std::invalid_argument("[ERROR] One or more specified vertex does not exist. Unable to complete request.");
+    }
+
+    SearchWorkspace& workspace = SearchWorkspace::local();
+    unsigned int meet = end;    // Vertex where the forward path ends and the backward path begins
+    unsigned long distance;
+    if(searchMode == SearchMode::Bidirectional){
+        distance = bidirectionalDijkstra(*this, vertices, queueKind, maxWeight, start, end, workspace, meet);
+    }
+    else{
+        distance = dijkstra(*this, vertices, queueKind, maxWeight, start, end, workspace);
+    }
+    if(distance == ULONG_MAX){
+        throw std::logic_error("[ERROR] No path exists between the start and end vertices");  // Throw if no path is found
+    }
+    SEARCH_STATS(SearchStats::PhaseTimer reconstructTimer(SearchStats::Reconstruct));
+    reconstruct(path, workspace.forward(), start, meet);
+    if(meet != end){    // The backward half is emitted from end to meet, so it is appended in reverse
+        std::vector<std::string> backwardPath;
+        reconstruct(backwardPath, workspace.backward(), end, meet);
+        path.insert(path.end(), backwardPath.rbegin() + 1, backwardPath.rend());
+    }
+
+    return distance;
+}
+
+/* Read-only, so constant. */
+unsigned int MappedGraph::vertexCount() const{
+    return vertices;
+}
+
+/* Read-only, so constant. */
+std::size_t MappedGraph::edgeCount() const{
+    return edges;
+}
+
+/* Label-to-ID lookup for callers that want to work on dense IDs. */
+unsigned int MappedGraph::vertexId(const std::string& label) const{
+    const unsigned int id = findId(label);
+    if(id == LabelTable::NO_ID){
+        throw std::invalid_argument("[ERROR] Specified vertex does not exist. Unable to complete request.");
+    }
+
+    return id;
+}
+
+/* Labels are stored without terminators, so each one is copied out by length. */
+std::string MappedGraph::vertexLabel(unsigned int id) const{
+    if(id >= vertices){ // Data security check
+        throw std::out_of_range("[ERROR] Specified vertex ID is not assigned. Unable to complete request.");
+    }
+
+    return std::string(labelBytes + labelOffsets[id], labelOffsets[id + 1] - labelOffsets[id]);
+}
+
+/* Takes effect on the next shortestPath() call. */
+void MappedGraph::setQueueKind(QueueKind kind){
+    queueKind = kind;
+
+    return;
+}
+
+/* Read-only, so constant. */
+QueueKind MappedGraph::getQueueKind() const{
+    return queueKind;
+}
+
+/* Takes effect on the next shortestPath() call. */
+void MappedGraph::setSearchMode(SearchMode mode){
+    searchMode = mode;
+
+    return;
+}
+
+/* Read-only, so constant. */
+SearchMode MappedGraph::getSearchMode() const{
+    return searchMode;
+}
+
+/* Read-only, so constant. */
+unsigned long MappedGraph::getMaxWeight() const{
+    return maxWeight;
+}
+
+/* Lower-bound binary search over the IDs sorted by label. Labels are compared in place, with the same ordering as
+   std::string::operator< used by write().                                                                        */
+unsigned int MappedGraph::findId(const std::string& label) const{
+    const auto compare = [&](std::uint32_t id){  // > 0, 0 or < 0 as label sorts after, equal to or before the label of id
+        return label.compare(0, std::string::npos, labelBytes + labelOffsets[id], labelOffsets[id + 1] - labelOffsets[id]);
+    };
+    std::size_t low = 0, high = vertices;
+    while(low < high){
+        const std::size_t mid = low + (high - low) / 2;
+        if(compare(sortedIds[mid]) > 0){
+            low = mid + 1;
+        }
+        else{
+            high = mid;
+        }
+    }
+    if(low < vertices && compare(sortedIds[low]) == 0){
+        return sortedIds[low];
+    }
+
+    return LabelTable::NO_ID;
+}
+
+/* Same logic as FrozenGraph::reconstruct(). */
+void MappedGraph::reconstruct(std::vector<std::string> &fnlPath, const SearchLabels& fnlEdges, unsigned int start, unsigned int end) const{
+    if(start == end){   // For one-vertex circular path
+        fnlPath.push_back(vertexLabel(start));
+        return;
+    }
+
+    const std::size_t first = fnlPath.size();   // Only reverse what this call appends
+    unsigned int curr = end;
+    while(curr != start){
+        fnlPath.push_back(vertexLabel(curr));
+        curr = fnlEdges.parent(curr);
+    }
+    fnlPath.push_back(vertexLabel(start));
+    std::reverse(fnlPath.begin() + first, fnlPath.end());
+
+    return;
+}
@@ -0,0 +1,88 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a read-only graph which lives
+   in a memory-mapped file. write() stores a FrozenGraph in
+   a versioned binary layout, and open() maps that file with
+   mmap(). Nothing is parsed or copied on open(): the CSR
+   arrays, the label table and a label index sorted by
+   label are used in place, straight from the page cache.
+   Every process that opens the same file shares the same
+   physical pages, and pages are only read from disk when a
+   query first touches them.
+
+   The file holds, in order: a fixed-size header (magic,
+   version, byte-order mark, counts and section offsets),
+   the CSR offsets, targets and weights of FrozenGraph, the
+   label offsets and label bytes, and the IDs sorted by
+   label. Every section starts on an 8-byte boundary, so
+   each one can be read directly as an array. Labels are
+   found by binary search over the sorted IDs.
+
+   shortestPath() follows the same contract as
+   FrozenGraph::shortestPath(), and forEachNeighbor() lets
+   the templates of Dijkstra.hpp run on the mapped arrays.   */
+
+#ifndef MAPPEDGRAPH_HPP
+#define MAPPEDGRAPH_HPP
+
+#include "FrozenGraph.hpp"
+#include "Graph.hpp"
+#include "Dijkstra.hpp"
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class MappedGraph{
+public:
+    MappedGraph();  // Closed graph. Opened by open()
+    ~MappedGraph(); // Unmaps the file. Calls close()
+    MappedGraph(const MappedGraph&) = delete;
+    MappedGraph& operator=(const MappedGraph&) = delete;
+    static void write(const FrozenGraph& graph, const std::string& fileName);  // Stores graph in the format read by open()
+    static void write(const Graph& graph, const std::string& fileName);        // Same as above, for graph.freeze()
+    void open(const std::string& fileName); // Maps a file written by write(), replacing any file mapped before
+    void close();   // Unmaps the file
+    bool isOpen() const;
+    unsigned long shortestPath(const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path) const; // Same contract as FrozenGraph::shortestPath()
+    unsigned int vertexCount() const;   // Number of vertices (dense IDs are 0 to vertexCount() - 1)
+    std::size_t edgeCount() const;      // Number of directed edges (each undirected edge is stored twice)
+    unsigned int vertexId(const std::string& label) const;  // Translates a label to its dense ID. Throws if not found
+    std::string vertexLabel(unsigned int id) const;         // Translates a dense ID back to its label
+    void setQueueKind(QueueKind kind);  // Selects the priority queue used by shortestPath(). Read from the file by open()
+    QueueKind getQueueKind() const;
+    void setSearchMode(SearchMode mode);    // Selects one- or two-sided search in shortestPath(). Read from the file by open()
+    SearchMode getSearchMode() const;
+    unsigned long getMaxWeight() const; // Largest edge weight, drives QueueKind::Automatic
+
+    template<typename Visit>
+    void forEachNeighbor(unsigned int id, Visit visit) const{   // Calls visit(neighbor ID, weight) for each neighbor of id. Used by dijkstra()
+        for(std::uint64_t i = offsets[id]; i < offsets[id + 1]; ++i){
+            visit(targets[i], static_cast<unsigned long>(weights[i]));
+        }
+    }
+
+protected:
+    unsigned int findId(const std::string& label) const;    // Binary search of the sorted index, NO_ID if absent
+    void reconstruct(std::vector<std::string> &fnlPath, const SearchLabels& fnlEdges, unsigned int start, unsigned int end) const; // Same as FrozenGraph::reconstruct()
+
+private:
+    void* mapping = nullptr;        // Start of the mapped file
+    std::size_t mappingSize = 0;    // Length of the mapping in bytes
+    unsigned int vertices = 0;
+    std::uint64_t edges = 0;
+    unsigned long maxWeight = 0;
+    QueueKind queueKind = QueueKind::Automatic;
+    SearchMode searchMode = SearchMode::Unidirectional;
+    const std::uint64_t* offsets = nullptr;      // vertices + 1 entries, as in FrozenGraph
+    const std::uint32_t* targets = nullptr;      // edges entries
+    const std::uint64_t* weights = nullptr;      // edges entries
+    const std::uint64_t* labelOffsets = nullptr; // vertices + 1 entries. Label of v is labelBytes[labelOffsets[v], labelOffsets[v + 1])
+    const char* labelBytes = nullptr;
+    const std::uint32_t* sortedIds = nullptr;    // vertices entries, IDs in ascending label order
+};
+
+#endif
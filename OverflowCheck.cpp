@@ -0,0 +1,97 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines the overflow regression check,
+   built as the shortestpath_overflow_check executable and
+   run by ctest. Its graph is the path a-b-c, whose two
+   edges each weigh ULONG_MAX / 2 + 10, so the a-c distance
+   does not fit in an unsigned long. A plain sum wraps it
+   around to 18. Every engine must instead report that no
+   path exists, while still answering a-b exactly. The
+   check prints one line per failure and exits non-zero if
+   there is any.                                             */
+
+#include "Graph.hpp"
+#include "FrozenGraph.hpp"
+#include "ContractionHierarchy.hpp"
+#include "HubLabels.hpp"
+#include "Landmarks.hpp"
+#include "ThreadPool.hpp"
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include <climits>
+
+namespace{
+    const unsigned long HALF_WEIGHT = ULONG_MAX / 2 + 10;  // Two of these overflow
+
+    /* Runs query, mapping the "no path" exception to ULONG_MAX. Any other exception propagates. */
+    template<typename Query>
+    unsigned long distanceOf(Query query){
+        try{
+            return query();
+        }
+        catch(const std::logic_error& e){
+            if(std::string(e.what()).find("No path") == std::string::npos){
+                throw;
+            }
+            return ULONG_MAX;
+        }
+    }
+
+    /* Prints a failure line if actual differs from expected. Returns 1 on failure, so results can be summed. */
+    int expect(const std::string& engine, unsigned long actual, unsigned long expected){
+        if(actual == expected){
+            return 0;
+        }
+        std::cout << "[FAIL] " << engine << " returned " << actual << ", expected " << expected << std::endl;
+        return 1;
+    }
+}
+
+int main(){
+    try{
+        Graph graph;
+        graph.addVertex("a");
+        graph.addVertex("b");
+        graph.addVertex("c");
+        graph.addEdge("a", "b", HALF_WEIGHT);
+        graph.addEdge("b", "c", HALF_WEIGHT);
+        const FrozenGraph frozen = graph.freeze();
+        ThreadPool pool(1);
+        ContractionHierarchy hierarchy;
+        hierarchy.build(frozen);
+        HubLabels hubs;
+        hubs.build(frozen, hierarchy, pool);
+        Landmarks landmarks;
+        landmarks.build(frozen, 1);
+
+        int failures = 0;
+        for(const std::string& end : {std::string("b"), std::string("c")}){
+            const unsigned long expected = end == "b" ? HALF_WEIGHT : ULONG_MAX;
+            std::vector<std::string> path;
+            failures += expect("graph a-" + end, distanceOf([&]{ path.clear(); return graph.shortestPath("a", end, path); }), expected);
+            failures += expect("frozen a-" + end, distanceOf([&]{ path.clear(); return frozen.shortestPath("a", end, path); }), expected);
+            failures += expect("ch a-" + end, distanceOf([&]{ path.clear(); return hierarchy.shortestPath(frozen, "a", end, path); }), expected);
+            failures += expect("ch distance a-" + end, hierarchy.distance(frozen.vertexId("a"), frozen.vertexId(end)), expected);
+            failures += expect("ch matrix a-" + end, hierarchy.distanceMatrix(frozen, {"a"}, {end}, pool)[0], expected);
+            failures += expect("hl a-" + end, distanceOf([&]{ return hubs.distance(frozen, "a", end); }), expected);
+            failures += expect("hl path a-" + end, distanceOf([&]{ path.clear(); return hubs.shortestPath(frozen, hierarchy, "a", end, path); }), expected);
+            failures += expect("alt a-" + end, distanceOf([&]{ path.clear(); return landmarks.shortestPath(frozen, "a", end, path); }), expected);
+            failures += expect("frozen matrix a-" + end, frozen.distanceMatrix({"a"}, {end}, pool)[0], expected);
+        }
+        if(failures > 0){
+            return 1;
+        }
+    }
+    catch(const std::exception& e){
+        std::cout << "[FAIL] " << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "overflow check passed" << std::endl;
+
+    return 0;
+}
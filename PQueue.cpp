@@ -12,35 +12,77 @@
    of the most recently viewed vertex and pursue the next
    step in the shortest path to the target. Once Dijkstra's
    algorithm is complete, the top PQueue element should
-   contain the shortest total distance to the target vertex.  */
+   contain the shortest total distance to the target vertex.
+
+   The heap is indexed by vertex ID: a second vector records
+   where each ID currently sits in the heap. This allows
+   push() to lower the key of a vertex which is already
+   queued (decrease-key) instead of inserting a duplicate,
+   so the queue never holds more than one element per
+   vertex. Each parent has a configurable number of
+   children (arity). A 4-ary heap is the default because it
+   halves the height of a binary heap while keeping all
+   children of a node within one or two cache lines.         */
 
 #include "PQueue.hpp"
 
 #include <vector>
 #include <stdexcept>
 
-/* Defined solely for course requirement. */
-PQueue::PQueue(){
-    // No logical implementation required
+/* Validates the arity. Anything below 2 would not be a tree. */
+PQueue::PQueue(int arity) : arity(arity){
+    if(arity < 2){
+        throw std::invalid_argument("[ERROR]: Heap arity must be at least 2. Unable to complete request.");
+    }
 }
 
 /* Redundant, but satisfies course requirement.
    Abstracts STL vector clear().                */
 PQueue::~PQueue(){
-    heapQueue.clear();
+    clear();
 }
 
 /* Maintains heap property by first inserting a
    new node at the end of the vector. Afterwards,
-   the new node is bubbled up as needed.          */
+   the new node is bubbled up as needed. If the
+   ID is already queued, its key is lowered in
+   place instead, and a larger key is ignored.    */
 void PQueue::push(const Vertex& newNode){
+    const unsigned int id = newNode.get_id();
+    if(contains(id)){
+        if(newNode < heapQueue[position[id]]){
+            decrease_key(id, newNode.get_distance());
+        }
+        return;
+    }
+    if(id >= position.size()){
+        position.resize(id + 1, NOT_QUEUED);
+    }
     heapQueue.push_back(newNode);
     int indexLast = heapQueue.size() - 1;
+    position[id] = indexLast;
     bubble_up(indexLast);   // Variable indexLast used for explicit logic
 
     return;
 }
 
+/* Lowering a key can only break the heap property
+   between the node and its parents, so the node is
+   bubbled up from where it currently sits.          */
+void PQueue::decrease_key(unsigned int id, unsigned long distance){
+    if(!contains(id)){  // Data security check
+        throw std::invalid_argument("[ERROR]: Specified vertex is not queued. Unable to complete request.");
+    }
+    const int index = position[id];
+    if(distance > heapQueue[index].get_distance()){
+        throw std::invalid_argument("[ERROR]: New key is larger than the current key. Unable to complete request.");
+    }
+    heapQueue[index] = Vertex(distance, id);
+    bubble_up(index);
+
+    return;
+}
+
 /* Maintains heap property by first copying
    last node to the top of the queue. Last
    node is then popped, and first node is
@@ -49,6 +91,7 @@ void PQueue::pop(){
     if(heapQueue.empty()){  // Data security check
         throw std::runtime_error("[ERROR]: Queue is empty. Unable to complete request.");
     }
+    position[heapQueue[0].get_id()] = NOT_QUEUED;
     heapQueue[0] = heapQueue.back();    // If only one element was enqueued...
     heapQueue.pop_back();               // ...this is all that is needed
     if(heapQueue.empty()){
@@ -56,6 +99,7 @@ void PQueue::pop(){
     }
     else{
         int indexFirst = 0;             // If still one or more elements remain...
+        position[heapQueue[indexFirst].get_id()] = indexFirst;
         bubble_down(indexFirst);        // ...then bubble the new top element down
     }
 
@@ -71,20 +115,46 @@ const Vertex& PQueue::top() const{
     return heapQueue[0];
 }
 
+/* Read-only, so constant. */
+bool PQueue::contains(unsigned int id) const{
+    return id < position.size() && position[id] != NOT_QUEUED;
+}
+
+/* Growing the index only ever adds NOT_QUEUED slots,
+   so this is safe to call while elements are queued. */
+void PQueue::reserve(unsigned int capacity){
+    if(capacity > position.size()){
+        position.resize(capacity, NOT_QUEUED);
+    }
+    heapQueue.reserve(capacity);
+
+    return;
+}
+
 /* Read-only, so constant. */
 int PQueue::get_size() const{
     return heapQueue.size();
 }
 
+/* Read-only, so constant. */
+int PQueue::get_arity() const{
+    return arity;
+}
+
 /* Read-only, so constant. */
 bool PQueue::empty() const{
     return heapQueue.empty();
 }
 
 /* Calls STL vector function clear() to deallocate priority queue.
+   Only the positions of queued IDs are reset, so clearing after an
+   early exit costs the size of the queue, not the size of the graph.
    Although STL vector.size() may exceed int range, main() will restrict
    the number of neighbors to stay within int bounds.                 */
 void PQueue::clear(){
+    for(auto it = heapQueue.begin(); it != heapQueue.end(); ++it){
+        position[it->get_id()] = NOT_QUEUED;
+    }
     heapQueue.clear();
 
     return;
@@ -92,69 +162,72 @@ void PQueue::clear(){
 
 /* Zero-indexed vector logic for locating parent. */
 int PQueue::find_parent(int child){
-    return (child - 1) / 2;
-}
-
-/* Zero-indexed vector logic for locating left child. */
-int PQueue::find_left(int parent){
-    return (parent * 2) + 1;
+    return (child - 1) / arity;
 }
 
-/* Zero-indexed vector logic for locating right child. */
-int PQueue::find_right(int parent){
-    return (parent * 2) + 2;
+/* Zero-indexed vector logic for locating the first child.
+   The remaining children follow it contiguously.          */
+int PQueue::find_first_child(int parent){
+    return (parent * arity) + 1;
 }
 
-/* Helpers used to condense logic. Function
-   examines last node and moves it higher
-   in the priority queue as needed. Utilizes
-   Vertex::operator>() for comparisons.      */
+/* Helpers used to condense logic. Function examines a
+   node and moves it higher in the priority queue as
+   needed. Instead of swapping at every level, parents
+   are shifted down into the hole and the node is
+   stored once. Utilizes Vertex::operator>() for
+   comparisons.                                         */
 void PQueue::bubble_up(int child){
-    int parent = find_parent(child);
-    while(child != 0 && parent >= 0 && heapQueue[parent] > heapQueue[child]){  // Use custom operator>() from class Vertex
-        swap(child, parent);
+    const Vertex node = heapQueue[child];
+    while(child != 0){
+        int parent = find_parent(child);
+        if(!(heapQueue[parent] > node)){   // Use custom operator>() from class Vertex
+            break;
+        }
+        place(child, heapQueue[parent]);
         child = parent;
-        parent = find_parent(child);
     }
-    
+    place(child, node);
+
     return;
 }
 
-/* Helpers used to condense logic. Recursive
-   function examines first node and moves it
-   lower in the priority queue as needed.
-   Utilizes Vertex::operator<() for comparisons. */
+/* Helpers used to condense logic. Iterative function
+   examines a node and moves it lower in the priority
+   queue as needed. The smallest of up to arity children
+   is shifted up into the hole until no child is smaller
+   than the node. Utilizes Vertex::operator<() for
+   comparisons.                                          */
 void PQueue::bubble_down(int parent){
-    int childL = find_left(parent);
-    int childR = find_right(parent);
-    int smallest = parent;
-
-    if(childL < heapQueue.size()){   // Safely compare left child
-        if(heapQueue[childL] < heapQueue[smallest]){     // Use custom operator<() from class Vertex
-            smallest = childL;       // Update index of smallest key if needed
+    const int size = heapQueue.size();
+    const Vertex node = heapQueue[parent];
+    while(true){
+        int first = find_first_child(parent);
+        if(first >= size){      // Leaf, nothing below to compare against
+            break;
         }
-    }
-
-    if(childR < heapQueue.size()){  // Safely compare right child
-        if(heapQueue[childR] < heapQueue[smallest]){    // Use custom operator<() from class Vertex
-            smallest = childR;      // Update index of smallest key if needed
+        int last = first + arity < size ? first + arity : size;
+        int smallest = first;
+        for(int child = first + 1; child < last; ++child){
+            if(heapQueue[child] < heapQueue[smallest]){  // Use custom operator<() from class Vertex
+                smallest = child;   // Update index of smallest key if needed
+            }
         }
+        if(!(heapQueue[smallest] < node)){  // If no child is smaller than the node, it has found its place
+            break;
+        }
+        place(parent, heapQueue[smallest]);
+        parent = smallest;
     }
-
-    if(smallest != parent){        // If the smallest key isn't the parent...
-        swap(smallest, parent);    // ...swap the parent with the smallest
-        bubble_down(smallest);          // ...and see if bubble down is needed again
-    }
+    place(parent, node);
 
     return;
 }
 
-/* Swaps two nodes in the vector-base heap. */
-void PQueue::swap(int i, int j){
-    Vertex temp = heapQueue[i];
-    heapQueue[i] = heapQueue[j];
-    heapQueue[j] = temp;
+/* Stores a node in the vector-based heap and records its index. */
+void PQueue::place(int index, const Vertex& node){
+    heapQueue[index] = node;
+    position[node.get_id()] = index;
 
     return;
 }
-
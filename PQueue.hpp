@@ -12,7 +12,17 @@
    of the most recently viewed vertex and pursue the next
    step in the shortest path to the target. Once Dijkstra's
    algorithm is complete, the top PQueue element should
-   contain the shortest total distance to the target vertex.  */
+   contain the shortest total distance to the target vertex.
+
+   The heap is indexed by vertex ID: a second vector records
+   where each ID currently sits in the heap. This allows
+   push() to lower the key of a vertex which is already
+   queued (decrease-key) instead of inserting a duplicate,
+   so the queue never holds more than one element per
+   vertex. Each parent has a configurable number of
+   children (arity). A 4-ary heap is the default because it
+   halves the height of a binary heap while keeping all
+   children of a node within one or two cache lines.         */
 
 #ifndef PQUEUE_HPP
 #define PQUEUE_HPP
@@ -20,30 +30,36 @@
 #include "Vertex.hpp"
 
 #include <vector>
+#include <climits>
 
 class PQueue {
 public:
-    PQueue();   // Default constructor included to fulfill course requirements
+    static constexpr unsigned int NOT_QUEUED = UINT_MAX;   // Position of an ID which is not in the queue
+
+    PQueue(int arity = 4);  // Number of children per parent. 2, 4 and 8 are the intended values
     ~PQueue();  // Default destructor included to fulfill course requirements. Calls clear()
-    void push(const Vertex& newNode);  // Inserts new element and calls bubble_up()
+    void push(const Vertex& newNode);  // Inserts new element, or lowers the key of an already queued ID. Calls bubble_up()
+    void decrease_key(unsigned int id, unsigned long distance);    // Lowers the key of a queued ID. Calls bubble_up()
     void pop(); // Removes first element, maintaining heap property with STL vector functions. Calls bubble_down()
     const Vertex& top() const;  // Returns first element in queue
+    bool contains(unsigned int id) const;   // True if id is currently queued
+    void reserve(unsigned int capacity);    // Sizes the position index for IDs below capacity, avoiding growth during a search
     int get_size() const;   // Not needed for the bounds of this assignment, but added for light modularity
+    int get_arity() const;  // Number of children per parent
     bool empty() const; // Helper function, used in multiple member functions
     void clear();  // Helper function, uses STL vector clear
 
 protected:
     int find_parent(int indexChild);         // Helper function, encapsulates redundant logic
-    int find_left(int indexParent);          // Helper function, encapsulates redundant logic
-    int find_right(int indexParent);         // Helper function, encapsulates redundant logic
-    void bubble_up(int indexChild);     // Helper function, swaps a child with its parent as needed
-    void bubble_down(int indexParent);  // Helper function, swaps a parent with its child as needed
-    void swap(int i, int j);
+    int find_first_child(int indexParent);   // Helper function, encapsulates redundant logic
+    void bubble_up(int indexChild);     // Helper function, moves a child above its parents as needed
+    void bubble_down(int indexParent);  // Helper function, moves a parent below its children as needed
+    void place(int index, const Vertex& node);  // Stores node at index and records that position
 
 private:
-    std::vector<Vertex> heapQueue;  // Location of zero-indexed min-priority queue
+    int arity;  // Children per parent
+    std::vector<Vertex> heapQueue;      // Location of zero-indexed min-priority queue
+    std::vector<unsigned int> position; // (index/value) = (vertex ID/index in heapQueue, or NOT_QUEUED)
 };
 
 #endif
-
-
@@ -0,0 +1,133 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a monotone min-priority queue
+   for integer keys, known as a radix heap. It offers the
+   same push()/pop()/top() interface as class PQueue, but
+   relies on a property of Dijkstra's algorithm: a key is
+   never smaller than the last key popped. Elements are kept
+   in 65 buckets. Bucket 0 holds keys equal to the last
+   popped key, and bucket i holds keys whose highest bit
+   differing from the last popped key is bit i - 1. When
+   bucket 0 runs empty, the first non-empty bucket is
+   redistributed around its own minimum, and each element
+   can only move to a lower bucket. Every element is
+   therefore moved at most 64 times, and no element is ever
+   compared against another one to find its place.
+
+   There is no decrease-key. Improved distances are pushed
+   again, and the caller discards the stale entries.         */
+
+#include "RadixHeap.hpp"
+
+#include <vector>
+#include <stdexcept>
+#include <climits>
+
+/* One bucket for "equal to lastKey" plus one per bit of an unsigned long. */
+RadixHeap::RadixHeap() : buckets(sizeof(unsigned long) * CHAR_BIT + 1){
+    // No further logic required
+}
+
+/* Redundant, but satisfies course requirement. */
+RadixHeap::~RadixHeap(){
+    clear();
+}
+
+/* Places the new node directly in its bucket. No comparison against other
+   keys is needed. An empty queue accepts any key, which lets a drained
+   queue be reused for a new search without calling clear() first.        */
+void RadixHeap::push(const Vertex& newNode){
+    if(newNode.get_distance() < lastKey){
+        if(size > 0){   // Data security check, keys must be monotone
+            throw std::invalid_argument("[ERROR]: Key is smaller than the last popped key. Unable to complete request.");
+        }
+        lastKey = newNode.get_distance();
+    }
+    buckets[find_bucket(newNode.get_distance())].push_back(newNode);
+    ++size;
+
+    return;
+}
+
+/* Every element of bucket 0 has the minimum key, so
+   any of them may be removed. The last one is cheapest. */
+void RadixHeap::pop(){
+    top();  // Data security check, and ensures that bucket 0 holds the minimum
+    buckets[0].pop_back();
+    --size;
+
+    return;
+}
+
+/* Not constant: if bucket 0 is empty, the minimum is first
+   moved into it. Keys pushed after the last pop() may be
+   smaller than any key queued before, so this cannot be
+   done ahead of time.                                      */
+const Vertex& RadixHeap::top(){
+    if(empty()){    // Data security check
+        throw std::runtime_error("[ERROR]: Queue is empty. Unable to complete request.");
+    }
+    if(buckets[0].empty()){
+        refill();
+    }
+
+    return buckets[0].back();
+}
+
+/* Read-only, so constant. */
+int RadixHeap::get_size() const{
+    return size;
+}
+
+/* Read-only, so constant. */
+bool RadixHeap::empty() const{
+    return size == 0;
+}
+
+/* Calls STL vector function clear() on every bucket. */
+void RadixHeap::clear(){
+    for(auto it = buckets.begin(); it != buckets.end(); ++it){
+        it->clear();
+    }
+    lastKey = 0;
+    size = 0;
+
+    return;
+}
+
+/* Bucket 0 for keys equal to lastKey, otherwise one
+   plus the index of the highest differing bit.       */
+int RadixHeap::find_bucket(unsigned long key) const{
+    if(key == lastKey){
+        return 0;
+    }
+
+    return sizeof(unsigned long) * CHAR_BIT - __builtin_clzl(key ^ lastKey);
+}
+
+/* Finds the first non-empty bucket, makes its minimum the new lastKey
+   and moves every element of that bucket to a lower one. At least the
+   minimum itself lands in bucket 0. Only called while bucket 0 is
+   empty, so lastKey never passes a key which is still queued.        */
+void RadixHeap::refill(){
+    int index = 1;
+    while(buckets[index].empty()){  // size > 0 guarantees a non-empty bucket
+        ++index;
+    }
+    std::vector<Vertex>& source = buckets[index];
+    unsigned long minKey = source[0].get_distance();
+    for(auto it = source.begin(); it != source.end(); ++it){
+        if(it->get_distance() < minKey){
+            minKey = it->get_distance();
+        }
+    }
+    lastKey = minKey;
+    for(auto it = source.begin(); it != source.end(); ++it){
+        buckets[find_bucket(it->get_distance())].push_back(*it);
+    }
+    source.clear();
+
+    return;
+}
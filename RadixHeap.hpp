@@ -0,0 +1,50 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a monotone min-priority queue
+   for integer keys, known as a radix heap. It offers the
+   same push()/pop()/top() interface as class PQueue, but
+   relies on a property of Dijkstra's algorithm: a key is
+   never smaller than the last key popped. Elements are kept
+   in 65 buckets. Bucket 0 holds keys equal to the last
+   popped key, and bucket i holds keys whose highest bit
+   differing from the last popped key is bit i - 1. When
+   bucket 0 runs empty, the first non-empty bucket is
+   redistributed around its own minimum, and each element
+   can only move to a lower bucket. Every element is
+   therefore moved at most 64 times, and no element is ever
+   compared against another one to find its place.
+
+   There is no decrease-key. Improved distances are pushed
+   again, and the caller discards the stale entries.         */
+
+#ifndef RADIXHEAP_HPP
+#define RADIXHEAP_HPP
+
+#include "Vertex.hpp"
+
+#include <vector>
+
+class RadixHeap{
+public:
+    RadixHeap();    // Default constructor, creates the 65 empty buckets
+    ~RadixHeap();   // Default destructor included to fulfill course requirements. Calls clear()
+    void push(const Vertex& newNode);   // Inserts new element. Its key must not be smaller than the last popped key
+    void pop();     // Removes first element. Calls refill() if bucket 0 is empty
+    const Vertex& top();        // Returns first element in queue. Calls refill() if bucket 0 is empty
+    int get_size() const;   // Number of queued elements, including stale ones
+    bool empty() const;     // Helper function, used in multiple member functions
+    void clear();   // Empties all buckets and resets the last popped key to 0
+
+protected:
+    int find_bucket(unsigned long key) const;   // Helper function, bucket index of key relative to lastKey
+    void refill();  // Helper function, redistributes the first non-empty bucket so that bucket 0 is filled
+
+private:
+    std::vector<std::vector<Vertex>> buckets;   // 65 buckets, see above
+    unsigned long lastKey = 0;  // Last minimum found by refill(), and lower bound on every queued key
+    int size = 0;               // Total elements across buckets
+};
+
+#endif
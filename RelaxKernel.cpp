@@ -0,0 +1,254 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines the edge relaxation kernel used
+   by the templates of Dijkstra.hpp on graphs whose
+   neighbors sit in contiguous arrays (BasicFrozenGraph).
+   Given the settled distance of a vertex and a block of its
+   neighbors, relax() adds each edge weight to the distance,
+   saturating at ULONG_MAX, compares every sum with the
+   neighbor's tentative distance in SearchLabels, and writes
+   out only the neighbors whose distance improves. The
+   caller then updates the labels and the queue for those.
+
+   The kernel is compiled three times:
+       Scalar  one neighbor at a time, runs anywhere
+       Sse42   two neighbors per step; the sums and
+               comparisons run in 128-bit registers
+       Avx2    four neighbors per step; the tentative
+               distances are also fetched with gathers
+   and one is picked at run time, on first use: Avx2 if the
+   CPU supports it, Scalar otherwise. Reading the tentative
+   distances dominates, so without gathers Sse42 is no
+   faster than Scalar and is only run when select() asks
+   for it, which is how the benchmark compares them. Blocks
+   shorter than VECTOR_MIN always run Scalar. On compilers
+   or CPUs without x86 vector extensions only Scalar exists.
+   All three give the same results.                          */
+
+#include "RelaxKernel.hpp"
+#include "WeightTraits.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <string>
+#include <stdexcept>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define RELAX_KERNEL_X86 1  // GCC and Clang can compile AVX2 and SSE4.2 functions without global -m flags
+#include <immintrin.h>
+#endif
+
+namespace{
+    std::atomic<RelaxKernel::Isa> current{RelaxKernel::Isa::Automatic};   // Resolved by the first selected()
+
+    struct SlotView{    // Raw layout of SearchLabels, for the gathers
+        const unsigned char* base;  // Slot of ID 0
+        unsigned long generation;   // Current generation. A slot of any other generation is unreached
+    };
+
+    /* Reference kernel. Every other variant must write exactly what this one writes. */
+    template<typename Weight>
+    std::size_t relaxScalar(unsigned long distance, const unsigned int* targets, const Weight* weights, std::size_t count, const SearchLabels& labels, unsigned int* improvedIds, unsigned long* improvedDistances){
+        std::size_t improved = 0;
+        for(std::size_t i = 0; i < count; ++i){
+            const unsigned long testD = saturatingAdd(distance, weights[i]);
+            if(testD < labels.distance(targets[i])){
+                improvedIds[improved] = targets[i];
+                improvedDistances[improved] = testD;
+                ++improved;
+            }
+        }
+
+        return improved;
+    }
+
+#ifdef RELAX_KERNEL_X86
+    __attribute__((target("sse4.2")))
+    __m128i loadWeights2(const unsigned long* weights){
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights));
+    }
+
+    __attribute__((target("sse4.2")))
+    __m128i loadWeights2(const unsigned int* weights){
+        return _mm_cvtepu32_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(weights)));
+    }
+
+    /* Two lanes per step. SSE has no gather, so the tentative distances are read one by one, and the vector work is the
+       saturating add and the unsigned compare. Unsigned 64-bit order is signed order with the sign bit flipped.      */
+    template<typename Weight>
+    __attribute__((target("sse4.2")))
+    std::size_t relaxSse42(unsigned long distance, const unsigned int* targets, const Weight* weights, std::size_t count, const SearchLabels& labels, unsigned int* improvedIds, unsigned long* improvedDistances){
+        const __m128i sign = _mm_set1_epi64x(LLONG_MIN);
+        const __m128i base = _mm_set1_epi64x(distance);
+        const __m128i flippedBase = _mm_xor_si128(base, sign);
+        std::size_t improved = 0;
+        std::size_t i = 0;
+        for(; i + 2 <= count; i += 2){
+            const __m128i known = _mm_set_epi64x(labels.distance(targets[i + 1]), labels.distance(targets[i]));
+            __m128i sum = _mm_add_epi64(base, loadWeights2(weights + i));
+            sum = _mm_or_si128(sum, _mm_cmpgt_epi64(flippedBase, _mm_xor_si128(sum, sign)));  // Wrapped past ULONG_MAX, saturate
+            int mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(_mm_xor_si128(known, sign), _mm_xor_si128(sum, sign))));
+            if(mask != 0){
+                alignas(16) unsigned long lanes[2];
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes), sum);
+                for(; mask != 0; mask &= mask - 1){
+                    const int lane = __builtin_ctz(mask);
+                    improvedIds[improved] = targets[i + lane];
+                    improvedDistances[improved] = lanes[lane];
+                    ++improved;
+                }
+            }
+        }
+
+        return improved + relaxScalar(distance, targets + i, weights + i, count - i, labels, improvedIds + improved, improvedDistances + improved);
+    }
+
+    __attribute__((target("avx2")))
+    __m256i loadWeights4(const unsigned long* weights){
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights));
+    }
+
+    __attribute__((target("avx2")))
+    __m256i loadWeights4(const unsigned int* weights){
+        return _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(weights)));
+    }
+
+    /* Four lanes per step. Each slot is two 8-byte words, distance then (parent, generation), so slot k is gathered at
+       word 2k and word 2k + 1. A slot whose generation is stale reads as ULONG_MAX, as in SearchLabels::distance(). */
+    template<typename Weight>
+    __attribute__((target("avx2")))
+    std::size_t relaxAvx2(unsigned long distance, const unsigned int* targets, const Weight* weights, std::size_t count, const SearchLabels& labels, SlotView slots, unsigned int* improvedIds, unsigned long* improvedDistances){
+        const __m256i sign = _mm256_set1_epi64x(LLONG_MIN);
+        const __m256i base = _mm256_set1_epi64x(distance);
+        const __m256i flippedBase = _mm256_xor_si256(base, sign);
+        const __m256i generation = _mm256_set1_epi64x(slots.generation);
+        const __m256i unreached = _mm256_set1_epi64x(-1);
+        const long long* distanceWords = reinterpret_cast<const long long*>(slots.base);
+        const long long* tagWords = distanceWords + 1;
+        std::size_t improved = 0;
+        std::size_t i = 0;
+        for(; i + 4 <= count; i += 4){
+            const __m256i words = _mm256_slli_epi64(_mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(targets + i))), 1);
+            const __m256i stored = _mm256_i64gather_epi64(distanceWords, words, 8);
+            const __m256i live = _mm256_cmpeq_epi64(_mm256_srli_epi64(_mm256_i64gather_epi64(tagWords, words, 8), 32), generation);
+            const __m256i known = _mm256_blendv_epi8(unreached, stored, live);
+            __m256i sum = _mm256_add_epi64(base, loadWeights4(weights + i));
+            sum = _mm256_or_si256(sum, _mm256_cmpgt_epi64(flippedBase, _mm256_xor_si256(sum, sign)));  // Wrapped past ULONG_MAX, saturate
+            int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_xor_si256(known, sign), _mm256_xor_si256(sum, sign))));
+            if(mask != 0){
+                alignas(32) unsigned long lanes[4];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+                for(; mask != 0; mask &= mask - 1){
+                    const int lane = __builtin_ctz(mask);
+                    improvedIds[improved] = targets[i + lane];
+                    improvedDistances[improved] = lanes[lane];
+                    ++improved;
+                }
+            }
+        }
+
+        return improved + relaxScalar(distance, targets + i, weights + i, count - i, labels, improvedIds + improved, improvedDistances + improved);
+    }
+#endif
+
+    /* Variant Automatic stands for. Sse42 is left out, as it measures no faster than Scalar. */
+    RelaxKernel::Isa fastest(){
+        if(RelaxKernel::supported(RelaxKernel::Isa::Avx2)){
+            return RelaxKernel::Isa::Avx2;
+        }
+
+        return RelaxKernel::Isa::Scalar;
+    }
+}
+
+/* Dispatches to the selected variant. The layout checks guard the gathers of relaxAvx2(). */
+std::size_t RelaxKernel::relax(unsigned long distance, const unsigned int* targets, const unsigned long* weights, std::size_t count, const SearchLabels& labels, unsigned int* improvedIds, unsigned long* improvedDistances){
+#ifdef RELAX_KERNEL_X86
+    static_assert(sizeof(SearchLabels::Slot) == 16 && offsetof(SearchLabels::Slot, distance) == 0 && offsetof(SearchLabels::Slot, generation) == 12, "relaxAvx2() assumes this slot layout");
+    switch(count < VECTOR_MIN ? Isa::Scalar : selected()){
+    case Isa::Avx2:
+        return relaxAvx2(distance, targets, weights, count, labels, {reinterpret_cast<const unsigned char*>(labels.slots.data()), labels.generation}, improvedIds, improvedDistances);
+    case Isa::Sse42:
+        return relaxSse42(distance, targets, weights, count, labels, improvedIds, improvedDistances);
+    default:
+        break;
+    }
+#endif
+
+    return relaxScalar(distance, targets, weights, count, labels, improvedIds, improvedDistances);
+}
+
+/* Same as above, with each weight widened to 64 bits as it is loaded. */
+std::size_t RelaxKernel::relax(unsigned long distance, const unsigned int* targets, const unsigned int* weights, std::size_t count, const SearchLabels& labels, unsigned int* improvedIds, unsigned long* improvedDistances){
+#ifdef RELAX_KERNEL_X86
+    switch(count < VECTOR_MIN ? Isa::Scalar : selected()){
+    case Isa::Avx2:
+        return relaxAvx2(distance, targets, weights, count, labels, {reinterpret_cast<const unsigned char*>(labels.slots.data()), labels.generation}, improvedIds, improvedDistances);
+    case Isa::Sse42:
+        return relaxSse42(distance, targets, weights, count, labels, improvedIds, improvedDistances);
+    default:
+        break;
+    }
+#endif
+
+    return relaxScalar(distance, targets, weights, count, labels, improvedIds, improvedDistances);
+}
+
+/* Automatic resolves now, so selected() never has to check the CPU again. */
+void RelaxKernel::select(Isa isa){
+    if(isa == Isa::Automatic){
+        isa = fastest();
+    }
+    if(!supported(isa)){
+        throw std::invalid_argument(std::string("[ERROR] This CPU cannot run the ") + name(isa) + " relaxation kernel. Unable to complete request.");
+    }
+    current.store(isa, std::memory_order_relaxed);
+
+    return;
+}
+
+/* The first call on any thread resolves Automatic. Racing first calls all store the same value. */
+RelaxKernel::Isa RelaxKernel::selected(){
+    Isa isa = current.load(std::memory_order_relaxed);
+    if(isa == Isa::Automatic){
+        isa = fastest();
+        current.store(isa, std::memory_order_relaxed);
+    }
+
+    return isa;
+}
+
+/* Asks the CPU, through the compiler's cpuid wrapper. */
+bool RelaxKernel::supported(Isa isa){
+    switch(isa){
+    case Isa::Automatic:
+    case Isa::Scalar:
+        return true;
+#ifdef RELAX_KERNEL_X86
+    case Isa::Sse42:
+        return __builtin_cpu_supports("sse4.2");
+    case Isa::Avx2:
+        return __builtin_cpu_supports("avx2");
+#endif
+    default:
+        return false;
+    }
+}
+
+/* Names as accepted by the benchmark's --kernel option. */
+const char* RelaxKernel::name(Isa isa){
+    switch(isa){
+    case Isa::Scalar:
+        return "scalar";
+    case Isa::Sse42:
+        return "sse42";
+    case Isa::Avx2:
+        return "avx2";
+    default:
+        return "auto";
+    }
+}
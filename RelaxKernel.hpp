@@ -0,0 +1,59 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares the edge relaxation kernel used
+   by the templates of Dijkstra.hpp on graphs whose
+   neighbors sit in contiguous arrays (BasicFrozenGraph).
+   Given the settled distance of a vertex and a block of its
+   neighbors, relax() adds each edge weight to the distance,
+   saturating at ULONG_MAX, compares every sum with the
+   neighbor's tentative distance in SearchLabels, and writes
+   out only the neighbors whose distance improves. The
+   caller then updates the labels and the queue for those.
+
+   The kernel is compiled three times:
+       Scalar  one neighbor at a time, runs anywhere
+       Sse42   two neighbors per step; the sums and
+               comparisons run in 128-bit registers
+       Avx2    four neighbors per step; the tentative
+               distances are also fetched with gathers
+   and one is picked at run time, on first use: Avx2 if the
+   CPU supports it, Scalar otherwise. Reading the tentative
+   distances dominates, so without gathers Sse42 is no
+   faster than Scalar and is only run when select() asks
+   for it, which is how the benchmark compares them. Blocks
+   shorter than VECTOR_MIN always run Scalar. On compilers
+   or CPUs without x86 vector extensions only Scalar exists.
+   All three give the same results.                          */
+
+#ifndef RELAXKERNEL_HPP
+#define RELAXKERNEL_HPP
+
+#include "SearchLabels.hpp"
+
+#include <cstddef>
+
+class RelaxKernel{
+public:
+    enum class Isa{
+        Automatic,  // Avx2 if the CPU supports it, Scalar otherwise. Only valid as an argument of select()
+        Scalar,
+        Sse42,
+        Avx2
+    };
+
+    static constexpr std::size_t CHUNK = 64;    // Largest count per relax() call, so the caller's buffers fit on the stack
+    static constexpr std::size_t VECTOR_MIN = 4;    // Shorter blocks fill no vector step, so they always run Scalar
+
+    RelaxKernel() = delete; // Only static members
+
+    static std::size_t relax(unsigned long distance, const unsigned int* targets, const unsigned long* weights, std::size_t count, const SearchLabels& labels, unsigned int* improvedIds, unsigned long* improvedDistances); // Relaxes count edges out of a vertex settled at distance. Returns how many improved neighbors were written, in input order
+    static std::size_t relax(unsigned long distance, const unsigned int* targets, const unsigned int* weights, std::size_t count, const SearchLabels& labels, unsigned int* improvedIds, unsigned long* improvedDistances);  // Same, for 32-bit weights
+    static void select(Isa isa);        // Applies to every thread from the next relax() on. Throws if the CPU lacks isa
+    static Isa selected();              // Variant relax() runs, never Automatic
+    static bool supported(Isa isa);     // True if this build and CPU can run isa
+    static const char* name(Isa isa);   // "auto", "scalar", "sse42" or "avx2"
+};
+
+#endif
@@ -0,0 +1,188 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a bounded least-recently-used
+   (LRU) cache of shortest path results, keyed by the
+   (start, end) vertex IDs of a query. Each entry also
+   records the graph version it was computed for. The owner
+   bumps its version on every mutation, and an entry from
+   an older version is treated as a miss and dropped when it
+   is next looked up, so a mutation costs O(1) no matter
+   how many entries the cache holds.
+
+   Entries live in a list ordered from most to least
+   recently used, with a hash index from key to list node.
+   A hit moves its node to the front; storing into a full
+   cache evicts the node at the back. Results of queries
+   without a path are cached too, with distance ULONG_MAX.
+
+   hits(), misses() and evictions() count lookups served,
+   lookups that fell through to a search, and entries
+   pushed out by capacity, so the cache can be sized from
+   real traffic.                                             */
+
+#include "ResultCache.hpp"
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace{
+    /* Both 32-bit IDs in one 64-bit key. */
+    unsigned long long packKey(unsigned int start, unsigned int end){
+        return (static_cast<unsigned long long>(start) << 32) | end;
+    }
+}
+
+/* No entries are allocated until the first store(). */
+ResultCache::ResultCache(std::size_t capacity) : capacity(capacity){
+    // No logical implementation required
+}
+
+/* The index holds iterators into entries, so it cannot be copied as is. It is rebuilt to point into the new list. */
+ResultCache::ResultCache(const ResultCache& other) : capacity(other.capacity), entries(other.entries),
+    hitCount(other.hitCount), missCount(other.missCount), evictionCount(other.evictionCount){
+    for(auto it = entries.begin(); it != entries.end(); ++it){
+        index[it->key] = it;
+    }
+}
+
+/* Same as above. Self-assignment leaves the cache untouched. */
+ResultCache& ResultCache::operator=(const ResultCache& other){
+    if(this != &other){
+        capacity = other.capacity;
+        entries = other.entries;
+        index.clear();
+        for(auto it = entries.begin(); it != entries.end(); ++it){
+            index[it->key] = it;
+        }
+        hitCount = other.hitCount;
+        missCount = other.missCount;
+        evictionCount = other.evictionCount;
+    }
+
+    return *this;
+}
+
+/* Redundant, but satisfies course requirement. */
+ResultCache::~ResultCache(){
+    clear();
+}
+
+/* splice() moves a hit to the front without copying its path. A stale entry is erased on the spot, since no later
+   lookup could use it either.                                                                                      */
+bool ResultCache::lookup(unsigned int start, unsigned int end, unsigned long version, unsigned long& distance, std::vector<std::string>& path){
+    if(!enabled()){
+        return false;
+    }
+    auto found = index.find(packKey(start, end));
+    if(found == index.end()){
+        ++missCount;
+        return false;
+    }
+    if(found->second->version != version){
+        entries.erase(found->second);
+        index.erase(found);
+        ++missCount;
+        return false;
+    }
+
+    entries.splice(entries.begin(), entries, found->second);
+    distance = found->second->distance;
+    path.insert(path.end(), found->second->path.begin(), found->second->path.end());
+    ++hitCount;
+
+    return true;
+}
+
+/* path is taken by value so callers may move a finished path in. An existing entry for the same key is overwritten,
+   whatever its version.                                                                                            */
+void ResultCache::store(unsigned int start, unsigned int end, unsigned long version, unsigned long distance, std::vector<std::string> path){
+    if(!enabled()){
+        return;
+    }
+    const unsigned long long key = packKey(start, end);
+    auto found = index.find(key);
+    if(found != index.end()){
+        found->second->version = version;
+        found->second->distance = distance;
+        found->second->path = std::move(path);
+        entries.splice(entries.begin(), entries, found->second);
+        return;
+    }
+
+    entries.push_front(Entry{key, version, distance, std::move(path)});
+    index[key] = entries.begin();
+    evictOverflow();
+
+    return;
+}
+
+/* Shrinking evicts at once. Setting 0 disables the cache and frees every entry. */
+void ResultCache::setCapacity(std::size_t newCapacity){
+    capacity = newCapacity;
+    evictOverflow();
+
+    return;
+}
+
+/* Read-only, so constant. */
+std::size_t ResultCache::getCapacity() const{
+    return capacity;
+}
+
+/* Read-only, so constant. */
+bool ResultCache::enabled() const{
+    return capacity > 0;
+}
+
+/* Read-only, so constant. */
+std::size_t ResultCache::size() const{
+    return entries.size();
+}
+
+/* Read-only, so constant. */
+unsigned long ResultCache::hits() const{
+    return hitCount;
+}
+
+/* Read-only, so constant. */
+unsigned long ResultCache::misses() const{
+    return missCount;
+}
+
+/* Read-only, so constant. */
+unsigned long ResultCache::evictions() const{
+    return evictionCount;
+}
+
+/* Counters only. Entries are kept. */
+void ResultCache::resetStats(){
+    hitCount = 0;
+    missCount = 0;
+    evictionCount = 0;
+
+    return;
+}
+
+/* Abstracts the STL container clear() functions. */
+void ResultCache::clear(){
+    entries.clear();
+    index.clear();
+
+    return;
+}
+
+/* The back of the list is the least recently used entry. */
+void ResultCache::evictOverflow(){
+    while(entries.size() > capacity){
+        index.erase(entries.back().key);
+        entries.pop_back();
+        ++evictionCount;
+    }
+
+    return;
+}
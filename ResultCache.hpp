@@ -0,0 +1,70 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a bounded least-recently-used
+   (LRU) cache of shortest path results, keyed by the
+   (start, end) vertex IDs of a query. Each entry also
+   records the graph version it was computed for. The owner
+   bumps its version on every mutation, and an entry from
+   an older version is treated as a miss and dropped when it
+   is next looked up, so a mutation costs O(1) no matter
+   how many entries the cache holds.
+
+   Entries live in a list ordered from most to least
+   recently used, with a hash index from key to list node.
+   A hit moves its node to the front; storing into a full
+   cache evicts the node at the back. Results of queries
+   without a path are cached too, with distance ULONG_MAX.
+
+   hits(), misses() and evictions() count lookups served,
+   lookups that fell through to a search, and entries
+   pushed out by capacity, so the cache can be sized from
+   real traffic.                                             */
+
+#ifndef RESULTCACHE_HPP
+#define RESULTCACHE_HPP
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <cstddef>
+
+class ResultCache{
+public:
+    ResultCache(std::size_t capacity = 0);  // A capacity of 0 disables the cache
+    ResultCache(const ResultCache& other);  // Copies entries and counters, then rebuilds the index for the new list
+    ResultCache& operator=(const ResultCache& other);   // Same as above
+    ~ResultCache(); // Default destructor included to fulfill course requirements. Calls clear()
+    bool lookup(unsigned int start, unsigned int end, unsigned long version, unsigned long& distance, std::vector<std::string>& path); // On a hit, sets distance and appends the path
+    void store(unsigned int start, unsigned int end, unsigned long version, unsigned long distance, std::vector<std::string> path); // Inserts or refreshes one result
+    void setCapacity(std::size_t capacity); // Evicts least recently used entries if the cache shrinks
+    std::size_t getCapacity() const;
+    bool enabled() const;       // True if the capacity is above 0
+    std::size_t size() const;   // Entries currently held, stale ones included
+    unsigned long hits() const;
+    unsigned long misses() const;
+    unsigned long evictions() const;
+    void resetStats();  // Zeroes the three counters above
+    void clear();       // Drops every entry. Counters are kept
+
+private:
+    struct Entry{
+        unsigned long long key;     // start in the high half, end in the low half
+        unsigned long version;      // Graph version the result was computed for
+        unsigned long distance;     // ULONG_MAX if no path exists
+        std::vector<std::string> path;
+    };
+
+    void evictOverflow();   // Drops entries from the back until size() <= capacity
+
+    std::size_t capacity;
+    std::list<Entry> entries;   // Most recently used first
+    std::unordered_map<unsigned long long, std::list<Entry>::iterator> index;  // (key/value) = (packed IDs/node in entries)
+    unsigned long hitCount = 0;
+    unsigned long missCount = 0;
+    unsigned long evictionCount = 0;
+};
+
+#endif
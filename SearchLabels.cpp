@@ -0,0 +1,70 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines the per-vertex state of one
+   side of a shortest path search: the tentative distance
+   from the search's origin, and the parent (previous
+   vertex) through which that distance was reached. Both are
+   indexed by vertex ID. Unreached vertices report a
+   distance of ULONG_MAX and a parent of LabelTable::NO_ID.
+
+   Each slot also carries the generation in which it was
+   last written, and a slot from an older generation reads
+   as unreached. reset() therefore only increments the
+   current generation instead of rewriting every slot, so a
+   short query on a large graph pays only for the vertices
+   it actually touches. For example: a search at generation
+   7 writes slot 3, reset() moves to generation 8, and slot
+   3 reads as unreached again without having been visited.
+   Distance, parent and generation share one 16-byte slot,
+   so a relaxation touches one cache line per vertex.
+
+   The accessors are defined in the header because they sit
+   in the innermost loop of every search.                    */
+
+#include "SearchLabels.hpp"
+
+#include <vector>
+
+/* Defined solely for course requirement. */
+SearchLabels::SearchLabels(){
+    // No logical implementation required
+}
+
+/* Redundant, but satisfies course requirement. */
+SearchLabels::~SearchLabels(){
+    clear();
+}
+
+/* New slots start at generation 0, which is never current. When the counter wraps around, every slot is rewritten
+   once so that no slot from 2^32 resets ago can be mistaken for a current one.                                    */
+void SearchLabels::reset(unsigned int vertexCount){
+    if(vertexCount > slots.size()){
+        slots.resize(vertexCount, Slot{ULONG_MAX, LabelTable::NO_ID, 0});
+    }
+    count = vertexCount;
+    ++generation;
+    if(generation == 0){
+        for(auto it = slots.begin(); it != slots.end(); ++it){
+            it->generation = 0;
+        }
+        generation = 1;
+    }
+
+    return;
+}
+
+/* Read-only, so constant. */
+unsigned int SearchLabels::size() const{
+    return count;
+}
+
+/* Abstracts the STL vector clear() function. */
+void SearchLabels::clear(){
+    slots.clear();
+    count = 0;
+    generation = 0;
+
+    return;
+}
@@ -0,0 +1,68 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares the per-vertex state of one
+   side of a shortest path search: the tentative distance
+   from the search's origin, and the parent (previous
+   vertex) through which that distance was reached. Both are
+   indexed by vertex ID. Unreached vertices report a
+   distance of ULONG_MAX and a parent of LabelTable::NO_ID.
+
+   Each slot also carries the generation in which it was
+   last written, and a slot from an older generation reads
+   as unreached. reset() therefore only increments the
+   current generation instead of rewriting every slot, so a
+   short query on a large graph pays only for the vertices
+   it actually touches. For example: a search at generation
+   7 writes slot 3, reset() moves to generation 8, and slot
+   3 reads as unreached again without having been visited.
+   Distance, parent and generation share one 16-byte slot,
+   so a relaxation touches one cache line per vertex.
+
+   The accessors are defined in the header because they sit
+   in the innermost loop of every search.                    */
+
+#ifndef SEARCHLABELS_HPP
+#define SEARCHLABELS_HPP
+
+#include "LabelTable.hpp"
+
+#include <vector>
+#include <climits>
+
+class SearchLabels{
+public:
+    SearchLabels(); // Default constructor included to fulfill course requirements
+    ~SearchLabels(); // Default destructor included to fulfill course requirements. Calls clear()
+    void reset(unsigned int vertexCount);   // Marks IDs 0 to vertexCount - 1 as unreached. O(1) unless the slots must grow
+    unsigned int size() const;  // Number of IDs covered by the last reset()
+    void clear();   // Releases the slots
+
+    unsigned long distance(unsigned int id) const{  // Tentative distance of id, ULONG_MAX if unreached
+        const Slot& slot = slots[id];
+        return slot.generation == generation ? slot.distance : ULONG_MAX;
+    }
+    unsigned int parent(unsigned int id) const{     // Previous vertex on the path to id, NO_ID if unreached or the origin
+        const Slot& slot = slots[id];
+        return slot.generation == generation ? slot.parent : LabelTable::NO_ID;
+    }
+    void set(unsigned int id, unsigned long distance, unsigned int parent){ // Records a shorter distance to id
+        slots[id] = {distance, parent, generation};
+    }
+
+private:
+    friend class RelaxKernel;   // Reads distances straight from the slots, several at a time
+
+    struct Slot{
+        unsigned long distance;
+        unsigned int parent;
+        unsigned int generation;    // Slot is only valid while this equals SearchLabels::generation
+    };
+
+    std::vector<Slot> slots;        // (index/value) = (vertex ID/label)
+    unsigned int count = 0;         // IDs covered by the last reset()
+    unsigned int generation = 0;    // Incremented by reset(). Slots start at 0, which is never current after a reset()
+};
+
+#endif
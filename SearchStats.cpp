@@ -0,0 +1,94 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines the statistics recorded for one
+   shortest path query: vertices settled, edges relaxed,
+   queue pushes and pops, stale queue entries skipped, the
+   largest queue size reached, and the wall time of each
+   phase (init, search, reconstruct). The numbers explain a
+   slow query after the fact: a large settled count points
+   at the search space, many stale entries at a queue
+   without decrease-key, a long init at label resets.
+
+   Recording is compiled in only when SHORTESTPATH_STATS is
+   defined (CMake option of the same name). Every hook in
+   the search code is wrapped in SEARCH_STATS(...), which
+   expands to nothing otherwise, so a normal build carries
+   no trace of it, not even a branch.
+
+   Each thread fills its own SearchStats, from local(). A
+   QueryScope placed at the top of a shortestPath() starts
+   a fresh record, and when the query ends, by return or by
+   throw, hands it to the StatsSink installed at that time.
+   Searches run outside any QueryScope, such as those made
+   while building landmarks, are counted but never sent.     */
+
+#include "SearchStats.hpp"
+#include "StatsSink.hpp"
+
+#include <chrono>
+
+/* Constant definition, needed by code which takes the array's address. */
+constexpr const char* SearchStats::PHASE_NAMES[SearchStats::PHASE_COUNT];
+
+/* thread_local, so that concurrent queries never share counters. */
+SearchStats& SearchStats::local(){
+    static thread_local SearchStats stats;
+    return stats;
+}
+
+/* Nanoseconds since an arbitrary but fixed point. */
+long long SearchStats::now(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* engineName must outlive every sink that keeps the record, so callers pass string literals. */
+void SearchStats::reset(const char* engineName){
+    *this = SearchStats();
+    engine = engineName;
+    startNs = now();
+
+    return;
+}
+
+/* Starts a fresh record for the calling thread. */
+SearchStats::QueryScope::QueryScope(const char* engine){
+    local().reset(engine);
+}
+
+/* Runs while unwinding too, so a query that throws is recorded like any other. A sink which throws loses the record
+   rather than the query's own result or exception.                                                                 */
+SearchStats::QueryScope::~QueryScope(){
+    SearchStats& stats = local();
+    stats.totalNs = now() - stats.startNs;
+    StatsSink* sink = StatsSink::installed();
+    if(sink != nullptr){
+        try{
+            sink->record(stats);
+        }
+        catch(...){
+            // Statistics must never change the outcome of a query
+        }
+    }
+}
+
+/* Marks the start of a stretch of phase. */
+SearchStats::PhaseTimer::PhaseTimer(Phase phase) : phase(phase), begin(now()){
+    local().phaseStartNs[phase] = begin;
+}
+
+/* Covers early returns and exceptions. */
+SearchStats::PhaseTimer::~PhaseTimer(){
+    stop();
+}
+
+/* Adds the stretch to the phase total. */
+void SearchStats::PhaseTimer::stop(){
+    if(begin >= 0){
+        local().phaseNs[phase] += now() - begin;
+        begin = -1;
+    }
+
+    return;
+}
@@ -0,0 +1,94 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares the statistics recorded for one
+   shortest path query: vertices settled, edges relaxed,
+   queue pushes and pops, stale queue entries skipped, the
+   largest queue size reached, and the wall time of each
+   phase (init, search, reconstruct). The numbers explain a
+   slow query after the fact: a large settled count points
+   at the search space, many stale entries at a queue
+   without decrease-key, a long init at label resets.
+
+   Recording is compiled in only when SHORTESTPATH_STATS is
+   defined (CMake option of the same name). Every hook in
+   the search code is wrapped in SEARCH_STATS(...), which
+   expands to nothing otherwise, so a normal build carries
+   no trace of it, not even a branch.
+
+   Each thread fills its own SearchStats, from local(). A
+   QueryScope placed at the top of a shortestPath() starts
+   a fresh record, and when the query ends, by return or by
+   throw, hands it to the StatsSink installed at that time.
+   Searches run outside any QueryScope, such as those made
+   while building landmarks, are counted but never sent.     */
+
+#ifndef SEARCHSTATS_HPP
+#define SEARCHSTATS_HPP
+
+#ifdef SHORTESTPATH_STATS
+#define SEARCH_STATS(statement) statement
+#else
+#define SEARCH_STATS(statement)
+#endif
+
+#include <cstddef>
+
+struct SearchStats{
+    enum Phase{
+        Init,           // Resetting labels for the query
+        Search,         // Acquiring a queue and running the search loop
+        Reconstruct,    // Walking parents back into a path of labels
+        PHASE_COUNT
+    };
+
+    class QueryScope{   // Starts a record on construction, sends it to the installed StatsSink on destruction
+    public:
+        QueryScope(const char* engine);
+        QueryScope(const QueryScope&) = delete;
+        QueryScope& operator=(const QueryScope&) = delete;
+        ~QueryScope();
+    };
+
+    class PhaseTimer{   // Adds the time until stop() or destruction to one phase of local()
+    public:
+        PhaseTimer(Phase phase);
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+        ~PhaseTimer();  // Calls stop()
+        void stop();    // Only the first call counts
+
+    private:
+        Phase phase;
+        long long begin;    // -1 once stopped
+    };
+
+    static constexpr const char* PHASE_NAMES[PHASE_COUNT] = {"init", "search", "reconstruct"};
+
+    static SearchStats& local();    // The calling thread's record
+    static long long now();         // Steady clock, in nanoseconds
+    void reset(const char* engineName); // Zeroes every counter and starts the clock
+
+    template<typename Queue>
+    void notePush(const Queue& queue){  // Counts a push, decrease-keys included, and tracks the largest queue size
+        ++pushes;
+        if(static_cast<unsigned long>(queue.get_size()) > peakQueue){
+            peakQueue = queue.get_size();
+        }
+    }
+
+    const char* engine = "";        // Static string naming the engine which ran the query
+    unsigned long settled = 0;      // Vertices popped with a current key
+    unsigned long relaxations = 0;  // Edges scanned out of settled vertices
+    unsigned long pushes = 0;       // Queue pushes, decrease-keys included
+    unsigned long pops = 0;         // Queue pops, stale ones included
+    unsigned long stale = 0;        // Pops discarded because a shorter distance was found after the push
+    unsigned long peakQueue = 0;    // Largest queue size seen right after a push
+    long long startNs = 0;          // When the query began, on the now() clock
+    long long totalNs = 0;          // Wall time of the whole query, set when its QueryScope ends
+    long long phaseStartNs[PHASE_COUNT] = {};   // Start of the last timed stretch of each phase, 0 if never timed
+    long long phaseNs[PHASE_COUNT] = {};        // Wall time spent in each phase
+};
+
+#endif
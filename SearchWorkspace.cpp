@@ -0,0 +1,89 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a reusable bundle of search
+   state: labels for a forward and a backward search, plus
+   one priority queue of every kind for each side. A search
+   which borrows a workspace allocates nothing once the
+   workspace has grown to the size of the graph, so running
+   many queries through one workspace removes the per-query
+   allocations of shortestPath().
+
+   A workspace must only be used by one search at a time.
+   local() hands every thread its own workspace, which is
+   how shortestPath() and the batch API share them safely.
+
+   scratch() is a per-thread bump arena for the short-lived
+   containers of one query, such as the hop lists of a
+   contraction hierarchy path. Each call rewinds it to its
+   fixed initial buffer, so a query that fits in the buffer
+   allocates nothing, and one that does not only borrows
+   extra blocks from the default resource until the next
+   call.                                                     */
+
+#include "SearchWorkspace.hpp"
+
+#include <memory>
+#include <memory_resource>
+#include <cstddef>
+
+/* The scratch arena starts on its own buffer, which release() always returns to. */
+SearchWorkspace::SearchWorkspace() : scratchBuffer(new std::byte[SCRATCH_BYTES]), scratchArena(scratchBuffer.get(), SCRATCH_BYTES){
+    // No logical implementation required
+}
+
+/* Defined solely for course requirement. */
+SearchWorkspace::~SearchWorkspace(){
+    // No logical implementation required
+}
+
+/* Read-write access, the caller resets the labels. */
+SearchLabels& SearchWorkspace::forward(){
+    return labels[0];
+}
+
+/* Read-write access, the caller resets the labels. */
+SearchLabels& SearchWorkspace::backward(){
+    return labels[1];
+}
+
+/* A previous search may have stopped early and left entries behind. */
+PQueue& SearchWorkspace::heap(bool backwardSide){
+    heaps[backwardSide].clear();
+
+    return heaps[backwardSide];
+}
+
+/* A previous search may have stopped early and left entries behind. */
+RadixHeap& SearchWorkspace::radix(bool backwardSide){
+    radixHeaps[backwardSide].clear();
+
+    return radixHeaps[backwardSide];
+}
+
+/* The bucket array depends on maxWeight, so it is only rebuilt when that changes. */
+BucketQueue& SearchWorkspace::buckets(unsigned long maxWeight, bool backwardSide){
+    if(!bucketQueues[backwardSide] || bucketWeights[backwardSide] != maxWeight){
+        bucketQueues[backwardSide].reset(new BucketQueue(maxWeight));
+        bucketWeights[backwardSide] = maxWeight;
+    }
+    bucketQueues[backwardSide]->clear();
+
+    return *bucketQueues[backwardSide];
+}
+
+/* release() frees the upstream blocks taken by the previous query and rewinds to the initial buffer. */
+std::pmr::memory_resource& SearchWorkspace::scratch(){
+    scratchArena.release();
+
+    return scratchArena;
+}
+
+/* thread_local gives each thread, including each ThreadPool worker, one
+   workspace for its whole lifetime. It is destroyed when the thread exits. */
+SearchWorkspace& SearchWorkspace::local(){
+    static thread_local SearchWorkspace workspace;
+
+    return workspace;
+}
@@ -0,0 +1,62 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a reusable bundle of search
+   state: labels for a forward and a backward search, plus
+   one priority queue of every kind for each side. A search
+   which borrows a workspace allocates nothing once the
+   workspace has grown to the size of the graph, so running
+   many queries through one workspace removes the per-query
+   allocations of shortestPath().
+
+   A workspace must only be used by one search at a time.
+   local() hands every thread its own workspace, which is
+   how shortestPath() and the batch API share them safely.
+
+   scratch() is a per-thread bump arena for the short-lived
+   containers of one query, such as the hop lists of a
+   contraction hierarchy path. Each call rewinds it to its
+   fixed initial buffer, so a query that fits in the buffer
+   allocates nothing, and one that does not only borrows
+   extra blocks from the default resource until the next
+   call.                                                     */
+
+#ifndef SEARCHWORKSPACE_HPP
+#define SEARCHWORKSPACE_HPP
+
+#include "SearchLabels.hpp"
+#include "PQueue.hpp"
+#include "RadixHeap.hpp"
+#include "BucketQueue.hpp"
+
+#include <memory>
+#include <memory_resource>
+#include <cstddef>
+
+class SearchWorkspace{
+public:
+    static constexpr std::size_t SCRATCH_BYTES = 64 * 1024; // Initial buffer of scratch(), reused by every query
+
+    SearchWorkspace();  // Default constructor included to fulfill course requirements
+    ~SearchWorkspace(); // Default destructor included to fulfill course requirements
+    SearchLabels& forward();    // Labels of the forward (or only) search
+    SearchLabels& backward();   // Labels of the backward search
+    PQueue& heap(bool backwardSide = false);     // Empty indexed heap for one side
+    RadixHeap& radix(bool backwardSide = false); // Empty radix heap for one side
+    BucketQueue& buckets(unsigned long maxWeight, bool backwardSide = false); // Empty bucket queue sized for maxWeight
+    std::pmr::memory_resource& scratch();   // Rewound bump arena. Invalidates everything allocated from the previous call
+
+    static SearchWorkspace& local();    // The calling thread's own workspace, created on first use
+
+private:
+    SearchLabels labels[2];     // [0] forward, [1] backward
+    PQueue heaps[2];
+    RadixHeap radixHeaps[2];
+    std::unique_ptr<BucketQueue> bucketQueues[2];   // Rebuilt only when maxWeight changes
+    unsigned long bucketWeights[2] = {0, 0};        // maxWeight each bucket queue was built for
+    std::unique_ptr<std::byte[]> scratchBuffer;     // SCRATCH_BYTES, on the heap to keep thread_local storage small
+    std::pmr::monotonic_buffer_resource scratchArena;   // Bumps through scratchBuffer, then through upstream blocks
+};
+
+#endif
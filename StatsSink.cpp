@@ -0,0 +1,37 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines the interface of a destination
+   for per-query SearchStats. At most one sink is installed
+   at a time, process-wide. When a query ends, the thread
+   that ran it passes its record to record() of whichever
+   sink is installed, so a sink must accept calls from many
+   threads at once. Two sinks are provided: HistogramSink
+   aggregates distributions per engine, and TraceSink keeps
+   every query for export as Chrome trace-event JSON.
+
+   A sink must stay alive until it has been uninstalled and
+   every query that may have picked it up has finished.
+   Nothing is recorded unless the library was built with
+   SHORTESTPATH_STATS, see SearchStats.hpp.                  */
+
+#include "StatsSink.hpp"
+
+#include <atomic>
+
+namespace{
+    std::atomic<StatsSink*> current{nullptr};   // Read once per query, so a plain atomic pointer is enough
+}
+
+/* Queries already running may still deliver to the previous sink. */
+void StatsSink::install(StatsSink* sink){
+    current.store(sink, std::memory_order_release);
+
+    return;
+}
+
+/* Acquire pairs with install(), so a sink built before install() is seen fully constructed. */
+StatsSink* StatsSink::installed(){
+    return current.load(std::memory_order_acquire);
+}
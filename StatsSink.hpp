@@ -0,0 +1,34 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares the interface of a destination
+   for per-query SearchStats. At most one sink is installed
+   at a time, process-wide. When a query ends, the thread
+   that ran it passes its record to record() of whichever
+   sink is installed, so a sink must accept calls from many
+   threads at once. Two sinks are provided: HistogramSink
+   aggregates distributions per engine, and TraceSink keeps
+   every query for export as Chrome trace-event JSON.
+
+   A sink must stay alive until it has been uninstalled and
+   every query that may have picked it up has finished.
+   Nothing is recorded unless the library was built with
+   SHORTESTPATH_STATS, see SearchStats.hpp.                  */
+
+#ifndef STATSSINK_HPP
+#define STATSSINK_HPP
+
+#include "SearchStats.hpp"
+
+class StatsSink{
+public:
+    StatsSink() = default;  // Not necessary, but fulfills course requirements
+    virtual ~StatsSink() = default; // Prevents call to incorrect destructor from derived class objects
+    virtual void record(const SearchStats& stats) = 0; // Called once per finished query, from the thread that ran it
+
+    static void install(StatsSink* sink);   // Replaces the installed sink. nullptr uninstalls
+    static StatsSink* installed();          // nullptr if none
+};
+
+#endif
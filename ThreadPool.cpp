@@ -0,0 +1,171 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a fixed-size pool of worker
+   threads used to run independent tasks in parallel, such
+   as a batch of shortest path queries.
+
+   parallelFor(count, task) cuts the index range [0, count)
+   into chunks and deals them round-robin onto one deque per
+   worker. Each worker pops chunks from the back of its own
+   deque. A worker whose deque runs dry steals a chunk from
+   the front of another worker's deque, so a worker that was
+   dealt expensive queries (long paths, large components)
+   does not hold up the whole batch while the others idle.
+   For example: 4 workers and 64 chunks start with 16
+   chunks each, but a worker which finishes early keeps
+   taking chunks from the busiest deques until none remain.
+
+   Workers are started once, by the constructor, and wait
+   for the next parallelFor() between batches. A task must
+   not call parallelFor() on the pool that runs it.          */
+
+#include "ThreadPool.hpp"
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <exception>
+#include <algorithm>
+
+/* hardware_concurrency() may report 0 when the count is unknown, so at least one worker is always started. */
+ThreadPool::ThreadPool(unsigned int threadCount){
+    if(threadCount == 0){
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for(unsigned int i = 0; i < threadCount; ++i){
+        queues.emplace_back(new WorkQueue);
+    }
+    for(unsigned int i = 0; i < threadCount; ++i){
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+/* Workers finish the chunk they are running, see stopping, and return. */
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for(auto it = threads.begin(); it != threads.end(); ++it){
+        it->join();
+    }
+}
+
+/* A grain of 0 picks roughly eight chunks per worker, which leaves enough chunks to steal without making the deques
+   busy. Every chunk is dealt before the batch is posted, so no worker can see a half-filled set of deques. The first
+   exception thrown by any task is rethrown here once the whole batch has finished. Other indices still run.         */
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t, unsigned int)>& task, std::size_t grain){
+    if(count == 0){
+        return;
+    }
+    if(grain == 0){
+        grain = std::max<std::size_t>(1, count / (8 * size()));
+    }
+
+    std::lock_guard<std::mutex> batchGuard(batchLock);
+    std::unique_lock<std::mutex> guard(stateLock);
+    this->task = &task; // Published before the first chunk, which a worker still busy with the last batch may take at once
+    remaining = count;
+    failure = nullptr;
+    unsigned int worker = 0;
+    for(std::size_t begin = 0; begin < count; begin += grain){
+        std::lock_guard<std::mutex> queueGuard(queues[worker]->lock);
+        queues[worker]->chunks.push_back({begin, std::min(count, begin + grain)});
+        worker = (worker + 1) % size();
+    }
+    ++batch;
+    wake.notify_all();
+
+    finished.wait(guard, [&]{ return remaining == 0; });
+    this->task = nullptr;
+    if(failure){
+        std::exception_ptr rethrown = failure;
+        failure = nullptr;
+        std::rethrow_exception(rethrown);
+    }
+
+    return;
+}
+
+/* Read-only, so constant. */
+unsigned int ThreadPool::size() const{
+    return threads.size();
+}
+
+/* Sleeps until a new batch is posted, then keeps taking chunks until no deque has any left. */
+void ThreadPool::workerLoop(unsigned int worker){
+    unsigned long seen = 0;
+    while(true){
+        {
+            std::unique_lock<std::mutex> guard(stateLock);
+            wake.wait(guard, [&]{ return stopping || batch != seen; });
+            if(stopping){
+                return;
+            }
+            seen = batch;
+        }
+
+        Chunk chunk;
+        while(takeChunk(worker, chunk)){
+            runChunk(worker, chunk);
+        }
+    }
+}
+
+/* The owner takes the most recently dealt chunk and thieves take the oldest, so the two ends of a deque are rarely
+   contended. Victims are tried in order starting after worker, which spreads thieves over different deques.        */
+bool ThreadPool::takeChunk(unsigned int worker, Chunk& chunk){
+    {
+        WorkQueue& own = *queues[worker];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if(!own.chunks.empty()){
+            chunk = own.chunks.back();
+            own.chunks.pop_back();
+            return true;
+        }
+    }
+    for(unsigned int i = 1; i < size(); ++i){
+        WorkQueue& victim = *queues[(worker + i) % size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if(!victim.chunks.empty()){
+            chunk = victim.chunks.front();
+            victim.chunks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* task was set before the chunk was dealt, and stays valid while any index of the batch is unfinished, so it is safe
+   to read outside of stateLock here.                                                                                 */
+void ThreadPool::runChunk(unsigned int worker, const Chunk& chunk){
+    std::exception_ptr error;
+    for(std::size_t i = chunk.begin; i < chunk.end; ++i){
+        try{
+            (*task)(i, worker);
+        }
+        catch(...){
+            if(!error){
+                error = std::current_exception();
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> guard(stateLock);
+    if(error && !failure){
+        failure = error;
+    }
+    remaining -= chunk.end - chunk.begin;
+    if(remaining == 0){
+        finished.notify_one();
+    }
+
+    return;
+}
@@ -0,0 +1,75 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a fixed-size pool of worker
+   threads used to run independent tasks in parallel, such
+   as a batch of shortest path queries.
+
+   parallelFor(count, task) cuts the index range [0, count)
+   into chunks and deals them round-robin onto one deque per
+   worker. Each worker pops chunks from the back of its own
+   deque. A worker whose deque runs dry steals a chunk from
+   the front of another worker's deque, so a worker that was
+   dealt expensive queries (long paths, large components)
+   does not hold up the whole batch while the others idle.
+   For example: 4 workers and 64 chunks start with 16
+   chunks each, but a worker which finishes early keeps
+   taking chunks from the busiest deques until none remain.
+
+   Workers are started once, by the constructor, and wait
+   for the next parallelFor() between batches. A task must
+   not call parallelFor() on the pool that runs it.          */
+
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <exception>
+#include <cstddef>
+
+class ThreadPool{
+public:
+    ThreadPool(unsigned int threadCount = 0);   // Starts threadCount workers. 0 means one per hardware thread
+    ~ThreadPool();  // Stops and joins every worker
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    void parallelFor(std::size_t count, const std::function<void(std::size_t, unsigned int)>& task, std::size_t grain = 0); // Calls task(index, worker) for every index below count, returns once all are done
+    unsigned int size() const;  // Number of workers. Worker numbers passed to tasks are 0 to size() - 1
+
+protected:
+    struct Chunk{   // Half-open index range [begin, end)
+        std::size_t begin;
+        std::size_t end;
+    };
+    struct WorkQueue{   // One per worker. The owner pops from the back, thieves take from the front
+        std::mutex lock;
+        std::deque<Chunk> chunks;
+    };
+
+    void workerLoop(unsigned int worker);   // Body of each worker thread
+    bool takeChunk(unsigned int worker, Chunk& chunk);  // Pops from the worker's own deque, or steals from another
+    void runChunk(unsigned int worker, const Chunk& chunk); // Runs the task on every index of chunk
+
+private:
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<WorkQueue>> queues; // (index/value) = (worker/its deque)
+
+    std::mutex batchLock;               // Held by parallelFor() for a whole batch, so concurrent callers take turns
+    std::mutex stateLock;               // Guards every member below
+    std::condition_variable wake;       // Signals workers that a batch was posted, or that the pool is stopping
+    std::condition_variable finished;   // Signals parallelFor() that the last index was run
+    const std::function<void(std::size_t, unsigned int)>* task = nullptr;  // Task of the current batch
+    unsigned long batch = 0;            // Incremented by every parallelFor(), so workers can tell batches apart
+    std::size_t remaining = 0;          // Indices of the current batch that have not been run yet
+    std::exception_ptr failure;         // First exception thrown by a task of the current batch
+    bool stopping = false;
+};
+
+#endif
@@ -0,0 +1,127 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a StatsSink which keeps every
+   recorded query and writes them out in the Chrome
+   trace-event format, readable by chrome://tracing and
+   Perfetto. Each query becomes one complete ("X") event on
+   the timeline of the thread that ran it, named after its
+   engine and carrying its counters as arguments. Each timed
+   phase becomes a nested event inside it, so slow queries
+   show at a glance whether init, search or reconstruct
+   took the time.
+
+   Records are copied into a vector under a mutex. Once
+   maxEvents queries are held, later ones are only counted
+   as dropped, so tracing a long run cannot exhaust memory.  */
+
+#include "TraceSink.hpp"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <ios>
+#include <ostream>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+/* Nothing is reserved up front, since most traces stay far below the limit. */
+TraceSink::TraceSink(std::size_t maxEvents) : maxEvents(maxEvents){
+    // No logical implementation required
+}
+
+/* Redundant, but satisfies course requirement. */
+TraceSink::~TraceSink(){
+    clear();
+}
+
+/* Thread IDs are opaque, so each thread is numbered on its first record. */
+void TraceSink::record(const SearchStats& stats){
+    std::lock_guard<std::mutex> guard(lock);
+    if(events.size() >= maxEvents){
+        ++droppedCount;
+        return;
+    }
+    const auto thread = threads.emplace(std::this_thread::get_id(), threads.size()).first;
+    events.push_back(Event{stats, thread->second});
+
+    return;
+}
+
+/* Read-only, so constant. */
+std::size_t TraceSink::size() const{
+    std::lock_guard<std::mutex> guard(lock);
+    return events.size();
+}
+
+/* Read-only, so constant. */
+unsigned long TraceSink::dropped() const{
+    std::lock_guard<std::mutex> guard(lock);
+    return droppedCount;
+}
+
+/* Timestamps are made relative to the earliest query, which keeps them small and the timeline starting at 0. A phase
+   timed in several stretches is drawn as one event from its last start, lasting its total time. The caller's format
+   flags and precision are restored afterwards.                                                                      */
+void TraceSink::write(std::ostream& out) const{
+    std::lock_guard<std::mutex> guard(lock);
+    long long origin = 0;
+    for(auto it = events.begin(); it != events.end(); ++it){
+        if(it == events.begin() || it->stats.startNs < origin){
+            origin = it->stats.startNs;
+        }
+    }
+    auto micros = [&](long long ns){
+        return (ns - origin) / 1000.0;
+    };
+
+    const std::ios_base::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3) << "{\"traceEvents\": [";
+    bool first = true;
+    for(auto it = events.begin(); it != events.end(); ++it){
+        const SearchStats& stats = it->stats;
+        out << (first ? "\n" : ",\n") << "  {\"name\": \"" << stats.engine << "\", \"cat\": \"query\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << it->thread
+            << ", \"ts\": " << micros(stats.startNs) << ", \"dur\": " << stats.totalNs / 1000.0
+            << ", \"args\": {\"settled\": " << stats.settled << ", \"relaxations\": " << stats.relaxations
+            << ", \"pushes\": " << stats.pushes << ", \"pops\": " << stats.pops << ", \"stale\": " << stats.stale
+            << ", \"peakQueue\": " << stats.peakQueue << "}}";
+        for(unsigned int p = 0; p < SearchStats::PHASE_COUNT; ++p){
+            if(stats.phaseStartNs[p] != 0){
+                out << ",\n  {\"name\": \"" << SearchStats::PHASE_NAMES[p] << "\", \"cat\": \"phase\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << it->thread
+                    << ", \"ts\": " << micros(stats.phaseStartNs[p]) << ", \"dur\": " << stats.phaseNs[p] / 1000.0 << "}";
+            }
+        }
+        first = false;
+    }
+    out << "\n], \"displayTimeUnit\": \"ns\", \"otherData\": {\"dropped\": " << droppedCount << "}}\n";
+    out.flags(flags);
+    out.precision(precision);
+
+    return;
+}
+
+/* Same as above, into fileName. */
+void TraceSink::write(const std::string& fileName) const{
+    std::ofstream file(fileName);
+    if(!file){
+        throw std::runtime_error("[ERROR] Unable to open " + fileName + ". Unable to complete request.");
+    }
+    write(file);
+
+    return;
+}
+
+/* Abstracts the STL container clear() functions. */
+void TraceSink::clear(){
+    std::lock_guard<std::mutex> guard(lock);
+    events.clear();
+    threads.clear();
+    droppedCount = 0;
+
+    return;
+}
@@ -0,0 +1,56 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a StatsSink which keeps every
+   recorded query and writes them out in the Chrome
+   trace-event format, readable by chrome://tracing and
+   Perfetto. Each query becomes one complete ("X") event on
+   the timeline of the thread that ran it, named after its
+   engine and carrying its counters as arguments. Each timed
+   phase becomes a nested event inside it, so slow queries
+   show at a glance whether init, search or reconstruct
+   took the time.
+
+   Records are copied into a vector under a mutex. Once
+   maxEvents queries are held, later ones are only counted
+   as dropped, so tracing a long run cannot exhaust memory.  */
+
+#ifndef TRACESINK_HPP
+#define TRACESINK_HPP
+
+#include "StatsSink.hpp"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <ostream>
+#include <cstddef>
+
+class TraceSink : public StatsSink{
+public:
+    TraceSink(std::size_t maxEvents = 1000000);   // Queries kept before the rest are dropped
+    ~TraceSink() override;  // Default destructor included to fulfill course requirements. Calls clear()
+    void record(const SearchStats& stats) override;
+    std::size_t size() const;       // Queries kept
+    unsigned long dropped() const;  // Queries seen after the limit was reached
+    void write(std::ostream& out) const;    // {"traceEvents": [...]} with timestamps in microseconds
+    void write(const std::string& fileName) const;  // Same as above, into a new file. Throws if it cannot be opened
+    void clear();   // Forgets every query, keeping the limit
+
+private:
+    struct Event{
+        SearchStats stats;
+        unsigned int thread;    // Small ID of the recording thread, in order of first appearance
+    };
+
+    std::size_t maxEvents;
+    unsigned long droppedCount = 0;
+    mutable std::mutex lock;
+    std::vector<Event> events;
+    std::map<std::thread::id, unsigned int> threads;    // (key/value) = (thread/ID written as "tid")
+};
+
+#endif
@@ -0,0 +1,148 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This source file defines a graph which can be queried
+   by many threads while another thread keeps changing it.
+   Readers never see the Graph that writers mutate. They
+   see the most recently published FrozenGraph, held by a
+   std::shared_ptr, and a snapshot they hold never changes
+   under them, however many versions are published after it.
+
+   Writers stage their mutations on a private Graph, under
+   a mutex that only writers take. publish() freezes the
+   staged graph into a new snapshot and swaps it in with
+   std::atomic_store(), so a reader sees either all of a
+   batch or none of it. update() runs a whole batch of
+   mutations and publishes once at the end, which spreads
+   the O(V + E) cost of freeze() over the entire batch.
+
+   Reclamation is left to the reference count: a snapshot is
+   freed when the last reader holding it lets go, and until
+   then readers never wait for writers or for each other.
+   The standard library may guard the pointer swap itself
+   with a short internal lock, held only for the copy of
+   the pointer, never for the duration of a query.           */
+
+#include "VersionedGraph.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <functional>
+#include <utility>
+
+/* Readers always find a snapshot, even before the first publish(). */
+VersionedGraph::VersionedGraph() : current(std::make_shared<const FrozenGraph>()), publications(1){
+    stagedVersion = staging.getVersion();
+}
+
+/* Snapshots still held by readers are freed by the last of them. */
+VersionedGraph::~VersionedGraph(){
+    // No logical implementation required
+}
+
+/* Copies the pointer, and with it a reference. The snapshot stays alive for as long as the caller holds it. */
+std::shared_ptr<const FrozenGraph> VersionedGraph::snapshot() const{
+    return std::atomic_load(&current);
+}
+
+/* The snapshot is pinned for the whole query, so a publish() in the middle of it cannot pull the graph away. */
+unsigned long VersionedGraph::shortestPath(const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path) const{
+    const std::shared_ptr<const FrozenGraph> pinned = snapshot();
+    return pinned->shortestPath(startLabel, endLabel, path);
+}
+
+/* Invisible to readers until the next publish(). */
+void VersionedGraph::addVertex(const std::string& label){
+    std::lock_guard<std::mutex> lock(writerLock);
+    staging.addVertex(label);
+
+    return;
+}
+
+/* Invisible to readers until the next publish(). */
+void VersionedGraph::removeVertex(const std::string& label){
+    std::lock_guard<std::mutex> lock(writerLock);
+    staging.removeVertex(label);
+
+    return;
+}
+
+/* Invisible to readers until the next publish(). */
+void VersionedGraph::addEdge(const std::string& label1, const std::string& label2, unsigned long weight){
+    std::lock_guard<std::mutex> lock(writerLock);
+    staging.addEdge(label1, label2, weight);
+
+    return;
+}
+
+/* Invisible to readers until the next publish(). */
+void VersionedGraph::removeEdge(const std::string& label1, const std::string& label2){
+    std::lock_guard<std::mutex> lock(writerLock);
+    staging.removeEdge(label1, label2);
+
+    return;
+}
+
+/* Invisible to readers until the next publish(). */
+void VersionedGraph::setQueueKind(QueueKind kind){
+    std::lock_guard<std::mutex> lock(writerLock);
+    staging.setQueueKind(kind);
+    settingsChanged = true;
+
+    return;
+}
+
+/* Invisible to readers until the next publish(). */
+void VersionedGraph::setSearchMode(SearchMode mode){
+    std::lock_guard<std::mutex> lock(writerLock);
+    staging.setSearchMode(mode);
+    settingsChanged = true;
+
+    return;
+}
+
+/* Other writers wait until the batch has been published, so batches never interleave. If batch throws, nothing is
+   published and the exception reaches the caller, but the mutations batch made before throwing stay staged and go
+   out with the next publish().                                                                                    */
+void VersionedGraph::update(const std::function<void(Graph&)>& batch){
+    std::lock_guard<std::mutex> lock(writerLock);
+    batch(staging);
+    publishLocked();
+
+    return;
+}
+
+/* The freeze runs under writerLock, so it sees a consistent staged graph, while readers keep querying the previous
+   snapshot. The swap itself is a single atomic store. The previous snapshot is released here, but it is only freed
+   once the last reader holding it lets go.                                                                        */
+unsigned long VersionedGraph::publish(){
+    std::lock_guard<std::mutex> lock(writerLock);
+    return publishLocked();
+}
+
+/* Nothing is frozen if neither the graph nor its settings changed since the last snapshot. */
+unsigned long VersionedGraph::publishLocked(){
+    if(staging.getVersion() == stagedVersion && !settingsChanged){
+        return publications.load();
+    }
+    std::shared_ptr<const FrozenGraph> next = std::make_shared<const FrozenGraph>(staging.freeze());
+    stagedVersion = staging.getVersion();
+    settingsChanged = false;
+    std::atomic_store(&current, std::move(next));
+
+    return ++publications;
+}
+
+/* Takes writerLock, so it waits out a publish() in progress. */
+bool VersionedGraph::pending() const{
+    std::lock_guard<std::mutex> lock(writerLock);
+    return staging.getVersion() != stagedVersion || settingsChanged;
+}
+
+/* Read-only, so constant. */
+unsigned long VersionedGraph::publishedCount() const{
+    return publications.load();
+}
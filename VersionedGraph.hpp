@@ -0,0 +1,71 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file declares a graph which can be queried
+   by many threads while another thread keeps changing it.
+   Readers never see the Graph that writers mutate. They
+   see the most recently published FrozenGraph, held by a
+   std::shared_ptr, and a snapshot they hold never changes
+   under them, however many versions are published after it.
+
+   Writers stage their mutations on a private Graph, under
+   a mutex that only writers take. publish() freezes the
+   staged graph into a new snapshot and swaps it in with
+   std::atomic_store(), so a reader sees either all of a
+   batch or none of it. update() runs a whole batch of
+   mutations and publishes once at the end, which spreads
+   the O(V + E) cost of freeze() over the entire batch.
+
+   Reclamation is left to the reference count: a snapshot is
+   freed when the last reader holding it lets go, and until
+   then readers never wait for writers or for each other.
+   The standard library may guard the pointer swap itself
+   with a short internal lock, held only for the copy of
+   the pointer, never for the duration of a query.           */
+
+#ifndef VERSIONEDGRAPH_HPP
+#define VERSIONEDGRAPH_HPP
+
+#include "Graph.hpp"
+#include "FrozenGraph.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+
+class VersionedGraph{
+public:
+    VersionedGraph();   // Publishes an empty snapshot
+    VersionedGraph(const VersionedGraph&) = delete;
+    VersionedGraph& operator=(const VersionedGraph&) = delete;
+    ~VersionedGraph();  // Readers may outlive the object, since they hold their snapshots themselves
+    std::shared_ptr<const FrozenGraph> snapshot() const;  // Latest published version. Never blocks on writers
+    unsigned long shortestPath(const std::string& startLabel, const std::string& endLabel, std::vector<std::string> &path) const; // Same contract as FrozenGraph::shortestPath(), on snapshot()
+    void addVertex(const std::string& label);   // Staged. Same contract as Graph::addVertex()
+    void removeVertex(const std::string& label);    // Staged. Same contract as Graph::removeVertex()
+    void addEdge(const std::string& label1, const std::string& label2, unsigned long weight);   // Staged. Same contract as Graph::addEdge()
+    void removeEdge(const std::string& label1, const std::string& label2);  // Staged. Same contract as Graph::removeEdge()
+    void setQueueKind(QueueKind kind);      // Staged. Carried into every later snapshot
+    void setSearchMode(SearchMode mode);    // Staged. Carried into every later snapshot
+    void update(const std::function<void(Graph&)>& batch);  // Runs batch on the staged graph, then publishes once
+    unsigned long publish();    // Freezes and swaps in the staged graph if it changed. Returns the number of snapshots published so far
+    bool pending() const;       // True if staged changes have not been published yet
+    unsigned long publishedCount() const;   // Snapshots published so far, the initial empty one included
+
+protected:
+    unsigned long publishLocked();  // Body of publish(). writerLock must already be held
+
+private:
+    mutable std::mutex writerLock;  // Serializes writers. Readers never take it
+    Graph staging;                  // Writer-side graph. Guarded by writerLock
+    unsigned long stagedVersion = 0;    // staging.getVersion() when the current snapshot was frozen. Guarded by writerLock
+    bool settingsChanged = false;   // Queue kind or search mode set since the last publish(). Guarded by writerLock
+    std::shared_ptr<const FrozenGraph> current; // Read and written only with std::atomic_load() and std::atomic_store()
+    std::atomic<unsigned long> publications{0};
+};
+
+#endif
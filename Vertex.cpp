@@ -3,18 +3,20 @@
                Project 4 Dijkstra's Algorithm
    **********************************************************
    This source file defines a class of (key/value) pairs
-   which represent (distance/vertex label). The pair will
+   which represent (distance/vertex ID). The pair will
    hold the current shortest distance from startLabel in the
    implementation shortestPath() in class Graph. The Vertex
    class is to be used with the min-heap priority queue
    implemented by class PQueue which will always keep the
    shortest known distance from startLabel at the top of the
    queue. Also provided are overloads for operators "<" and
-   ">" which simplify sort logic in PQueue.                   */
+   ">" which simplify sort logic in PQueue.
 
-#include "Vertex.hpp"
+   The vertex is identified by the 32-bit ID assigned by
+   class LabelTable, so a Vertex is a small, trivially
+   copyable object which PQueue can move around cheaply.     */
 
-#include <string>
+#include "Vertex.hpp"
 
 /* Defined solely for course requirement. */
 Vertex::Vertex(){
@@ -22,14 +24,9 @@ Vertex::Vertex(){
 }
 
 /* Custom constructor. */
-Vertex::Vertex(unsigned long dist, const std::string& lbl){
+Vertex::Vertex(unsigned long dist, unsigned int vid){
    set_distance(dist);
-   set_label(lbl);
-}
-
-/* Defined solely for course requirement. */
-Vertex::~Vertex(){
-   // No logical implementation required
+   set_id(vid);
 }
 
 /* Operator overload compares two Vertex objects by distance. */
@@ -46,8 +43,8 @@ void Vertex::set_distance(unsigned long dist){
    this->distance = dist;
 }
 
-void Vertex::set_label(const std::string& lbl){
-   this->label = lbl;
+void Vertex::set_id(unsigned int vid){
+   this->id = vid;
 }
 
 /* Unused function in this assignment, but allows modularity. */
@@ -55,8 +52,8 @@ unsigned long Vertex::get_distance() const{
    return distance;
 }
 
-/* Unused function in this assignment, but allows modularity. */
-std::string Vertex::get_label() const{
-   return label;
+/* Returns by value. The ID is a plain integer, so no string is copied on each PQueue pop. */
+unsigned int Vertex::get_id() const{
+   return id;
 }
 
@@ -3,37 +3,39 @@
                Project 4 Dijkstra's Algorithm
    **********************************************************
    This header file declares a class of (key/value) pairs
-   which represent (distance/vertex label). The pair will
+   which represent (distance/vertex ID). The pair will
    hold the current shortest distance from startLabel in the
    implementation shortestPath() in class Graph. The Vertex
    class is to be used with the min-heap priority queue
    implemented by class PQueue which will always keep the
    shortest known distance from startLabel at the top of the
    queue. Also provided are overloads for operators "<" and
-   ">" which simplify sort logic in PQueue.                   */
+   ">" which simplify sort logic in PQueue.
+
+   The vertex is identified by the 32-bit ID assigned by
+   class LabelTable, so a Vertex is a small, trivially
+   copyable object which PQueue can move around cheaply.     */
 
 #ifndef VERTEX_HPP
 #define VERTEX_HPP
 
-#include <string>
-
 class Vertex{
 public:
    Vertex();    // Default constructor included to fulfill course requirements
-   Vertex(unsigned long dist, const std::string& dest); // Custom constructor, calls set_distance() and set_label()
-   ~Vertex();   // Default destructor included to fulfill course requirements.
+   Vertex(unsigned long dist, unsigned int dest); // Custom constructor, calls set_distance() and set_id()
+   ~Vertex() = default;   // Default destructor included to fulfill course requirements. Defaulted so that Vertex stays trivially copyable
    bool operator<(const Vertex& other) const; // Operator overload
    bool operator>(const Vertex& other) const; // Operator overload
    unsigned long get_distance() const;     // Although not utilized in this assignment, provided for modularity
-   std::string get_label() const;  // Although not utilized in this assignment, provided for modularity
+   unsigned int get_id() const;    // Returns the vertex ID. Graph translates it back to a label
 
 protected:
    void set_distance(unsigned long dist);   // Serves as helper for custom Vertex()
-   void set_label(const std::string& lbl);  // Serves as helper for custom Vertex()
+   void set_id(unsigned int vid);           // Serves as helper for custom Vertex()
 
 private:
    unsigned long distance = 0;     // Key
-   std::string label = "";   // Value      
+   unsigned int id = 0;            // Value
 };
 
 
@@ -0,0 +1,48 @@
+/*           Jonathan D Rivera-Rosado U80549443
+   **********************************************************
+               Project 4 Dijkstra's Algorithm
+   **********************************************************
+   This header file defines the edge weight types that a
+   BasicFrozenGraph may store, and the one operation every
+   search performs on them: adding an edge weight to a
+   tentative distance.
+
+   Distances are always unsigned long, and ULONG_MAX is the
+   distance of an unreached vertex. A plain sum may wrap
+   around past ULONG_MAX to a small number, which would make
+   an absurdly long path look like the shortest one.
+   saturatingAdd() stops at ULONG_MAX instead, so a path too
+   long to represent reads as unreachable and is never
+   relaxed.
+
+   WeightTraits<Weight> exists for every supported Weight.
+   Narrower weights halve the weight array of a snapshot;
+   only integer types are supported, because the radix heap
+   and Dial's buckets need integer keys.                    */
+
+#ifndef WEIGHTTRAITS_HPP
+#define WEIGHTTRAITS_HPP
+
+#include <climits>
+
+/* distance + weight, or ULONG_MAX if the sum does not fit. */
+inline unsigned long saturatingAdd(unsigned long distance, unsigned long weight){
+    return weight > ULONG_MAX - distance ? ULONG_MAX : distance + weight;  // Compiles to an add and a carry check
+}
+
+template<typename Weight>
+struct WeightTraits;    // Left undefined, so an unsupported Weight does not compile
+
+template<>
+struct WeightTraits<unsigned int>{
+    static constexpr unsigned long MAX_WEIGHT = UINT_MAX;   // Largest weight the type holds
+    static constexpr const char* NAME = "uint32";
+};
+
+template<>
+struct WeightTraits<unsigned long>{
+    static constexpr unsigned long MAX_WEIGHT = ULONG_MAX;
+    static constexpr const char* NAME = "uint64";
+};
+
+#endif